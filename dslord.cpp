@@ -17,8 +17,39 @@
 #include <set>
 #include <sstream>
 #include <ctime>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <deque>
+#include <string_view>
+#include <cstdio>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
 
 using namespace std;
+namespace fs = std::filesystem;
+
+#define DSLORD_VERSION "2.1.0"
+
+// Snippet library compiled into the binary (regenerate with --embed-snippets)
+#include "embedded_snippets.h"
 
 // ANSI color codes for terminal output
 #define COLOR_RESET   "\033[0m"
@@ -32,59 +63,349 @@ using namespace std;
 #define COLOR_BOLD    "\033[1m"
 
 // Structure to hold data structure information
+// An alternative snippet of a data structure, selected as -name:<variant>
+struct VariantInfo {
+    string settings;     // options it accepts, which may include a value for the variant itself
+    string description;  // shown in --help, with any requirements the variant has
+};
+
 struct DataStructureInfo {
     string name;
     string displayName;
     string description;
     string flag;
     string category;
+    string typeParams;  // type options accepted as -name:<param>=<type>, e.g. "T" or "K,V"
+    string settings;    // other options accepted, e.g. "capacity,growable"
+    bool powerOfTwoCapacity;
+    map<string, VariantInfo> variants;
+};
+
+// A selected data structure as written on the command line: "stack" or,
+// with options, "stack:T=double". The spec string is used as the library key.
+struct DataStructureSpec {
+    string name;
+    map<string, string> options;
+};
+
+// Snippet bodies by name. Embedded snippets are views into the binary's string
+// tables; snippets read from --snippet-dir are owned by `loaded`.
+struct SnippetLibrary {
+    map<string, string_view> content;
+    map<string, string_view> includes;  // #include lines each snippet needs
+    map<string, uint64_t> hashes;       // FNV-1a of each snippet body and its includes
+    deque<string> loaded;
+};
+
+// 64-bit FNV-1a, chainable across pieces by passing the previous result as h
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+inline uint64_t fnv1a(string_view data, uint64_t h = FNV_OFFSET_BASIS) {
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Generated file assembled as a list of views and written with a single writev().
+// Snippet text is borrowed (it must outlive the buffer); generated text is owned.
+class OutputBuffer {
+public:
+    void append(string_view view) {
+        if (!view.empty()) {
+            pieces.push_back(view);
+            totalSize += view.size();
+        }
+    }
+    
+    void appendOwned(string text) {
+        owned.push_back(move(text));
+        append(owned.back());
+    }
+    
+    size_t size() const {
+        return totalSize;
+    }
+    
+    uint64_t hash() const {
+        uint64_t h = FNV_OFFSET_BASIS;
+        for (const auto& piece : pieces) {
+            h = fnv1a(piece, h);
+        }
+        return h;
+    }
+    
+    // Write every piece to fd, retrying on partial writes
+    bool writeTo(int fd) const {
+#ifdef _WIN32
+        for (const auto& piece : pieces) {
+            if (_write(fd, piece.data(), (unsigned)piece.size()) != (int)piece.size()) {
+                return false;
+            }
+        }
+        return true;
+#else
+        vector<iovec> iov;
+        iov.reserve(pieces.size());
+        for (const auto& piece : pieces) {
+            iov.push_back({const_cast<char*>(piece.data()), piece.size()});
+        }
+        
+        size_t next = 0;
+        while (next < iov.size()) {
+            int batch = (int)min<size_t>(iov.size() - next, IOV_MAX);
+            ssize_t written = writev(fd, &iov[next], batch);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            // Skip fully written pieces and trim a partially written one
+            size_t remaining = (size_t)written;
+            while (next < iov.size() && remaining >= iov[next].iov_len) {
+                remaining -= iov[next].iov_len;
+                next++;
+            }
+            if (remaining > 0) {
+                iov[next].iov_base = (char*)iov[next].iov_base + remaining;
+                iov[next].iov_len -= remaining;
+            }
+        }
+        return true;
+#endif
+    }
+    
+private:
+    deque<string> owned;          // deque keeps owned strings at stable addresses
+    vector<string_view> pieces;
+    size_t totalSize = 0;
+};
+
+// Settings shared by every file generated in one run
+struct GenerationOptions {
+    string snippetDir;           // empty: use the embedded snippets
+    bool deterministic = false;  // no timestamp; leave identical files untouched
+    string cacheDir;             // empty: generation cache disabled
+    bool headers = false;        // one guarded header per structure plus an umbrella header
+    bool pch = false;            // with headers: also emit a precompiled-header stub
+    vector<string> includes;     // extra headers for user types (--include)
+    bool bench = false;          // emit a benchmark main() instead of the example
+};
+
+// Wall time and output size accumulated for one generation phase
+struct PhaseTiming {
+    string phase;
+    double wallMs;
+    size_t bytes;
+    size_t count;
+};
+
+// Counters shared by the workers of one run
+struct GenerationStats {
+    atomic<size_t> cacheHits{0};
+    atomic<size_t> cacheMisses{0};
+    
+    // Per-phase timings, only collected with --timings
+    bool timingsEnabled = false;
+    mutex timingMutex;
+    vector<PhaseTiming> phases;   // first-seen order; repeated phases are summed
+    
+    void record(const string& phase, chrono::steady_clock::time_point start, size_t bytes) {
+        if (!timingsEnabled) {
+            return;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        lock_guard<mutex> lock(timingMutex);
+        for (auto& entry : phases) {
+            if (entry.phase == phase) {
+                entry.wallMs += ms;
+                entry.bytes += bytes;
+                entry.count++;
+                return;
+            }
+        }
+        phases.push_back({phase, ms, bytes, 1});
+    }
+};
+
+// Outcome of writing one generated file
+enum WriteResult {
+    WRITE_FAILED,
+    WRITE_UPDATED,
+    WRITE_UNCHANGED
+};
+
+// One output file and the data structures selected for it
+struct GenerationJob {
+    string outputFile;
+    vector<string> selectedDS;
 };
 
 // Function declarations
 void printHeader();
 void printHelp();
 void printAvailableDataStructures(const vector<DataStructureInfo>& dataStructures);
-bool readDataStructureContent(const string& ds_name, vector<string>& content);
+bool isSnippetBoilerplate(const string& line);
+string stripSnippet(istream& in, string* includes);
+bool spliceFragments(const string& ds_name, const string& snippetDir, string& content, string& includes);
+bool readDataStructureContent(const string& ds_name, const string& snippetDir, SnippetLibrary& library);
+bool embedSnippets(const string& header_file, const string& snippetDir,
+                   const vector<DataStructureInfo>& dataStructures);
+vector<string> parseSelectionFlags(const vector<string>& flags, size_t first,
+                                   const vector<DataStructureInfo>& dataStructures,
+                                   vector<string>& selectedDS);
+string specName(const string& spec);
+DataStructureSpec parseSpec(const string& spec);
+string snippetName(const string& spec, const vector<DataStructureInfo>& dataStructures);
+const DataStructureInfo* findDataStructure(const string& spec, const vector<DataStructureInfo>& dataStructures);
+bool specializeSnippet(const DataStructureSpec& spec, string& content);
+bool hasNumericTypes(const DataStructureSpec& spec);
+bool loadSnippets(const vector<string>& selectedDS, const vector<DataStructureInfo>& dataStructures,
+                  const string& snippetDir, SnippetLibrary& library, bool verbose, GenerationStats& stats);
+void assembleOutput(OutputBuffer& buffer, const vector<DataStructureInfo>& dataStructures,
+                    const vector<string>& selectedDS, const SnippetLibrary& library,
+                    const GenerationOptions& options, GenerationStats& stats);
+string includeBlock(const vector<string>& selectedDS, const SnippetLibrary& library, const GenerationOptions& options);
+bool fileMatches(const string& path, const OutputBuffer& buffer);
+WriteResult writeOutput(const OutputBuffer& buffer, const string& output_file, const GenerationOptions& options);
+string getClassName(const string& ds, const vector<DataStructureInfo>& dataStructures);
+WriteResult writeHeaderSet(const string& umbrella_file, const vector<DataStructureInfo>& dataStructures,
+                           const vector<string>& selectedDS, const SnippetLibrary& library,
+                           const GenerationOptions& options, GenerationStats& stats);
+string defaultCacheDir();
+string cacheKey(const vector<string>& selectedDS, const SnippetLibrary& library, const GenerationOptions& options);
+bool materializeFromCache(const string& entry, const string& output_file);
+void storeInCache(const OutputBuffer& buffer, const string& entry);
+WriteResult writeGeneratedFile(const string& output_file, const vector<DataStructureInfo>& dataStructures,
+                               const vector<string>& selectedDS, const SnippetLibrary& library,
+                               const GenerationOptions& options, GenerationStats& stats);
 void generateFile(const string& output_file, const vector<DataStructureInfo>& dataStructures, 
-                 const vector<string>& selectedDS);
-void generateExampleCode(ofstream& out_file, const vector<string>& selectedDS, 
+                 const vector<string>& selectedDS, const GenerationOptions& options, GenerationStats& stats);
+bool readManifest(const string& manifest_file, const vector<DataStructureInfo>& dataStructures,
+                  vector<GenerationJob>& jobs);
+bool runManifest(const string& manifest_file, const vector<DataStructureInfo>& dataStructures,
+                 const GenerationOptions& options, unsigned threadCount, GenerationStats& stats);
+void printTimings(const GenerationStats& stats);
+void generateExampleCode(ostream& out_file, const vector<string>& selectedDS, 
                         const vector<DataStructureInfo>& dataStructures);
+void generateBenchmarkCode(ostream& out_file, const vector<string>& selectedDS,
+                           const vector<DataStructureInfo>& dataStructures);
 string getFormattedDateTime();
 string getProgramName(char* programPath);
 void printSuccess(const string& output_file, int count);
 void printFooter();
 
 int main(int argc, char* argv[]) {
+    GenerationStats stats;
+    auto parseStart = chrono::steady_clock::now();
+    
     // Set up data structure information with categories
     vector<DataStructureInfo> dataStructures = {
         // Linear Data Structures
-        {"stack", "Stack", "Last-In-First-Out (LIFO) data structure", "-stack", "Linear"},
-        {"queue", "Queue", "First-In-First-Out (FIFO) data structure", "-queue", "Linear"},
-        {"deque", "Deque", "Double-ended Queue implementation", "-deque", "Linear"},
-        {"array", "Dynamic Array", "Dynamic Array implementation (similar to C++ vector)", "-array", "Linear"},
+        {"stack", "Stack", "Last-In-First-Out (LIFO) data structure", "-stack", "Linear", "T", "capacity,growable", false, {
+             {"segmented", {"", "Linked chunks; grows without copying"}},
+             {"concurrent", {"", "Lock-free stack for many threads"}}}},
+        {"queue", "Queue", "First-In-First-Out (FIFO) data structure", "-queue", "Linear", "T", "capacity,growable", true, {
+             {"spsc", {"capacity", "Lock-free ring for one producer and one consumer thread"}},
+             {"mpmc", {"capacity", "Lock-free ring for any number of threads; capacity >= 2"}},
+             {"blocking", {"capacity,growable", "Consumers wait for elements, with timeouts and close()"}},
+             {"channel", {"capacity", "Coroutine channel to co_await push and pop; needs C++20"}}}},
+        {"deque", "Deque", "Double-ended Queue implementation", "-deque", "Linear", "T", "capacity,growable", true, {
+             {"segmented", {"", "Block map like std::deque; O(1) indexing, stable references"}},
+             {"workstealing", {"", "Lock-free Chase-Lev deque for task schedulers"}}}},
+        {"array", "Dynamic Array", "Dynamic Array implementation (similar to C++ vector)", "-array", "Linear", "T", "", false, {
+             {"inline", {"inline", "-array:inline=<n> keeps n elements in the object before allocating"}},
+             {"mapped", {"", "Stored in a memory-mapped file; POSIX only, trivially copyable types"}}}},
+        {"slidingwindow", "Sliding Window", "Rolling min/max over a time window of samples", "-slidingwindow", "Linear", "T", "", false, {}},
         
         // Linked Data Structures
-        {"linkedlist", "Linked List", "Singly Linked List implementation", "-linkedlist", "Linked"},
-        {"doublylinkedlist", "Doubly Linked List", "Bi-directional linked nodes", "-doublylinkedlist", "Linked"},
-        {"circularlist", "Circular Linked List", "Circular chain of linked nodes", "-circularlist", "Linked"},
+        {"linkedlist", "Linked List", "Singly Linked List implementation", "-linkedlist", "Linked", "T", "", false, {}},
+        {"doublylinkedlist", "Doubly Linked List", "Bi-directional linked nodes", "-doublylinkedlist", "Linked", "T", "", false, {}},
+        {"circularlist", "Circular Linked List", "Circular chain of linked nodes", "-circularlist", "Linked", "T", "", false, {}},
         
         // Tree Data Structures
-        {"bst", "Binary Search Tree", "Ordered binary tree implementation", "-bst", "Tree"},
-        {"heap", "Min Heap", "Complete binary tree with heap property", "-heap", "Tree"},
+        {"bst", "Binary Search Tree", "Ordered binary tree implementation", "-bst", "Tree", "T", "", false, {}},
+        {"heap", "Min Heap", "Complete binary tree with heap property", "-heap", "Tree", "T", "capacity,growable", false, {}},
         
         // Hash-based Data Structures
-        {"hashtable", "Hash Table", "Key-value pairs with O(1) access time", "-hashtable", "Hash-based"}
+        {"hashtable", "Hash Table", "Key-value pairs with O(1) access time", "-hashtable", "Hash-based", "K,V", "", false, {}}
     };
     
     // Get program name for help display
     string programName = getProgramName(argv[0]);
     
+    // Extract global options; everything else keeps its original position
+    GenerationOptions options;
+    string embedHeader;
+    string manifestFile;
+    unsigned threadCount = 0;
+    bool toStdout = false;
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--stdout") {
+            toStdout = true;
+        } else if (arg == "--deterministic") {
+            options.deterministic = true;
+        } else if (arg == "--cache") {
+            if (options.cacheDir.empty()) {
+                options.cacheDir = defaultCacheDir();
+            }
+        } else if (arg == "--timings") {
+            stats.timingsEnabled = true;
+        } else if (arg == "--bench") {
+            options.bench = true;
+        } else if (arg == "--headers") {
+            options.headers = true;
+        } else if (arg == "--pch") {
+            options.headers = true;
+            options.pch = true;
+        } else if (arg == "--cache-dir" && i + 1 < argc) {
+            options.cacheDir = argv[++i];
+        } else if (arg == "--include" && i + 1 < argc) {
+            options.includes.push_back(argv[++i]);
+        } else if (arg == "--snippet-dir" && i + 1 < argc) {
+            options.snippetDir = argv[++i];
+        } else if (arg == "--embed-snippets" && i + 1 < argc) {
+            embedHeader = argv[++i];
+        } else if (arg == "--manifest" && i + 1 < argc) {
+            manifestFile = argv[++i];
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            threadCount = (unsigned)max(1, atoi(argv[++i]));
+        } else {
+            args.push_back(arg);
+        }
+    }
+    
+    // Cached outputs must not embed a timestamp
+    if (!options.cacheDir.empty()) {
+        options.deterministic = true;
+    }
+    
+    if (options.headers && toStdout) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "--headers writes several files and cannot be used with --stdout\n";
+        return 1;
+    }
+    if (options.headers && options.bench) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "--headers writes no main() and cannot be used with --bench\n";
+        return 1;
+    }
+    
+    // With --stdout (or an output file of "-") the generated code owns standard
+    // output, so every console message goes to stderr instead
+    if (toStdout) {
+        args.insert(args.begin(), "-");
+    }
+    if (!args.empty() && args[0] == "-") {
+        cout.rdbuf(cerr.rdbuf());
+    }
+    
     // Display header
     printHeader();
     
     // Check for help flag
-    for (int i = 1; i < argc; i++) {
-        string arg = argv[i];
+    for (const auto& arg : args) {
         if (arg == "-h" || arg == "--help" || arg == "-help") {
             printHelp();
             printAvailableDataStructures(dataStructures);
@@ -93,59 +414,45 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Regenerate the embedded snippet table (build step)
+    if (!embedHeader.empty()) {
+        bool ok = embedSnippets(embedHeader, options.snippetDir.empty() ? "snippets" : options.snippetDir,
+                                dataStructures);
+        printFooter();
+        return ok ? 0 : 1;
+    }
+    
+    // Generate every output listed in a manifest in one process
+    if (!manifestFile.empty()) {
+        stats.record("parse_args", parseStart, 0);
+        bool ok = runManifest(manifestFile, dataStructures, options, threadCount, stats);
+        printTimings(stats);
+        printFooter();
+        return ok ? 0 : 1;
+    }
+    
     // Check command-line arguments
-    if (argc < 2) {
+    if (args.empty()) {
         cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Not enough arguments.\n";
         cout << "Use " << COLOR_BOLD << programName << " --help" << COLOR_RESET << " for usage information.\n";
         printFooter();
         return 1;
     }
     
-    string output_file = argv[1];
+    string output_file = args[0];
     
     // Process command line flags
     vector<string> selectedDS;
-    
-    // Map to track invalid flags
-    map<string, bool> validFlags;
-    for (const auto& ds : dataStructures) {
-        validFlags[ds.flag] = true;
-    }
-    
-    for (int i = 2; i < argc; i++) {
-        string arg = argv[i];
-        
-        // Handle "all" flag specially
-        if (arg == "-all") {
-            for (const auto& ds : dataStructures) {
-                selectedDS.push_back(ds.name);
-            }
-            break;
-        }
-        
-        // Skip if it's not a flag
-        if (arg.empty() || arg[0] != '-') {
-            continue;
-        }
-        
-        bool found = false;
-        for (const auto& ds : dataStructures) {
-            if (arg == ds.flag) {
-                selectedDS.push_back(ds.name);
-                found = true;
-                break;
-            }
-        }
-        
-        if (!found && !validFlags[arg]) {
-            cout << COLOR_YELLOW << "WARNING: " << COLOR_RESET << "Unknown flag: " << arg << endl;
-        }
+    for (const auto& problem : parseSelectionFlags(args, 1, dataStructures, selectedDS)) {
+        cout << COLOR_YELLOW << "WARNING: " << COLOR_RESET << problem << endl;
     }
+    stats.record("parse_args", parseStart, 0);
     
     // Generate the file if at least one data structure was selected
     if (!selectedDS.empty()) {
-        generateFile(output_file, dataStructures, selectedDS);
+        generateFile(output_file, dataStructures, selectedDS, options, stats);
         printSuccess(output_file, selectedDS.size());
+        printTimings(stats);
     } else {
         cout << COLOR_RED << "ERROR: " << COLOR_RESET << "No data structures were selected. Use flags like -stack, -queue, etc.\n";
         cout << "Use " << COLOR_BOLD << programName << " --help" << COLOR_RESET << " to see available options.\n";
@@ -190,11 +497,30 @@ void printHelp() {
     cout << COLOR_BOLD << "EXAMPLES:" << COLOR_RESET << endl;
     cout << "  dslord mycode.cpp -stack -linkedlist" << endl;
     cout << "  dslord datastructures.cpp -queue -bst -heap" << endl;
-    cout << "  dslord complete.cpp -all              " << COLOR_CYAN << "# Generate all data structures" << COLOR_RESET << endl << endl;
+    cout << "  dslord complete.cpp -all              " << COLOR_CYAN << "# Generate all data structures" << COLOR_RESET << endl;
+    cout << "  dslord ids.cpp -stack:T=double -hashtable:K=uint64_t,V=Record --include record.h" << endl;
+    cout << "  dslord jobs.cpp -queue:capacity=65536 -stack:growable" << endl << endl;
     
     cout << COLOR_BOLD << "FLAGS:" << COLOR_RESET << endl;
     cout << "  -h, --help   : Display this help information" << endl;
-    cout << "  -all         : Include all available data structures" << endl << endl;
+    cout << "  -all         : Include all available data structures" << endl;
+    cout << "  -<ds>:T=<type>           : Specialize the element type (-hashtable:K=<type>,V=<type>)" << endl;
+    cout << "  -<ds>:capacity=<n>       : Fixed capacity of a stack, queue, deque or heap (power of two for queue/deque)" << endl;
+    cout << "  -<ds>:growable           : Double the capacity when full instead of throwing overflow_error" << endl;
+    cout << "  -array:inline=<n>        : Keep up to <n> elements inside the DynamicArray before allocating" << endl;
+    cout << "  --include <header>       : Include <header> in the output (for custom element types)" << endl;
+    cout << "  --snippet-dir <dir>      : Load snippets from <dir> instead of the built-in copies" << endl;
+    cout << "  --deterministic          : Omit the timestamp and leave files whose content is unchanged untouched" << endl;
+    cout << "  --timings                : Report per-phase wall time and byte counts as JSON on stderr" << endl;
+    cout << "  --bench                  : Emit a benchmark main() that prints ns/op, ops/sec and peak memory as CSV" << endl;
+    cout << "  --headers                : Write one guarded <Class>.hpp per structure; <output_file> is the umbrella header" << endl;
+    cout << "  --pch                    : With --headers, also write a precompiled-header stub" << endl;
+    cout << "  --cache                  : Reuse identical outputs from $XDG_CACHE_HOME/dslord (implies --deterministic)" << endl;
+    cout << "  --cache-dir <dir>        : Use <dir> as the generation cache" << endl;
+    cout << "  --stdout                 : Write the generated code to standard output (same as <output_file> -)" << endl;
+    cout << "  --manifest <file>        : Generate every \"<output_file> [-flags...]\" line of <file>" << endl;
+    cout << "  --jobs <n>               : Worker threads for --manifest (default: up to 8)" << endl;
+    cout << "  --embed-snippets <file>  : Regenerate the embedded snippet header from snippets/" << endl << endl;
 }
 
 /**
@@ -219,172 +545,1140 @@ void printAvailableDataStructures(const vector<DataStructureInfo>& dataStructure
             cout << "  " << COLOR_CYAN << setw(20) << left << ds.flag << COLOR_RESET;
             cout << setw(25) << ds.displayName;
             cout << ds.description << endl;
+            for (const auto& variant : ds.variants) {
+                cout << "  " << COLOR_CYAN << setw(20) << left << (ds.flag + ":" + variant.first) << COLOR_RESET;
+                cout << setw(25) << "" << variant.second.description << endl;
+            }
         }
     }
     cout << endl;
 }
 
 /**
- * Read data structure content from file
+ * Collect the data structures named by flags[first..], returning a message for
+ * each flag that was ignored. A later flag for the same structure replaces the
+ * earlier one, so "-all -stack:T=double" specializes just the stack.
  */
-bool readDataStructureContent(const string& ds_name, vector<string>& content) {
-    string path = "snippets/" + ds_name + ".cpp";
-    ifstream file(path);
-
-    if (!file) {
-        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Code for " << ds_name << " not found at " << path << endl;
+vector<string> parseSelectionFlags(const vector<string>& flags, size_t first,
+                                   const vector<DataStructureInfo>& dataStructures,
+                                   vector<string>& selectedDS) {
+    vector<string> problems;
+    
+    auto isSelected = [&](const string& name) {
+        for (const auto& existing : selectedDS) {
+            if (specName(existing) == name) {
+                return true;
+            }
+        }
         return false;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        // Skip include and namespace lines - we'll add them at the top once
-        if (line.find("#include") != string::npos || 
-            line.find("using namespace") != string::npos || 
-            line.empty()) {
+    };
+    
+    for (size_t i = first; i < flags.size(); i++) {
+        const string& arg = flags[i];
+        
+        // Handle "all" flag specially
+        if (arg == "-all") {
+            for (const auto& ds : dataStructures) {
+                if (!isSelected(ds.name)) {
+                    selectedDS.push_back(ds.name);
+                }
+            }
+            continue;
+        }
+        
+        // Skip if it's not a flag
+        if (arg.empty() || arg[0] != '-') {
             continue;
         }
-        content.push_back(line);
+        
+        DataStructureSpec spec = parseSpec(arg.substr(1));
+        const DataStructureInfo* info = findDataStructure(spec.name, dataStructures);
+        if (!info) {
+            problems.push_back("Unknown flag: " + arg);
+            continue;
+        }
+        
+        // Validate options; types must look like C++ type names and a capacity
+        // must be a positive integer (a power of two where the snippet masks indices)
+        string problem;
+        string variant;
+        auto acceptsSetting = [](const string& settings, const string& option) {
+            return ("," + settings + ",").find("," + option + ",") != string::npos;
+        };
+        for (const auto& option : spec.options) {
+            if (!info->variants.count(option.first)) {
+                continue;
+            }
+            if (!variant.empty()) {
+                problem = "Variants '" + variant + "' and '" + option.first + "' conflict in " + arg;
+            } else if (!option.second.empty() && !acceptsSetting(info->variants.at(option.first).settings, option.first)) {
+                problem = "Variant '" + option.first + "' takes no value in " + arg;
+            }
+            variant = option.first;
+        }
+        
+        // A variant accepts its own settings, which may include a value for the variant itself
+        const string& settings = variant.empty() ? info->settings : info->variants.at(variant).settings;
+        auto parseCount = [](const string& value) {
+            unsigned long long count = 0;
+            if (!value.empty() && value.size() <= 10 && value.find_first_not_of("0123456789") == string::npos) {
+                count = stoull(value);
+            }
+            return count;
+        };
+        for (const auto& option : spec.options) {
+            bool isTypeParam = acceptsSetting(info->typeParams, option.first);
+            bool isSetting = acceptsSetting(settings, option.first);
+            if (option.first == variant && (option.second.empty() || !isSetting)) {
+                continue;
+            }
+            if (option.first == "capacity" && isSetting) {
+                const string& value = option.second;
+                unsigned long long capacity = parseCount(value);
+                if (capacity == 0 || capacity > (1ULL << 30)) {
+                    problem = "Invalid capacity '" + value + "' in " + arg + " (expected 1 to 1073741824)";
+                } else if (info->powerOfTwoCapacity && (capacity & (capacity - 1)) != 0) {
+                    problem = "Capacity " + value + " in " + arg + " is not a power of two";
+                } else if (variant == "mpmc" && capacity < 2) {
+                    // A slot's sequence number must tell "free this lap" from "full", which takes two slots
+                    problem = "Capacity " + value + " in " + arg + " is too small (-queue:mpmc needs at least 2)";
+                }
+            } else if (option.first == "growable" && isSetting) {
+                if (!option.second.empty()) {
+                    problem = "Option 'growable' takes no value in " + arg;
+                }
+            } else if (option.first == "inline" && isSetting) {
+                unsigned long long inlineCapacity = parseCount(option.second);
+                if (inlineCapacity == 0 || inlineCapacity > 4096) {
+                    problem = "Invalid inline capacity '" + option.second + "' in " + arg + " (expected 1 to 4096)";
+                }
+            } else if (!isTypeParam) {
+                problem = "Unknown option '" + option.first + "' in " + arg;
+            } else if (option.second.empty() ||
+                       option.second.find_first_not_of("abcdefghijklmnopqrstuvwxyz"
+                                                       "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                                       "0123456789_:<> *&") != string::npos) {
+                problem = "Invalid type '" + option.second + "' in " + arg;
+            }
+        }
+        if (!problem.empty()) {
+            problems.push_back(problem + " (flag ignored)");
+            continue;
+        }
+        
+        // Store the spec in canonical form so equal requests share snippets and cache entries
+        string canonical = spec.name;
+        for (const auto& option : spec.options) {
+            canonical += (canonical == spec.name ? ":" : ",") + option.first;
+            if (!option.second.empty()) {
+                canonical += "=" + option.second;
+            }
+        }
+        
+        if (isSelected(spec.name)) {
+            for (auto& existing : selectedDS) {
+                if (specName(existing) == spec.name) {
+                    existing = canonical;
+                }
+            }
+        } else {
+            selectedDS.push_back(canonical);
+        }
     }
+    
+    return problems;
+}
 
-    file.close();
-    return true;
+/**
+ * Data structure name of a spec: "stack:T=double" -> "stack"
+ */
+string specName(const string& spec) {
+    return spec.substr(0, spec.find(':'));
 }
 
 /**
- * Generate the output file with the selected data structures
+ * Split "name:key=value,key=value" into its name and options
  */
-void generateFile(const string& output_file, const vector<DataStructureInfo>& dataStructures, 
-                const vector<string>& selectedDS) {
-    // Attempt to open the output file
-    ofstream out(output_file);
-    if (!out) {
-        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Failed to open output file: " << output_file << endl;
-        return;
-    }
-    
-    // Content for each data structure
-    map<string, vector<string>> dsContent;
+DataStructureSpec parseSpec(const string& spec) {
+    DataStructureSpec result;
+    result.name = specName(spec);
     
-    // Collect content for all selected data structures
-    cout << COLOR_CYAN << "\nReading data structure implementations..." << COLOR_RESET << endl;
-    for (const auto& ds : selectedDS) {
-        vector<string> content;
-        if (readDataStructureContent(ds, content)) {
-            dsContent[ds] = content;
-            cout << "  " << COLOR_GREEN << "✓" << COLOR_RESET << " " << ds << endl;
+    size_t colon = spec.find(':');
+    if (colon == string::npos) {
+        return result;
+    }
+    istringstream options(spec.substr(colon + 1));
+    string option;
+    while (getline(options, option, ',')) {
+        size_t equals = option.find('=');
+        if (equals == string::npos) {
+            result.options[option] = "";
+        } else {
+            result.options[option.substr(0, equals)] = option.substr(equals + 1);
         }
     }
-    
-    // Generate the file header
-    out << "/**\n";
-    out << " * Data Structures Implementation\n";
-    out << " * Generated with DSLord\n";
-    out << " * Date: " << getFormattedDateTime() << "\n";
-    out << " *\n";
-    out << " * Contains:\n";
-    
-    for (const auto& ds : selectedDS) {
-        // Find the display name for this data structure
-        string displayName = ds; // default
-        for (const auto& info : dataStructures) {
-            if (info.name == ds) {
-                displayName = info.displayName;
-                break;
+    return result;
+}
+
+/**
+ * Snippet a spec is generated from: the structure's own, or "<name>_<variant>"
+ * when an option selects a variant ("stack:segmented" -> "stack_segmented")
+ */
+string snippetName(const string& spec, const vector<DataStructureInfo>& dataStructures) {
+    DataStructureSpec parsed = parseSpec(spec);
+    const DataStructureInfo* info = findDataStructure(parsed.name, dataStructures);
+    if (info) {
+        for (const auto& option : parsed.options) {
+            if (info->variants.count(option.first)) {
+                return parsed.name + "_" + option.first;
             }
         }
-        out << " * - " << displayName << "\n";
     }
-    out << " */\n\n";
-    
-    // Add standard includes
-    out << "#include <iostream>\n";
-    out << "#include <string>\n";
-    out << "#include <stdexcept>\n";
-    out << "#include <algorithm>\n";
-    
-    // Add using namespace statement
-    out << "using namespace std;\n\n";
-    
-    // Add all data structure implementations
-    cout << COLOR_CYAN << "\nWriting data structures to file..." << COLOR_RESET << endl;
-    for (const auto& ds : selectedDS) {
-        if (dsContent.find(ds) != dsContent.end()) {
-            // Find the display name for this data structure
-            string displayName = ds; // default
-            for (const auto& info : dataStructures) {
-                if (info.name == ds) {
-                    displayName = info.displayName;
-                    cout << "  " << COLOR_GREEN << "✓" << COLOR_RESET << " Adding " << displayName << endl;
-                    break;
-                }
-            }
-            
-            // Add the content
-            for (const auto& line : dsContent[ds]) {
-                out << line << endl;
-            }
-            out << endl; // Add a blank line between implementations
+    return parsed.name;
+}
+
+/**
+ * Registry entry for a spec or plain name, or nullptr when unknown
+ */
+const DataStructureInfo* findDataStructure(const string& spec, const vector<DataStructureInfo>& dataStructures) {
+    string name = specName(spec);
+    for (const auto& info : dataStructures) {
+        if (info.name == name) {
+            return &info;
         }
     }
-    
-    // Add example usage code
-    generateExampleCode(out, selectedDS, dataStructures);
-    
-    out.close();
-    cout << COLOR_GREEN << "\nAll data structures successfully written to " << output_file << COLOR_RESET << endl;
+    return nullptr;
 }
 
 /**
- * Generate example usage code
+ * Apply a spec's options to a snippet. Type options rewrite its class-scope
+ * "typedef int ValueType;" (T, V) and "typedef int KeyType;" (K) lines;
+ * capacity rewrites the MAX_SIZE constant and growable sets GROWABLE, starting
+ * from a small capacity unless one is given; inline=<n> rewrites INLINE_CAPACITY.
  */
-void generateExampleCode(ofstream& out_file, const vector<string>& selectedDS, 
-                        const vector<DataStructureInfo>& dataStructures) {
-    out_file << "/**\n";
-    out_file << " * Example usage of implemented data structures\n";
-    out_file << " */\n";
-    out_file << "int main() {\n";
-    out_file << "    cout << \"+----------------------------------------------+\" << endl;\n";
-    out_file << "    cout << \"|  Data Structures Implementation Example     |\" << endl;\n";
-    out_file << "    cout << \"+----------------------------------------------+\" << endl << endl;\n";
-    
-    // Group data structures by category for better example organization
-    map<string, vector<string>> categorizedDS;
+bool specializeSnippet(const DataStructureSpec& spec, string& content) {
+    // Replace the whole declaration "<line>;" that starts with `line`
+    auto rewrite = [&](const string& line, const string& replacement) {
+        size_t pos = content.find(line);
+        size_t end = pos == string::npos ? pos : content.find(';', pos);
+        if (end == string::npos) {
+            cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Snippet for " << spec.name
+                 << " has no '" << line << "' to specialize" << endl;
+            return false;
+        }
+        content.replace(pos, end - pos, replacement);
+        return true;
+    };
     
-    for (const auto& ds : selectedDS) {
-        // Find the category for this data structure
-        for (const auto& info : dataStructures) {
-            if (info.name == ds) {
-                categorizedDS[info.category].push_back(ds);
-                break;
+    for (const auto& option : spec.options) {
+        bool ok;
+        if (option.first == "capacity") {
+            ok = rewrite("static const int MAX_SIZE = ", "static const int MAX_SIZE = " + option.second);
+        } else if (option.first == "growable") {
+            ok = rewrite("static const bool GROWABLE = ", "static const bool GROWABLE = true") &&
+                 (spec.options.count("capacity") || rewrite("static const int MAX_SIZE = ", "static const int MAX_SIZE = 16"));
+        } else if (option.first == "inline" && !option.second.empty()) {
+            ok = rewrite("static const int INLINE_CAPACITY = ", "static const int INLINE_CAPACITY = " + option.second);
+        } else if (option.first == "T" || option.first == "K" || option.first == "V") {
+            string member = option.first == "K" ? "KeyType" : "ValueType";
+            ok = rewrite("typedef int " + member, "typedef " + option.second + " " + member);
+        } else {
+            ok = true;  // a variant, already chosen by snippetName()
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Whether every type option of a spec is a built-in arithmetic type, so the
+ * example code's integer literals still make sense
+ */
+bool hasNumericTypes(const DataStructureSpec& spec) {
+    static const set<string> numericTypes = {
+        "int", "unsigned", "unsigned int", "short", "unsigned short", "long", "unsigned long",
+        "long long", "unsigned long long", "float", "double", "long double", "size_t",
+        "int8_t", "int16_t", "int32_t", "int64_t", "uint8_t", "uint16_t", "uint32_t", "uint64_t"
+    };
+    for (const auto& option : spec.options) {
+        bool isTypeOption = option.first == "T" || option.first == "K" || option.first == "V";
+        if (isTypeOption && !numericTypes.count(option.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Check whether a snippet line is boilerplate that the generated file provides once
+ */
+bool isSnippetBoilerplate(const string& line) {
+    return line.find("#include") != string::npos || 
+           line.find("using namespace") != string::npos || 
+           line.empty();
+}
+
+/**
+ * Read a snippet stream, dropping boilerplate lines
+ */
+string stripSnippet(istream& in, string* includes) {
+    string content;
+    string line;
+    while (getline(in, line)) {
+        // Skip include and namespace lines - we'll add them at the top once
+        if (isSnippetBoilerplate(line)) {
+            if (includes && line.find("#include") != string::npos) {
+                *includes += line + "\n";
             }
+            continue;
         }
+        content += line;
+        content += '\n';
     }
-    
-    // Generate examples for each category
-    for (const auto& category : categorizedDS) {
-        out_file << "    // " << category.first << " Data Structures Examples\n";
-        out_file << "    cout << \"\\n" << category.first << " Data Structures:\" << endl;\n";
-        out_file << "    cout << \"" << string(category.first.length() + 16, '-') << "\" << endl;\n\n";
+    return content;
+}
+
+/**
+ * Replace each "// dslord:splice <fragment>" line of a snippet with the body of
+ * snippetDir/fragments/<fragment>.cpp, adding the fragment's #include lines to
+ * the snippet's. Fragments hold code that several snippets share, such as the
+ * algorithms of every DynamicArray variant; the embedded table stores the
+ * snippets already spliced.
+ */
+bool spliceFragments(const string& ds_name, const string& snippetDir, string& content, string& includes) {
+    const string marker = "// dslord:splice ";
+    size_t pos = content.find(marker);
+    while (pos != string::npos) {
+        size_t lineStart = content.rfind('\n', pos);
+        lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+        size_t lineEnd = content.find('\n', pos);
+        lineEnd = lineEnd == string::npos ? content.size() : lineEnd + 1;
+        size_t nameStart = pos + marker.size();
+        string fragment = content.substr(nameStart, content.find_first_of(" \r\n", nameStart) - nameStart);
         
-        for (const auto& ds : category.second) {
+        string path = snippetDir + "/fragments/" + fragment + ".cpp";
+        ifstream file(path);
+        if (!file) {
+            cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Fragment " << fragment << " used by " << ds_name
+                 << " not found at " << path << endl;
+            return false;
+        }
+        string fragmentIncludes;
+        string body = stripSnippet(file, &fragmentIncludes);
+        content.replace(lineStart, lineEnd - lineStart, body);
+        
+        istringstream lines(fragmentIncludes);
+        string line;
+        while (getline(lines, line)) {
+            if (("\n" + includes).find("\n" + line + "\n") == string::npos) {
+                includes += line + "\n";
+            }
+        }
+        
+        // Fragments are not spliced into fragments
+        pos = content.find(marker, lineStart + body.size());
+    }
+    return true;
+}
+
+/**
+ * Read data structure content from the embedded table, or from snippetDir when given
+ */
+bool readDataStructureContent(const string& ds_name, const string& snippetDir, SnippetLibrary& library) {
+    if (snippetDir.empty()) {
+        for (size_t i = 0; i < EMBEDDED_SNIPPET_COUNT; i++) {
+            if (ds_name == EMBEDDED_SNIPPETS[i].name) {
+                library.content[ds_name] = string_view(EMBEDDED_SNIPPETS[i].content, EMBEDDED_SNIPPETS[i].length);
+                library.includes[ds_name] = EMBEDDED_SNIPPETS[i].includes;
+                library.hashes[ds_name] = EMBEDDED_SNIPPETS[i].hash;
+                return true;
+            }
+        }
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Code for " << ds_name << " is not embedded in this build" << endl;
+        return false;
+    }
+    
+    string path = snippetDir + "/" + ds_name + ".cpp";
+    ifstream file(path);
+    
+    if (!file) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Code for " << ds_name << " not found at " << path << endl;
+        return false;
+    }
+    
+    string includes;
+    string content = stripSnippet(file, &includes);
+    if (!spliceFragments(ds_name, snippetDir, content, includes)) {
+        return false;
+    }
+    library.loaded.push_back(move(content));
+    library.content[ds_name] = library.loaded.back();
+    library.loaded.push_back(includes);
+    library.includes[ds_name] = library.loaded.back();
+    library.hashes[ds_name] = fnv1a(library.includes[ds_name], fnv1a(library.content[ds_name]));
+    file.close();
+    return true;
+}
+
+/**
+ * Write the snippet library as a C++ header of constant string tables
+ */
+bool embedSnippets(const string& header_file, const string& snippetDir,
+                   const vector<DataStructureInfo>& dataStructures) {
+    // Keep each raw literal well below the 16 KB per-literal limit of MSVC
+    const size_t MAX_LITERAL_CHUNK = 8192;
+    
+    ostringstream table;
+    SnippetLibrary library;
+    cout << COLOR_CYAN << "Embedding snippets from " << snippetDir << "/..." << COLOR_RESET << endl;
+    vector<string> names;
+    for (const auto& ds : dataStructures) {
+        names.push_back(ds.name);
+        for (const auto& variant : ds.variants) {
+            names.push_back(ds.name + "_" + variant.first);
+        }
+    }
+    for (const auto& name : names) {
+        if (!readDataStructureContent(name, snippetDir, library)) {
+            return false;
+        }
+        string_view content = library.content[name];
+        
+        table << "    {\"" << name << "\",\n";
+        size_t pos = 0;
+        while (pos < content.size()) {
+            // Split on line boundaries so no chunk ends mid-line
+            size_t end = min(content.size(), pos + MAX_LITERAL_CHUNK);
+            if (end < content.size()) {
+                size_t lastNewline = content.rfind('\n', end - 1);
+                if (lastNewline != string::npos && lastNewline >= pos) {
+                    end = lastNewline + 1;
+                }
+            }
+            table << "R\"DSLORD(" << content.substr(pos, end - pos) << ")DSLORD\"\n";
+            pos = end;
+        }
+        table << "    , " << content.size() << ", 0x" << hex << library.hashes[name] << dec << "ULL,\n";
+        table << "    \"";
+        for (char c : library.includes[name]) {
+            table << (c == '\n' ? "\\n" : c == '"' ? "\\\"" : string(1, c));
+        }
+        table << "\"},\n";
+        cout << "  " << COLOR_GREEN << "✓" << COLOR_RESET << " " << name << " (" << content.size() << " bytes)" << endl;
+    }
+    
+    ofstream out(header_file);
+    if (!out) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Failed to open output file: " << header_file << endl;
+        return false;
+    }
+    
+    out << "/**\n";
+    out << " * Embedded snippet library for DSLord\n";
+    out << " *\n";
+    out << " * GENERATED FILE - do not edit by hand. Edit the files in snippets/ and run:\n";
+    out << " *   dslord --embed-snippets embedded_snippets.h\n";
+    out << " */\n\n";
+    out << "#ifndef DSLORD_EMBEDDED_SNIPPETS_H\n";
+    out << "#define DSLORD_EMBEDDED_SNIPPETS_H\n\n";
+    out << "#include <cstddef>\n";
+    out << "#include <cstdint>\n\n";
+    out << "struct EmbeddedSnippet {\n";
+    out << "    const char* name;\n";
+    out << "    const char* content;\n";
+    out << "    size_t length;\n";
+    out << "    uint64_t hash;          // FNV-1a of content and includes, used for cache keys\n";
+    out << "    const char* includes;   // #include lines stripped from the snippet\n";
+    out << "};\n\n";
+    out << "static const EmbeddedSnippet EMBEDDED_SNIPPETS[] = {\n";
+    out << table.str();
+    out << "};\n\n";
+    out << "static const size_t EMBEDDED_SNIPPET_COUNT = sizeof(EMBEDDED_SNIPPETS) / sizeof(EMBEDDED_SNIPPETS[0]);\n\n";
+    out << "#endif // DSLORD_EMBEDDED_SNIPPETS_H\n";
+    out.close();
+    
+    cout << COLOR_GREEN << "\nSnippet table written to " << header_file << COLOR_RESET << endl;
+    return true;
+}
+
+/**
+ * Load each distinct selected snippet once into the library
+ */
+bool loadSnippets(const vector<string>& selectedDS, const vector<DataStructureInfo>& dataStructures,
+                  const string& snippetDir, SnippetLibrary& library, bool verbose, GenerationStats& stats) {
+    bool ok = true;
+    for (const auto& ds : selectedDS) {
+        if (library.content.count(ds)) {
+            continue;
+        }
+        auto start = chrono::steady_clock::now();
+        string name = snippetName(ds, dataStructures);
+        if (!library.content.count(name) && !readDataStructureContent(name, snippetDir, library)) {
+            ok = false;
+            continue;
+        }
+        
+        // Specialized specs and variants get their own copy of the base snippet
+        if (ds != name) {
+            string content(library.content[name]);
+            if (!specializeSnippet(parseSpec(ds), content)) {
+                ok = false;
+                continue;
+            }
+            library.hashes[ds] = fnv1a(library.includes[name], fnv1a(content));
+            library.loaded.push_back(move(content));
+            library.content[ds] = library.loaded.back();
+            library.includes[ds] = library.includes[name];
+        }
+        
+        stats.record("read_snippet:" + ds, start, library.content[ds].size());
+        if (verbose) {
+            cout << "  " << COLOR_GREEN << "✓" << COLOR_RESET << " " << ds << endl;
+        }
+    }
+    return ok;
+}
+
+/**
+ * Assemble a generated file: owned header and example text around borrowed snippet views
+ */
+void assembleOutput(OutputBuffer& buffer, const vector<DataStructureInfo>& dataStructures,
+                    const vector<string>& selectedDS, const SnippetLibrary& library,
+                    const GenerationOptions& options, GenerationStats& stats) {
+    auto start = chrono::steady_clock::now();
+    ostringstream out;
+    
+    // Generate the file header; deterministic output leaves out the timestamp
+    out << "/**\n";
+    out << " * Data Structures Implementation\n";
+    out << " * Generated with DSLord\n";
+    if (!options.deterministic) {
+        out << " * Date: " << getFormattedDateTime() << "\n";
+    }
+    out << " *\n";
+    out << " * Contains:\n";
+    
+    for (const auto& ds : selectedDS) {
+        // Find the display name for this data structure
+        string displayName = ds; // default
+        for (const auto& info : dataStructures) {
+            if (info.name == specName(ds)) {
+                displayName = info.displayName;
+                break;
+            }
+        }
+        out << " * - " << displayName;
+        if (ds != specName(ds)) {
+            out << " (" << ds.substr(ds.find(':') + 1) << ")";
+        }
+        out << "\n";
+    }
+    out << " */\n\n";
+    
+    // Add standard includes plus whatever the snippets and user types need
+    out << includeBlock(selectedDS, library, options);
+    
+    // Add using namespace statement
+    out << "using namespace std;\n\n";
+    buffer.appendOwned(out.str());
+    stats.record("emit_header", start, buffer.size());
+    
+    // Add all data structure implementations, separated by a blank line
+    start = chrono::steady_clock::now();
+    size_t bodyStart = buffer.size();
+    for (const auto& ds : selectedDS) {
+        auto content = library.content.find(ds);
+        if (content != library.content.end()) {
+            buffer.append(content->second);
+            buffer.append("\n");
+        }
+    }
+    stats.record("emit_body", start, buffer.size() - bodyStart);
+    
+    // Add example usage code, or the benchmark driver with --bench
+    start = chrono::steady_clock::now();
+    ostringstream example;
+    if (options.bench) {
+        generateBenchmarkCode(example, selectedDS, dataStructures);
+    } else {
+        generateExampleCode(example, selectedDS, dataStructures);
+    }
+    string exampleText = example.str();
+    size_t exampleBytes = exampleText.size();
+    buffer.appendOwned(move(exampleText));
+    stats.record(options.bench ? "emit_bench" : "emit_example", start, exampleBytes);
+}
+
+/**
+ * #include lines for a generated file: the standard set, any extra headers the
+ * selected snippets use, then the user's --include headers
+ */
+string includeBlock(const vector<string>& selectedDS, const SnippetLibrary& library, const GenerationOptions& options) {
+    vector<string> lines = {"#include <iostream>", "#include <string>", "#include <stdexcept>", "#include <algorithm>"};
+    if (options.bench) {
+        for (const char* header : {"<atomic>", "<chrono>", "<cmath>", "<cstdint>", "<cstdio>", "<cstdlib>",
+                                   "<new>", "<random>", "<thread>", "<vector>"}) {
+            lines.push_back(string("#include ") + header);
+        }
+    }
+    auto add = [&](const string& line) {
+        if (!line.empty() && find(lines.begin(), lines.end(), line) == lines.end()) {
+            lines.push_back(line);
+        }
+    };
+    
+    for (const auto& ds : selectedDS) {
+        auto includes = library.includes.find(ds);
+        if (includes != library.includes.end()) {
+            istringstream snippetIncludes{string(includes->second)};
+            string line;
+            while (getline(snippetIncludes, line)) {
+                add(line);
+            }
+        }
+    }
+    for (const auto& header : options.includes) {
+        add("#include " + (header[0] == '<' || header[0] == '"' ? header : "\"" + header + "\""));
+    }
+    
+    string block;
+    for (const auto& line : lines) {
+        block += line + "\n";
+    }
+    return block;
+}
+
+/**
+ * Check whether the file at path already holds exactly the buffer's content
+ */
+bool fileMatches(const string& path, const OutputBuffer& buffer) {
+    // A size mismatch settles it without reading the file
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || (size_t)info.st_size != buffer.size()) {
+        return false;
+    }
+    
+    ifstream file(path, ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    uint64_t h = FNV_OFFSET_BASIS;
+    char chunk[65536];
+    while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+        h = fnv1a(string_view(chunk, (size_t)file.gcount()), h);
+    }
+    return h == buffer.hash();
+}
+
+/**
+ * Write an assembled buffer to output_file, or to standard output when it is "-".
+ * Deterministic runs skip the write when the file is already up to date, so its
+ * mtime does not change and downstream builds are not invalidated.
+ */
+WriteResult writeOutput(const OutputBuffer& buffer, const string& output_file, const GenerationOptions& options) {
+    if (output_file == "-") {
+        return buffer.writeTo(1) ? WRITE_UPDATED : WRITE_FAILED;
+    }
+    
+    if (options.deterministic && fileMatches(output_file, buffer)) {
+        return WRITE_UNCHANGED;
+    }
+    
+    // Never write through a hardlink into a cache entry (older DSLord versions linked outputs to it)
+    error_code ec;
+    if (fs::hard_link_count(output_file, ec) > 1) {
+        fs::remove(output_file, ec);
+    }
+    
+#ifdef _WIN32
+    int fd = _open(output_file.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+    int fd = open(output_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd < 0) {
+        return WRITE_FAILED;
+    }
+    
+    bool ok = buffer.writeTo(fd);
+#ifdef _WIN32
+    ok = (_close(fd) == 0) && ok;
+#else
+    ok = (close(fd) == 0) && ok;
+#endif
+    return ok ? WRITE_UPDATED : WRITE_FAILED;
+}
+
+/**
+ * Class name used in generated code, e.g. "Binary Search Tree" -> BinarySearchTree
+ */
+string getClassName(const string& ds, const vector<DataStructureInfo>& dataStructures) {
+    string className = ds;
+    for (const auto& info : dataStructures) {
+        if (info.name == specName(ds)) {
+            className = info.displayName;
+            break;
+        }
+    }
+    className.erase(remove(className.begin(), className.end(), ' '), className.end());
+    return className;
+}
+
+/**
+ * Header mode: write one include-guarded <ClassName>.hpp per structure next to
+ * umbrella_file, the umbrella header including them all, and optionally a
+ * <umbrella>_pch.hpp stub for precompiling. Headers carry no timestamp and are
+ * left untouched when unchanged, so consumers only rebuild for real changes.
+ */
+WriteResult writeHeaderSet(const string& umbrella_file, const vector<DataStructureInfo>& dataStructures,
+                           const vector<string>& selectedDS, const SnippetLibrary& library,
+                           const GenerationOptions& options, GenerationStats& stats) {
+    auto start = chrono::steady_clock::now();
+    size_t totalBytes = 0;
+    GenerationOptions headerOptions = options;
+    headerOptions.deterministic = true;
+    
+    fs::path umbrella(umbrella_file);
+    fs::path dir = umbrella.parent_path();
+    string stem = umbrella.stem().string();
+    auto guardFor = [](string name) {
+        for (auto& c : name) {
+            c = isalnum((unsigned char)c) ? (char)toupper((unsigned char)c) : '_';
+        }
+        return "DSLORD_" + name + "_HPP";
+    };
+    
+    bool failed = false;
+    bool updated = false;
+    auto write = [&](const OutputBuffer& buffer, const fs::path& path) {
+        totalBytes += buffer.size();
+        WriteResult result = writeOutput(buffer, path.string(), headerOptions);
+        failed = failed || result == WRITE_FAILED;
+        updated = updated || result == WRITE_UPDATED;
+    };
+    
+    ostringstream umbrellaText;
+    umbrellaText << "/**\n * Data Structures (umbrella header)\n * Generated with DSLord\n *\n * Contains:\n";
+    set<string> written;
+    vector<string> headerNames;
+    for (const auto& ds : selectedDS) {
+        auto content = library.content.find(ds);
+        if (content == library.content.end() || !written.insert(specName(ds)).second) {
+            continue;
+        }
+        string className = getClassName(ds, dataStructures);
+        string headerName = className + ".hpp";
+        headerNames.push_back(headerName);
+        umbrellaText << " * - " << className << "\n";
+        
+        // Snippets assume `using namespace std`; scope it to namespace dslord
+        // instead of leaking it into every translation unit
+        ostringstream prologue;
+        prologue << "/**\n * " << className << " - Generated with DSLord\n */\n\n";
+        prologue << "#ifndef " << guardFor(className) << "\n#define " << guardFor(className) << "\n\n";
+        prologue << includeBlock({ds}, library, options) << "\n";
+        prologue << "namespace dslord {\nusing namespace std;\n\n";
+        
+        OutputBuffer buffer;
+        buffer.appendOwned(prologue.str());
+        buffer.append(content->second);
+        buffer.appendOwned("\n} // namespace dslord\n\n#endif // " + guardFor(className) + "\n");
+        write(buffer, dir / headerName);
+    }
+    
+    umbrellaText << " */\n\n#ifndef " << guardFor(stem) << "\n#define " << guardFor(stem) << "\n\n";
+    for (const auto& headerName : headerNames) {
+        umbrellaText << "#include \"" << headerName << "\"\n";
+    }
+    umbrellaText << "\n#endif // " << guardFor(stem) << "\n";
+    OutputBuffer umbrellaBuffer;
+    umbrellaBuffer.appendOwned(umbrellaText.str());
+    write(umbrellaBuffer, umbrella);
+    
+    if (options.pch) {
+        string pchName = stem + "_pch.hpp";
+        ostringstream pch;
+        pch << "/**\n * Precompiled header stub - Generated with DSLord\n *\n";
+        pch << " * Precompile once (e.g. g++ -x c++-header " << pchName << ") and include it first,\n";
+        pch << " * or pass it to your build system's precompiled-header support.\n */\n\n";
+        pch << "#ifndef " << guardFor(stem + "_pch") << "\n#define " << guardFor(stem + "_pch") << "\n\n";
+        pch << includeBlock(selectedDS, library, options) << "\n#include \"" << umbrella.filename().string() << "\"\n\n";
+        pch << "#endif // " << guardFor(stem + "_pch") << "\n";
+        OutputBuffer pchBuffer;
+        pchBuffer.appendOwned(pch.str());
+        write(pchBuffer, dir / pchName);
+    }
+    
+    stats.record("emit_headers", start, totalBytes);
+    if (failed) {
+        return WRITE_FAILED;
+    }
+    return updated ? WRITE_UPDATED : WRITE_UNCHANGED;
+}
+
+/**
+ * Default cache location: $XDG_CACHE_HOME/dslord, ~/.cache/dslord or %LOCALAPPDATA%\\dslord
+ */
+string defaultCacheDir() {
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) {
+        return string(xdg) + "/dslord";
+    }
+#ifdef _WIN32
+    const char* local = getenv("LOCALAPPDATA");
+    if (local && *local) {
+        return string(local) + "\\dslord";
+    }
+#endif
+    const char* home = getenv("HOME");
+    return string(home && *home ? home : ".") + "/.cache/dslord";
+}
+
+/**
+ * Content address of a generated file: the generator build, its options and the
+ * hash of every selected snippet, in order. Nothing is assembled to compute it.
+ */
+string cacheKey(const vector<string>& selectedDS, const SnippetLibrary& library, const GenerationOptions& options) {
+    ostringstream description;
+    description << "dslord " << DSLORD_VERSION << " " << __DATE__ << " " << __TIME__ << "\n";
+    description << "deterministic=" << options.deterministic << "\n";
+    description << "bench=" << options.bench << "\n";
+    for (const auto& header : options.includes) {
+        description << "include=" << header << "\n";
+    }
+    for (const auto& ds : selectedDS) {
+        auto h = library.hashes.find(ds);
+        description << ds << "=" << hex << (h != library.hashes.end() ? h->second : 0) << dec << "\n";
+    }
+    
+    ostringstream key;
+    key << hex << setw(16) << setfill('0') << fnv1a(description.str());
+    return key.str();
+}
+
+/**
+ * Produce a writable output_file from a cache entry by reflink, or else a single copy
+ */
+bool materializeFromCache(const string& entry, const string& output_file) {
+    error_code ec;
+    fs::remove(output_file, ec);
+    
+#ifdef __linux__
+    // Copy-on-write clone: free on btrfs/XFS, fails fast elsewhere
+    int src = open(entry.c_str(), O_RDONLY);
+    if (src >= 0) {
+        int dst = open(output_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool cloned = dst >= 0 && ioctl(dst, FICLONE, src) == 0;
+        if (dst >= 0) {
+            close(dst);
+        }
+        close(src);
+        if (cloned) {
+            return true;
+        }
+        fs::remove(output_file, ec);
+    }
+#endif
+    
+    // No hardlink: the output would share the entry's inode, so refreshing its
+    // mtime would also touch the entry and every other output linked to it,
+    // and the output would be as read-only as the entry
+    fs::copy_file(entry, output_file, fs::copy_options::overwrite_existing, ec);
+    if (!ec) {
+        fs::permissions(output_file, fs::perms::owner_write, fs::perm_options::add, ec);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Add a generated buffer to the cache; the rename makes concurrent stores safe
+ */
+void storeInCache(const OutputBuffer& buffer, const string& entry) {
+    error_code ec;
+    fs::create_directories(fs::path(entry).parent_path(), ec);
+    
+    // Unique per process and thread, as many jobs may store the same entry at once
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = getpid();
+#endif
+    ostringstream temp;
+    temp << entry << ".tmp." << pid << "." << hex << hash<thread::id>()(this_thread::get_id());
+    string tempPath = temp.str();
+    
+    GenerationOptions plain;
+    if (writeOutput(buffer, tempPath, plain) != WRITE_UPDATED) {
+        fs::remove(tempPath, ec);
+        return;
+    }
+    fs::permissions(tempPath, fs::perms::owner_read | fs::perms::group_read | fs::perms::others_read,
+                    fs::perm_options::replace, ec);
+    fs::rename(tempPath, entry, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+    }
+}
+
+/**
+ * Write one generated file from already loaded snippets (no console output).
+ * With a cache directory, identical requests are served from the cache instead
+ * of being assembled again.
+ */
+WriteResult writeGeneratedFile(const string& output_file, const vector<DataStructureInfo>& dataStructures,
+                               const vector<string>& selectedDS, const SnippetLibrary& library,
+                               const GenerationOptions& options, GenerationStats& stats) {
+    if (options.headers) {
+        return writeHeaderSet(output_file, dataStructures, selectedDS, library, options, stats);
+    }
+    
+    bool useCache = !options.cacheDir.empty() && output_file != "-";
+    string entry;
+    if (useCache) {
+        auto lookupStart = chrono::steady_clock::now();
+        entry = options.cacheDir + "/" + cacheKey(selectedDS, library, options) + ".cpp";
+        error_code ec;
+        if (fs::exists(entry, ec)) {
+            // Leave an identical output alone, as --deterministic does
+            uintmax_t entrySize = fs::file_size(entry, ec);
+            if (!ec && fs::exists(output_file, ec) && fs::file_size(output_file, ec) == entrySize && !ec) {
+                ifstream a(entry, ios::binary), b(output_file, ios::binary);
+                if (equal(istreambuf_iterator<char>(a), istreambuf_iterator<char>(),
+                          istreambuf_iterator<char>(b), istreambuf_iterator<char>())) {
+                    stats.cacheHits++;
+                    stats.record("cache_hit", lookupStart, 0);
+                    return WRITE_UNCHANGED;
+                }
+            }
+            if (materializeFromCache(entry, output_file)) {
+                stats.cacheHits++;
+                stats.record("cache_hit", lookupStart, entrySize);
+                return WRITE_UPDATED;
+            }
+        }
+        stats.cacheMisses++;
+        stats.record("cache_lookup", lookupStart, 0);
+    }
+    
+    OutputBuffer buffer;
+    assembleOutput(buffer, dataStructures, selectedDS, library, options, stats);
+    auto writeStart = chrono::steady_clock::now();
+    WriteResult result = writeOutput(buffer, output_file, options);
+    stats.record(result == WRITE_UNCHANGED ? "compare_unchanged" : "write", writeStart, buffer.size());
+    if (useCache && result != WRITE_FAILED) {
+        auto storeStart = chrono::steady_clock::now();
+        storeInCache(buffer, entry);
+        stats.record("cache_store", storeStart, buffer.size());
+    }
+    return result;
+}
+
+/**
+ * Generate the output file with the selected data structures
+ */
+void generateFile(const string& output_file, const vector<DataStructureInfo>& dataStructures, 
+                const vector<string>& selectedDS, const GenerationOptions& options, GenerationStats& stats) {
+    // Collect content for all selected data structures
+    SnippetLibrary library;
+    cout << COLOR_CYAN << "\nReading data structure implementations..." << COLOR_RESET << endl;
+    loadSnippets(selectedDS, dataStructures, options.snippetDir, library, true, stats);
+    
+    cout << COLOR_CYAN << "\nWriting data structures to file..." << COLOR_RESET << endl;
+    for (const auto& ds : selectedDS) {
+        if (library.content.find(ds) != library.content.end()) {
+            for (const auto& info : dataStructures) {
+                if (info.name == specName(ds)) {
+                    cout << "  " << COLOR_GREEN << "✓" << COLOR_RESET << " Adding " << info.displayName << endl;
+                    break;
+                }
+            }
+        }
+    }
+    
+    WriteResult result = writeGeneratedFile(output_file, dataStructures, selectedDS, library, options, stats);
+    if (!options.cacheDir.empty() && output_file != "-") {
+        cout << "\n  Cache " << (stats.cacheHits ? "hit" : "miss") << " (" << options.cacheDir << ")" << endl;
+    }
+    if (result == WRITE_FAILED) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Failed to write output file: " << output_file << endl;
+        return;
+    }
+    if (result == WRITE_UNCHANGED) {
+        cout << COLOR_GREEN << "\n" << output_file << " is already up to date (left untouched)" << COLOR_RESET << endl;
+        return;
+    }
+    cout << COLOR_GREEN << "\nAll data structures successfully written to "
+         << (output_file == "-" ? "<stdout>" : output_file) << COLOR_RESET << endl;
+}
+
+/**
+ * Parse a manifest: one output per line as "<output_file> [-flags...]".
+ * Blank lines and lines starting with '#' are ignored.
+ */
+bool readManifest(const string& manifest_file, const vector<DataStructureInfo>& dataStructures,
+                  vector<GenerationJob>& jobs) {
+    ifstream file(manifest_file);
+    if (!file) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Manifest not found: " << manifest_file << endl;
+        return false;
+    }
+    
+    bool ok = true;
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        istringstream tokens(line);
+        vector<string> words;
+        string word;
+        while (tokens >> word) {
+            words.push_back(word);
+        }
+        if (words.empty() || words[0][0] == '#') {
+            continue;
+        }
+        
+        GenerationJob job;
+        job.outputFile = words[0];
+        for (const auto& problem : parseSelectionFlags(words, 1, dataStructures, job.selectedDS)) {
+            cout << COLOR_YELLOW << "WARNING: " << COLOR_RESET << manifest_file << ":" << lineNumber
+                 << ": " << problem << endl;
+        }
+        if (job.selectedDS.empty()) {
+            cout << COLOR_RED << "ERROR: " << COLOR_RESET << manifest_file << ":" << lineNumber
+                 << ": No data structures selected for " << job.outputFile << endl;
+            ok = false;
+            continue;
+        }
+        jobs.push_back(job);
+    }
+    return ok;
+}
+
+/**
+ * Generate every manifest entry, sharing one copy of each snippet across a small thread pool
+ */
+bool runManifest(const string& manifest_file, const vector<DataStructureInfo>& dataStructures,
+                 const GenerationOptions& options, unsigned threadCount, GenerationStats& stats) {
+    auto start = chrono::steady_clock::now();
+    
+    vector<GenerationJob> jobs;
+    if (!readManifest(manifest_file, dataStructures, jobs)) {
+        return false;
+    }
+    stats.record("read_manifest", start, 0);
+    
+    // Every snippet is loaded once, then only read by the workers
+    vector<string> allDS;
+    for (const auto& job : jobs) {
+        allDS.insert(allDS.end(), job.selectedDS.begin(), job.selectedDS.end());
+    }
+    SnippetLibrary library;
+    if (!loadSnippets(allDS, dataStructures, options.snippetDir, library, false, stats)) {
+        return false;
+    }
+    
+    if (threadCount == 0) {
+        threadCount = max(1u, min(8u, thread::hardware_concurrency()));
+    }
+    threadCount = min<unsigned>(threadCount, max<size_t>(1, jobs.size()));
+    
+    atomic<size_t> nextJob(0);
+    atomic<size_t> unchanged(0);
+    mutex failedMutex;
+    vector<string> failed;
+    auto worker = [&]() {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+            WriteResult result = writeGeneratedFile(jobs[i].outputFile, dataStructures, jobs[i].selectedDS,
+                                                    library, options, stats);
+            if (result == WRITE_UNCHANGED) {
+                unchanged++;
+            } else if (result == WRITE_FAILED) {
+                lock_guard<mutex> lock(failedMutex);
+                failed.push_back(jobs[i].outputFile);
+            }
+        }
+    };
+    
+    vector<thread> pool;
+    for (unsigned t = 1; t < threadCount; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+    
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    for (const auto& file : failed) {
+        cout << COLOR_RED << "ERROR: " << COLOR_RESET << "Failed to write output file: " << file << endl;
+    }
+    
+    // One summary for the whole manifest
+    cout << (failed.empty() ? COLOR_GREEN : COLOR_YELLOW);
+    cout << "Manifest " << manifest_file << ": " << (jobs.size() - failed.size()) << "/" << jobs.size()
+         << " files generated";
+    if (options.deterministic) {
+        cout << " (" << unchanged << " unchanged)";
+    }
+    cout << " from " << library.content.size() << " snippets in " << elapsed << " ms ("
+         << threadCount << (threadCount == 1 ? " thread" : " threads") << ")";
+    if (!options.cacheDir.empty()) {
+        cout << "; cache: " << stats.cacheHits << " hits, " << stats.cacheMisses << " misses";
+    }
+    cout << COLOR_RESET << endl;
+    return failed.empty();
+}
+
+/**
+ * Generate example usage code
+ */
+void generateExampleCode(ostream& out_file, const vector<string>& selectedDS, 
+                        const vector<DataStructureInfo>& dataStructures) {
+    out_file << "/**\n";
+    out_file << " * Example usage of implemented data structures\n";
+    out_file << " */\n";
+    out_file << "int main() {\n";
+    out_file << "    cout << \"+----------------------------------------------+\" << endl;\n";
+    out_file << "    cout << \"|  Data Structures Implementation Example     |\" << endl;\n";
+    out_file << "    cout << \"+----------------------------------------------+\" << endl << endl;\n";
+    
+    // Group data structures by category for better example organization
+    map<string, vector<string>> categorizedDS;
+    
+    for (const auto& ds : selectedDS) {
+        // Find the category for this data structure
+        for (const auto& info : dataStructures) {
+            if (info.name == specName(ds)) {
+                categorizedDS[info.category].push_back(ds);
+                break;
+            }
+        }
+    }
+    
+    // Generate examples for each category
+    for (const auto& category : categorizedDS) {
+        out_file << "    // " << category.first << " Data Structures Examples\n";
+        out_file << "    cout << \"\\n" << category.first << " Data Structures:\" << endl;\n";
+        out_file << "    cout << \"" << string(category.first.length() + 16, '-') << "\" << endl;\n\n";
+        
+        for (const auto& spec : category.second) {
+            string ds = specName(spec);
             string displayName = ds;
-            string className = "";
+            string className = getClassName(ds, dataStructures);
             string varName = ds;
             
             // Find the display name for prettier output
             for (const auto& info : dataStructures) {
-                if (info.name == ds) {
+                if (info.name == specName(ds)) {
                     displayName = info.displayName;
                     break;
                 }
             }
             
-            // Use the actual class name (which might have spaces in the display name)
-            // For actual class name in code, remove spaces
-            className = displayName;
-            className.erase(remove(className.begin(), className.end(), ' '), className.end());
-            
             // Clean up variable name: remove spaces, underscores
             varName.erase(remove(varName.begin(), varName.end(), ' '), varName.end());
             varName.erase(remove(varName.begin(), varName.end(), '_'), varName.end());
@@ -398,7 +1692,12 @@ void generateExampleCode(ofstream& out_file, const vector<string>& selectedDS,
             out_file << "    cout << \"\\n" << displayName << " operations:\" << endl;\n";
             out_file << "    " << className << " " << varName << ";\n";
             
-            if (ds == "stack") {
+            // The examples below use integer literals
+            if (!hasNumericTypes(parseSpec(spec))) {
+                out_file << "    // " << className << " is specialized for " << spec.substr(spec.find(':') + 1)
+                         << "; add example usage here\n";
+            }
+            else if (ds == "stack") {
                 out_file << "    " << varName << ".push(10);\n";
                 out_file << "    " << varName << ".push(20);\n";
                 out_file << "    " << varName << ".push(30);\n";
@@ -449,12 +1748,23 @@ void generateExampleCode(ofstream& out_file, const vector<string>& selectedDS,
                 out_file << "    " << varName << ".insert(1, 100);\n";
                 out_file << "    " << varName << ".insert(2, 200);\n";
                 out_file << "    " << varName << ".insert(3, 300);\n";
-                out_file << "    int value;\n";
+                out_file << "    " << className << "::ValueType value;\n";
                 out_file << "    if (" << varName << ".get(2, value)) {\n";
                 out_file << "        cout << \"Value for key 2: \" << value << endl;\n";
                 out_file << "    }\n";
                 out_file << "    " << varName << ".display();\n";
-                out_file << "    cout << \"Removing key 2: \" << (" << varName << ".remove(2) ? \"Success\" : \"Not found\") << endl;\n";
+                out_file << "    cout << \"Removing key 2: \" << (" << varName << ".remove(2) ? \"Success\" : \"Not found\") << endl;\n";
+                out_file << "    " << varName << ".display();\n";
+            }
+            else if (snippetName(spec, dataStructures) == "deque_workstealing") {
+                // The owner thread works at the rear; other threads steal from the front
+                out_file << "    " << varName << ".insertRear(10);\n";
+                out_file << "    " << varName << ".insertRear(20);\n";
+                out_file << "    " << varName << ".insertRear(30);\n";
+                out_file << "    " << varName << ".display();\n";
+                out_file << "    cout << \"Rear: \" << " << varName << ".getRear() << endl;\n";
+                out_file << "    cout << \"Deleting from rear: \" << " << varName << ".deleteRear() << endl;\n";
+                out_file << "    cout << \"Stealing from front: \" << " << varName << ".deleteFront() << endl;\n";
                 out_file << "    " << varName << ".display();\n";
             }
             else if (ds == "deque") {
@@ -466,6 +1776,16 @@ void generateExampleCode(ofstream& out_file, const vector<string>& selectedDS,
                 out_file << "    cout << \"Deleting from front: \" << " << varName << ".deleteFront() << endl;\n";
                 out_file << "    " << varName << ".display();\n";
             }
+            else if (ds == "slidingwindow") {
+                out_file << "    " << varName << ".push(1, 30);\n";
+                out_file << "    " << varName << ".push(2, 10);\n";
+                out_file << "    " << varName << ".push(3, 20);\n";
+                out_file << "    " << varName << ".push(4, 40);\n";
+                out_file << "    " << varName << ".display();\n";
+                out_file << "    cout << \"Expiring before 3: \" << " << varName << ".expireBefore(3) << \" samples\" << endl;\n";
+                out_file << "    cout << \"Min: \" << " << varName << ".windowMin() << \", Max: \" << " << varName << ".windowMax() << endl;\n";
+                out_file << "    " << varName << ".display();\n";
+            }
             else if (ds == "array") {
                 out_file << "    " << varName << ".pushBack(10);\n";
                 out_file << "    " << varName << ".pushBack(20);\n";
@@ -490,6 +1810,1058 @@ void generateExampleCode(ofstream& out_file, const vector<string>& selectedDS,
     out_file << "}\n";
 }
 
+// Support code for --bench: heap accounting for the peak_bytes and allocs columns, key
+// generation, CSV output and the four workloads shared by every structure
+static const char* BENCH_SUPPORT = R"(/**
+ * Micro-benchmark of the implemented data structures
+ *
+ * Usage: <program> [N]   (N operations per workload, default 100000)
+ * Prints CSV: structure,workload,keys,threads,size,ops,ns_per_op,ops_per_sec,peak_bytes,allocs
+ * peak_bytes is the peak heap usage while the workload ran, structure included,
+ * and allocs the number of heap allocations it made.
+ * Exits with status 1 if a multi-threaded stress run loses or duplicates elements.
+ */
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+// Sanitizers bring their own allocator, so they keep the operator new accounting
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#define BENCH_COUNT_MALLOC 1
+#include <cerrno>
+#include <malloc.h>
+#endif
+
+static atomic<size_t> benchLiveBytes(0);
+static atomic<size_t> benchPeakBytes(0);
+static atomic<size_t> benchAllocations(0);
+static double benchSink = 0;  // consumes results so lookups are not optimized away
+static bool benchFailed = false;
+
+// Record a new block of `size` bytes
+static void benchAllocated(size_t size) {
+    benchAllocations.fetch_add(1, memory_order_relaxed);
+    size_t live = benchLiveBytes += size;
+    size_t peak = benchPeakBytes.load(memory_order_relaxed);
+    while (live > peak && !benchPeakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {
+    }
+}
+
+#ifdef BENCH_COUNT_MALLOC
+// Heap accounting with glibc: the C allocation functions are replaced by ones
+// that forward to glibc's and record each block's usable size, so operator new
+// and structures keeping their storage in malloc'd memory are both measured
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    void* block = __libc_malloc(size);
+    if (block) {
+        benchAllocated(malloc_usable_size(block));
+    }
+    return block;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* block = __libc_calloc(count, size);
+    if (block) {
+        benchAllocated(malloc_usable_size(block));
+    }
+    return block;
+}
+
+void* realloc(void* ptr, size_t size) {
+    size_t oldSize = ptr ? malloc_usable_size(ptr) : 0;
+    void* block = __libc_realloc(ptr, size);
+    if (block || size == 0) {
+        benchLiveBytes -= oldSize;
+    }
+    if (block) {
+        benchAllocated(malloc_usable_size(block));
+    }
+    return block;
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* block = __libc_memalign(alignment, size);
+    if (block) {
+        benchAllocated(malloc_usable_size(block));
+    }
+    return block;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* block = memalign(alignment, size);
+    if (!block) {
+        return ENOMEM;
+    }
+    *result = block;
+    return 0;
+}
+
+void free(void* ptr) {
+    if (ptr) {
+        benchLiveBytes -= malloc_usable_size(ptr);
+        __libc_free(ptr);
+    }
+}
+}
+#else
+// Heap accounting elsewhere: every operator new allocation carries its size in
+// a max_align_t header (memory a structure takes from malloc is not counted)
+void* operator new(size_t size) {
+    void* block = malloc(size + sizeof(max_align_t));
+    if (!block) {
+        throw bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    benchAllocated(size);
+    return static_cast<char*>(block) + sizeof(max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        void* block = static_cast<char*>(ptr) - sizeof(max_align_t);
+        benchLiveBytes -= *static_cast<size_t*>(block);
+        free(block);
+    }
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+#endif
+
+// Keys in [0, range): "uniform", or "zipf", a log-uniform approximation of a
+// Zipf distribution where small keys are far more frequent
+vector<uint64_t> benchKeys(size_t count, uint64_t range, bool zipf) {
+    mt19937_64 rng(42);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<uint64_t> keys(count);
+    for (auto& key : keys) {
+        double u = unit(rng);
+        key = zipf ? (uint64_t)exp(u * log((double)range + 1.0)) - 1 : (uint64_t)(u * range);
+        key = min(key, range - 1);
+    }
+    return keys;
+}
+
+void benchReport(const char* structure, const char* workload, const char* keys, unsigned threads,
+                 size_t size, size_t ops, double ns, size_t peakBytes, size_t allocations) {
+    double perOp = ops ? ns / ops : 0.0;
+    printf("%s,%s,%s,%u,%zu,%zu,%.2f,%.0f,%zu,%zu\n", structure, workload, keys, threads, size, ops,
+           perOp, perOp > 0 ? 1e9 / perOp : 0.0, peakBytes, allocations);
+}
+
+// Record a failed stress check
+void benchCheck(bool ok, const char* structure, const char* problem) {
+    if (!ok) {
+        cerr << "STRESS FAILURE: " << structure << ": " << problem << endl;
+        benchFailed = true;
+    }
+}
+
+// Pin the calling thread to one CPU (Linux only; elsewhere a no-op)
+void benchPinThread(unsigned cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % max(1u, thread::hardware_concurrency()), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// Time run(threads) on 1, 2, 4, ... up to the hardware thread count, or only
+// on fixedThreads when that is not 0. run returns the number of operations
+// all threads performed together.
+template <typename Run>
+void benchScaling(const char* name, const char* workload, unsigned fixedThreads, Run run) {
+    typedef chrono::steady_clock Clock;
+    unsigned maxThreads = fixedThreads ? fixedThreads : max(1u, thread::hardware_concurrency());
+    run(maxThreads);  // warmup
+    for (unsigned threads = fixedThreads ? fixedThreads : 1;; threads = min(threads * 2, maxThreads)) {
+        size_t baseline = benchLiveBytes;
+        size_t allocations = benchAllocations;
+        benchPeakBytes = baseline;
+        Clock::time_point start = Clock::now();
+        size_t ops = run(threads);
+        double ns = chrono::duration<double, nano>(Clock::now() - start).count();
+        benchReport(name, workload, "cyclic", threads, 0, ops, ns, benchPeakBytes - baseline,
+                    benchAllocations - allocations);
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+}
+
+// Run the insert, lookup, remove and mixed workloads, each on a fresh S.
+// keys holds `size` fill keys followed by `ops` probe keys. Inserting stops
+// early when a fixed-capacity structure throws overflow_error.
+template <typename S, typename Insert, typename Lookup, typename Remove>
+void benchStructure(const char* name, const char* keyDist, const vector<uint64_t>& keys,
+                    size_t size, size_t ops, bool report, Insert insert, Lookup lookup, Remove remove) {
+    typedef chrono::steady_clock Clock;
+    size_t baseline = 0;
+    size_t allocations = 0;
+    Clock::time_point start;
+    
+    auto begin = [&]() {
+        baseline = benchLiveBytes;
+        benchPeakBytes = baseline;
+    };
+    auto startClock = [&]() {
+        allocations = benchAllocations;
+        start = Clock::now();
+    };
+    auto fill = [&](S& s, size_t count) {
+        size_t held = 0;
+        try {
+            for (; held < count; held++) {
+                insert(s, keys[held]);
+            }
+        } catch (const overflow_error&) {
+        }
+        return held;
+    };
+    auto finish = [&](const char* workload, size_t held, size_t count) {
+        double ns = chrono::duration<double, nano>(Clock::now() - start).count();
+        if (report) {
+            benchReport(name, workload, keyDist, 1, held, count, ns, benchPeakBytes - baseline,
+                        benchAllocations - allocations);
+        }
+    };
+    
+    // insert: grow an empty structure to `size` elements
+    {
+        begin();
+        S s;
+        startClock();
+        size_t held = fill(s, size);
+        finish("insert", held, held);
+    }
+    
+    // lookup: `ops` probes against a full structure
+    {
+        begin();
+        S s;
+        size_t held = fill(s, size);
+        startClock();
+        for (size_t i = 0; i < ops; i++) {
+            lookup(s, keys[size + i], i % held);
+        }
+        finish("lookup", held, ops);
+    }
+    
+    // remove: take every filled element out again
+    {
+        begin();
+        S s;
+        size_t held = fill(s, size);
+        startClock();
+        for (size_t i = 0; i < held; i++) {
+            remove(s, keys[i]);
+        }
+        finish("remove", held, held);
+    }
+    
+    // mixed: 50% lookup, 25% insert, 25% remove on a half-full structure
+    {
+        begin();
+        S s;
+        size_t held = fill(s, size / 2);
+        size_t live = held;
+        startClock();
+        for (size_t i = 0; i < ops; i++) {
+            uint64_t key = keys[size + i];
+            unsigned roll = (unsigned)((i * 0x9E3779B97F4A7C15ULL) >> 62);
+            if (live == 0 || roll == 2) {
+                try {
+                    insert(s, key);
+                    live++;
+                    continue;
+                } catch (const overflow_error&) {
+                    roll = 3;
+                }
+            }
+            if (roll == 3) {
+                remove(s, key);
+                live--;
+            } else {
+                lookup(s, key, i % live);
+            }
+        }
+        finish("mixed", held, ops);
+    }
+}
+)";
+
+// Opening of the benchmark's main(); the per-structure workloads follow
+static const char* BENCH_MAIN = R"(
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    if (n == 0) {
+        cerr << "Usage: " << argv[0] << " [operations]" << endl;
+        return 1;
+    }
+    
+    printf("structure,workload,keys,threads,size,ops,ns_per_op,ops_per_sec,peak_bytes,allocs\n");
+    for (int zipf = 0; zipf < 2; zipf++) {
+        const char* dist = zipf ? "zipf" : "uniform";
+)";
+
+// A multi-threaded workload: the body of a function of `threads` that runs
+// about `n` operations per thread, checks the result and returns the operation count
+struct BenchWorkload {
+    string name;
+    string body;
+    unsigned threads;  // 0: scale from 1 to N threads
+};
+
+// How the benchmark drives one structure (or variant snippet): statements run
+// with `s` (the structure), `key` (uint64_t) and, for lookups, `index` (a valid
+// position). `C` stands for the class name. Some structures also have extra
+// workloads (thread scaling for the thread-safe ones), and `support` is code
+// they share, emitted once before main().
+struct BenchOperations {
+    string name;
+    string insert;
+    string lookup;
+    string remove;
+    size_t maxSize;  // 0: no limit beyond N
+    vector<BenchWorkload> scaling = {};
+    string support = "";
+};
+
+// A producer and a consumer pinned to different CPUs move 10n values; the
+// consumer checks they arrive complete and in order
+static const char* BENCH_QUEUE_TRANSFER = R"(C s;
+size_t total = n * 10;
+bool ordered = true;
+thread consumer([&]() {
+    benchPinThread(1);
+    C::ValueType value;
+    for (size_t i = 0, idle = 0; i < total;) {
+        if (s.tryDequeue(value)) {
+            ordered = ordered && value == (C::ValueType)(i % 100 + 1);
+            i++;
+        } else if (++idle % 64 == 0) {
+            this_thread::yield();
+        }
+    }
+});
+thread producer([&]() {
+    benchPinThread(0);
+    for (size_t i = 0, idle = 0; i < total;) {
+        if (s.tryEnqueue((C::ValueType)(i % 100 + 1))) {
+            i++;
+        } else if (++idle % 64 == 0) {
+            this_thread::yield();
+        }
+    }
+});
+producer.join();
+consumer.join();
+benchCheck(ordered, name, "values arrived out of order or corrupted");
+return total;)";
+
+// Half the threads produce n values each and the other half consume them
+// (one thread alternates both roles); consumers check nothing is lost or duplicated
+static const char* BENCH_QUEUE_FANIO = R"(C s;
+unsigned producers = max(1u, threads / 2), consumers = max(1u, threads - producers);
+size_t total = producers * n;
+atomic<size_t> consumed(0);
+atomic<uint64_t> received(0);
+auto produce = [&]() {
+    for (size_t i = 0; i < n;) {
+        if (s.tryEnqueue((C::ValueType)(i % 100 + 1))) {
+            i++;
+        } else {
+            this_thread::yield();
+        }
+    }
+};
+auto consume = [&]() {
+    uint64_t sum = 0;
+    C::ValueType value;
+    while (consumed.load(memory_order_relaxed) < total) {
+        if (s.tryDequeue(value)) {
+            sum += (uint64_t)value;
+            consumed++;
+        } else {
+            this_thread::yield();
+        }
+    }
+    received += sum;
+};
+if (threads == 1) {
+    C::ValueType value;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        s.enqueue((C::ValueType)(i % 100 + 1));
+        sum += s.tryDequeue(value) ? (uint64_t)value : 0;
+    }
+    received = sum;
+} else {
+    vector<thread> workers;
+    for (unsigned t = 0; t < producers; t++) {
+        workers.emplace_back(produce);
+    }
+    for (unsigned t = 0; t < consumers; t++) {
+        workers.emplace_back(consume);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+uint64_t expected = 0;
+for (size_t i = 0; i < n; i++) {
+    expected += producers * (i % 100 + 1);
+}
+benchCheck(received == expected && s.isEmpty(), name, "dequeued values differ from enqueued values");
+return total;)";
+
+// Half the threads enqueue n values each with blocking enqueue() and the other
+// half drain them in batches with dequeueUpTo() until the queue is closed (one
+// thread alternates both roles); nothing may be lost or duplicated
+static const char* BENCH_QUEUE_BLOCKING = R"(C s;
+unsigned producers = max(1u, threads / 2), consumers = max(1u, threads - producers);
+atomic<uint64_t> received(0);
+auto consume = [&]() {
+    C::ValueType batch[256];
+    uint64_t sum = 0;
+    while (true) {
+        int got = s.dequeueUpTo(batch, 256, chrono::milliseconds(100));
+        if (got == 0 && s.isClosed() && s.isEmpty()) {
+            break;
+        }
+        for (int i = 0; i < got; i++) {
+            sum += (uint64_t)batch[i];
+        }
+    }
+    received += sum;
+};
+if (threads == 1) {
+    C::ValueType value;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        s.enqueue((C::ValueType)(i % 100 + 1));
+        sum += s.dequeueUpTo(&value, 1, chrono::milliseconds(0)) ? (uint64_t)value : 0;
+    }
+    received = sum;
+} else {
+    vector<thread> consumerThreads, producerThreads;
+    for (unsigned t = 0; t < consumers; t++) {
+        consumerThreads.emplace_back(consume);
+    }
+    for (unsigned t = 0; t < producers; t++) {
+        producerThreads.emplace_back([&]() {
+            for (size_t i = 0; i < n; i++) {
+                s.enqueue((C::ValueType)(i % 100 + 1));
+            }
+        });
+    }
+    for (auto& producer : producerThreads) {
+        producer.join();
+    }
+    s.close();
+    for (auto& consumer : consumerThreads) {
+        consumer.join();
+    }
+}
+uint64_t expected = 0;
+for (size_t i = 0; i < n; i++) {
+    expected += producers * (i % 100 + 1);
+}
+benchCheck(received == expected && s.isEmpty(), name, "dequeued values differ from enqueued values");
+return producers * n;)";
+
+// 100000 producer coroutines, then 100000 consumer coroutines, move n values
+// in all through one queue on one thread; most of them suspend on a full or
+// empty queue until the scheduler resumes them
+static const char* BENCH_QUEUE_COROUTINES = R"(C::Scheduler scheduler;
+C s(scheduler);
+size_t tasks = 100000, perTask = max((size_t)1, n / tasks);
+uint64_t received = 0;
+auto producer = [](C& s, size_t count) -> C::Task {
+    for (size_t i = 0; i < count; i++) {
+        co_await s.push((C::ValueType)(i % 100 + 1));
+    }
+};
+auto consumer = [](C& s, size_t count, uint64_t& sum) -> C::Task {
+    for (size_t i = 0; i < count; i++) {
+        sum += (uint64_t)(co_await s.pop());
+    }
+};
+for (size_t t = 0; t < tasks; t++) {
+    scheduler.spawn(producer(s, perTask));
+}
+for (size_t t = 0; t < tasks; t++) {
+    scheduler.spawn(consumer(s, perTask, received));
+}
+scheduler.run();
+uint64_t expected = 0;
+for (size_t i = 0; i < perTask; i++) {
+    expected += tasks * (i % 100 + 1);
+}
+benchCheck(received == expected && s.isEmpty() && scheduler.liveTasks() == 0, name,
+           "coroutines lost, duplicated or stranded values");
+return tasks * perTask * 2;)";
+
+// Every thread pushes n values and pops after each push; the popped and
+// remaining values must add up to exactly what was pushed
+static const char* BENCH_STACK_PUSHPOP = R"(C s;
+atomic<uint64_t> popped(0);
+vector<thread> workers;
+for (unsigned t = 0; t < threads; t++) {
+    workers.emplace_back([&]() {
+        uint64_t sum = 0;
+        C::ValueType value;
+        for (size_t i = 0; i < n; i++) {
+            s.push((C::ValueType)(i % 100 + 1));
+            if (s.tryPop(value)) {
+                sum += (uint64_t)value;
+            }
+        }
+        popped += sum;
+    });
+}
+for (auto& worker : workers) {
+    worker.join();
+}
+uint64_t sum = popped, expected = 0;
+C::ValueType value;
+while (s.tryPop(value)) {
+    sum += (uint64_t)value;
+}
+for (size_t i = 0; i < n; i++) {
+    expected += threads * (i % 100 + 1);
+}
+benchCheck(sum == expected, name, "popped values differ from pushed values");
+return threads * n * 2;)";
+
+// At least a million short-lived arrays of 1 to 16 elements, each filled, read
+// once and destroyed; the allocs column shows the allocations an inline buffer saves
+static const char* BENCH_ARRAY_SHORTLIVED = R"(size_t arrays = max(n, (size_t)1000000);
+for (size_t i = 0; i < arrays; i++) {
+    C s;
+    int length = (int)(i % 16) + 1;
+    for (int j = 0; j < length; j++) {
+        s.pushBack((C::ValueType)(i + j));
+    }
+    benchSink += s.get((int)(i % length));
+}
+return arrays;)";
+
+// Array algorithm workloads. The scans run sum, min, max, minMaxIndex, count
+// and find over an array of n elements, repeated so filling the array is a
+// small part of the time; scan_scalar runs them with the vector kernels off.
+// Both check the kernels against the plain loops in their warmup. The parallel workload
+// runs the parallel algorithms on the pool, and sequential the same code with a
+// grain above n.
+static const char* BENCH_ARRAY_ALGORITHMS = R"(
+#include <cmath>
+#include <limits>
+
+// Equal, or both NaN
+template <typename T>
+bool benchSameValue(T a, T b) {
+    return a == b || (a != a && b != b);
+}
+
+// Compare every scan at level with the plain loops, on arrays whose sizes end
+// in a partial vector or block. Floating-point arrays are also checked with a
+// NaN first, second (inside the first vector) and last. Results must be equal,
+// except that floating-point sums depend on the order of the additions and only
+// have to be within the rounding bound of n additions (epsilon is 0 for integers).
+template <typename A>
+bool benchArrayScansMatch(typename A::SimdLevel level) {
+    typedef typename A::ValueType T;
+    const int lanes = sizeof(T) < 64 ? 64 / (int)sizeof(T) : 1;  // AVX-512 lanes, the widest
+    typename A::SimdLevel detected = A::simdLevel();
+    bool ok = true;
+    for (int n : {0, 1, lanes - 1, lanes + 3, 16 * lanes + 3, 1000003}) {
+        for (int nanAt : {-1, 0, 1, n - 1}) {
+            if (nanAt >= n || (nanAt >= 0 && !numeric_limits<T>::has_quiet_NaN)) {
+                continue;
+            }
+            A array;
+            array.reserve(n);
+            long double magnitude = 0;
+            for (int i = 0; i < n; i++) {
+                array.pushBack((T)((long long)(i * 2654435761u % 2001) - 1000));
+                magnitude += fabsl((long double)array.get(i));
+            }
+            if (nanAt >= 0) {
+                array.set(nanAt, numeric_limits<T>::quiet_NaN());
+            }
+            T probe = n > 0 ? array.get(n / 2) : T();
+            
+            A::setSimdLevel(A::SIMD_SCALAR);
+            typename A::SumType sum = array.sum();
+            int count = array.count(probe);
+            int position = array.find(probe);
+            pair<int, int> extremes = n > 0 ? array.minMaxIndex() : make_pair(-1, -1);
+            T low = n > 0 ? array.min() : T();
+            T high = n > 0 ? array.max() : T();
+            
+            A::setSimdLevel(level);
+            typename A::SumType vectorSum = array.sum();
+            long double bound = 2.0L * n * numeric_limits<typename A::SumType>::epsilon() * magnitude;
+            ok = ok && (benchSameValue(vectorSum, sum) || fabsl((long double)vectorSum - (long double)sum) <= bound) &&
+                 array.count(probe) == count && array.find(probe) == position;
+            ok = ok && (n == 0 || (array.minMaxIndex() == extremes && benchSameValue(array.min(), low) &&
+                                   benchSameValue(array.max(), high)));
+        }
+    }
+    A::setSimdLevel(detected);
+    return ok;
+}
+
+template <typename A>
+size_t benchArrayScan(const char* name, size_t n, typename A::SimdLevel level) {
+    const int rounds = 20;
+    // Check on the first call for a level, which is the untimed warmup
+    static bool checked[A::SIMD_AVX512 + 1] = {};
+    if (!checked[level]) {
+        checked[level] = true;
+        benchCheck(benchArrayScansMatch<A>(level), name, "vector scans differ from the plain loops");
+    }
+    
+    A array;
+    array.reserve((int)n);
+    for (size_t i = 0; i < n; i++) {
+        array.pushBack((typename A::ValueType)(i * 2654435761u % 100000));
+    }
+    
+    typename A::SimdLevel detected = A::simdLevel();
+    A::setSimdLevel(level);
+    for (int round = 0; round < rounds && n > 0; round++) {
+        pair<int, int> extremes = array.minMaxIndex();
+        benchSink += (double)array.sum() + (double)array.min() + (double)array.max() + extremes.first + extremes.second +
+                     array.count((typename A::ValueType)round) + array.find((typename A::ValueType)-1);
+    }
+    A::setSimdLevel(detected);
+    return (size_t)rounds * 6 * n;
+}
+
+// Transform, sort, reduce and prefix-sum n elements; values stay below 7 so
+// the sums cannot overflow
+template <typename A>
+size_t benchArrayParallel(const char* name, size_t n, int grain) {
+    typedef typename A::ValueType T;
+    int savedGrain = A::parallelGrain();
+    A::setParallelGrain(grain);
+    A array;
+    array.reserve((int)n);
+    for (size_t i = 0; i < n; i++) {
+        array.pushBack((T)(i * 2654435761u % 1000));
+    }
+    
+    array.parallelTransform([](T x) { return (T)((long long)x % 7); });
+    array.parallelSort();
+    T total = array.parallelReduce(T(), [](T x, T y) { return x + y; });
+    array.parallelPrefixSum();
+
+    // After the prefix sum the array must still be sorted (values are not
+    // negative) and end with the reduced total
+    bool sorted = true;
+    for (size_t i = 1; i < n; i++) {
+        sorted = sorted && !(array.get((int)i) < array.get((int)i - 1));
+    }
+    benchCheck(sorted && (n == 0 || array.get((int)n - 1) == total), name, "parallel results differ from the sequential ones");
+    benchSink += (double)total;
+    A::setParallelGrain(savedGrain);
+    return 4 * n;
+}
+)";
+static const char* BENCH_ARRAY_SCAN_VECTOR = "return benchArrayScan<C>(name, n, C::simdLevel());";
+static const char* BENCH_ARRAY_SCAN_SCALAR = "return benchArrayScan<C>(name, n, C::SIMD_SCALAR);";
+static const char* BENCH_ARRAY_PARALLEL = "return benchArrayParallel<C>(name, n, C::parallelGrain());";
+static const char* BENCH_ARRAY_SEQUENTIAL = "return benchArrayParallel<C>(name, n, (int)n + 1);";
+
+// Fork-join driver shared by the work-stealing workloads, and the locked
+// deque they are compared with
+static const char* BENCH_FORK_JOIN = R"(
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+// Reference for the work-stealing benchmark: a std::deque behind one mutex
+template <typename T>
+class BenchLockedDeque {
+public:
+    typedef T ValueType;
+    
+    void insertRear(const T& value) {
+        lock_guard<mutex> guard(lock);
+        items.push_back(value);
+    }
+    
+    bool tryDeleteRear(T& value) {
+        lock_guard<mutex> guard(lock);
+        if (items.empty()) {
+            return false;
+        }
+        value = items.back();
+        items.pop_back();
+        return true;
+    }
+    
+    bool trySteal(T& value) {
+        lock_guard<mutex> guard(lock);
+        if (items.empty()) {
+            return false;
+        }
+        value = items.front();
+        items.pop_front();
+        return true;
+    }
+    
+private:
+    mutex lock;
+    deque<T> items;
+};
+
+// Run tasks on `threads` workers that each own a D (insertRear, tryDeleteRear,
+// trySteal), starting with root on the first; idle workers steal from random
+// victims. run(task, spawn) runs one task, may call spawn(task) to push more on
+// its worker's deque, and returns a value summed over all tasks. Returns how
+// many tasks ran and that sum.
+template <typename D, typename Run>
+pair<size_t, uint64_t> benchForkJoin(unsigned threads, typename D::ValueType root, const Run& run) {
+    typedef typename D::ValueType T;
+    unique_ptr<D[]> deques(new D[threads]);
+    atomic<int64_t> pending(1);
+    atomic<uint64_t> total(0);
+    atomic<size_t> ran(0);
+    deques[0].insertRear(root);
+    auto worker = [&](unsigned id) {
+        benchPinThread(id);
+        D& own = deques[id];
+        uint32_t seed = id * 2654435761u + 1;
+        uint64_t sum = 0;
+        size_t count = 0;
+        auto spawn = [&](T task) {
+            pending.fetch_add(1, memory_order_relaxed);
+            own.insertRear(task);
+        };
+        T task;
+        while (pending.load(memory_order_acquire) > 0) {
+            if (!own.tryDeleteRear(task)) {
+                seed = seed * 1664525u + 1013904223u;
+                unsigned victim = (seed >> 8) % threads;
+                if (victim == id || !deques[victim].trySteal(task)) {
+                    this_thread::yield();
+                    continue;
+                }
+            }
+            sum += run(task, spawn);
+            count++;
+            pending.fetch_sub(1, memory_order_release);
+        }
+        total += sum;
+        ran += count;
+    };
+    vector<thread> workers;
+    for (unsigned id = 0; id < threads; id++) {
+        workers.emplace_back(worker, id);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    return make_pair(ran.load(), total.load());
+}
+
+uint64_t benchFib(unsigned k) {
+    return k < 2 ? k : benchFib(k - 1) + benchFib(k - 2);
+}
+
+// Parallel Fibonacci. A task is a fib argument: a worker splits it down to the
+// cutoff, pushing the k - 2 halves, and computes the rest sequentially. Every
+// task is about the same size. Runs about n tasks and returns how many ran.
+template <typename D>
+size_t benchForkJoinFib(const char* name, unsigned threads, size_t n) {
+    typedef typename D::ValueType T;
+    const unsigned cutoff = 12;
+    
+    // Smallest k whose task tree has n tasks: tasks(k) = tasks(k - 1) + tasks(k - 2)
+    // from the cutoff on, and 1 below it
+    unsigned k = cutoff;
+    uint64_t tasks = 2;
+    for (uint64_t previous = 1; tasks < n && k < 90; k++) {
+        uint64_t next = tasks + previous;
+        previous = tasks;
+        tasks = next;
+    }
+    
+    pair<size_t, uint64_t> result = benchForkJoin<D>(threads, (T)k, [&](T task, auto& spawn) {
+        unsigned arg = (unsigned)task;
+        for (; arg >= cutoff; arg--) {
+            spawn((T)(arg - 2));
+        }
+        return benchFib(arg);
+    });
+    
+    uint64_t expected = 0;
+    for (uint64_t a = 0, b = 1, i = 0; i <= k; i++) {
+        expected = a;
+        b += a;
+        a = b - a;
+    }
+    benchCheck(result.second == expected && result.first == tasks, name, "fork-join tasks were lost or run twice");
+    return result.first;
+}
+
+// Parallel quicksort of n integers. A task is an index into a table of
+// subranges, as ValueType cannot hold a range itself. A worker partitions its
+// range three ways around a median of three, pushes the smaller side when it
+// is above the cutoff and keeps the larger, and sorts what is left with
+// std::sort. Pivots split unevenly, so task sizes vary, unlike fib's. Returns
+// n, the number of elements sorted.
+template <typename D>
+size_t benchForkJoinQuicksort(const char* name, unsigned threads, size_t n) {
+    typedef typename D::ValueType T;
+    typedef pair<size_t, size_t> Range;
+    
+    // A pushed range is the smaller side of a split, so there are fewer than n /
+    // cutoff of them; the cutoff grows for narrow ValueTypes so every table
+    // index fits
+    double exact = numeric_limits<T>::is_integer ? (double)numeric_limits<T>::max()
+                                                 : ldexp(1.0, numeric_limits<T>::digits);
+    size_t cutoff = max((size_t)2048, (size_t)((double)n / max(exact - 1, 1.0)) + 1);
+    unique_ptr<Range[]> ranges(new Range[n / cutoff + 1]);
+    atomic<size_t> rangeCount(1);
+    ranges[0] = Range(0, n);
+    
+    vector<uint32_t> values(n);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        values[i] = (uint32_t)(i * 2654435761u % (n + 1));
+        sum += values[i];
+    }
+    
+    // Each task returns how many elements it put in their final place
+    pair<size_t, uint64_t> result = benchForkJoin<D>(threads, (T)0, [&](T task, auto& spawn) {
+        Range range = ranges[(size_t)task];
+        uint32_t* lo = values.data() + range.first;
+        uint32_t* hi = values.data() + range.second;
+        uint64_t placed = 0;
+        while ((size_t)(hi - lo) > cutoff) {
+            uint32_t a = lo[0], b = lo[(hi - lo) / 2], c = hi[-1];
+            uint32_t pivot = max(min(a, b), min(max(a, b), c));
+            uint32_t* equal = partition(lo, hi, [pivot](uint32_t x) { return x < pivot; });
+            uint32_t* greater = partition(equal, hi, [pivot](uint32_t x) { return x == pivot; });
+            placed += greater - equal;
+            bool leftSmaller = equal - lo < hi - greater;
+            uint32_t* smallLo = leftSmaller ? lo : greater;
+            uint32_t* smallHi = leftSmaller ? equal : hi;
+            if ((size_t)(smallHi - smallLo) > cutoff) {
+                size_t index = rangeCount.fetch_add(1, memory_order_relaxed);
+                ranges[index] = Range(smallLo - values.data(), smallHi - values.data());
+                spawn((T)index);
+            } else {
+                sort(smallLo, smallHi);
+                placed += smallHi - smallLo;
+            }
+            if (leftSmaller) {
+                lo = greater;
+            } else {
+                hi = equal;
+            }
+        }
+        sort(lo, hi);
+        return placed + (hi - lo);
+    });
+    
+    bool sorted = is_sorted(values.begin(), values.end());
+    for (size_t i = 0; i < n; i++) {
+        sum -= values[i];
+    }
+    benchCheck(sorted && sum == 0 && result.second == n && result.first == rangeCount, name,
+               "quicksort lost, duplicated or misordered elements");
+    return n;
+}
+)";
+
+// Parallel fib and quicksort on the generated work-stealing deque, and on a locked deque
+static const char* BENCH_DEQUE_FIB = "return benchForkJoinFib<C>(name, threads, n);";
+static const char* BENCH_DEQUE_FIB_LOCKED = "return benchForkJoinFib<BenchLockedDeque<C::ValueType>>(name, threads, n);";
+static const char* BENCH_DEQUE_QUICKSORT = "return benchForkJoinQuicksort<C>(name, threads, n);";
+static const char* BENCH_DEQUE_QUICKSORT_LOCKED =
+    "return benchForkJoinQuicksort<BenchLockedDeque<C::ValueType>>(name, threads, n);";
+
+/**
+ * Generate a benchmark main() that times insert, lookup, remove and mixed
+ * workloads with uniform and Zipf keys for every selected structure
+ */
+void generateBenchmarkCode(ostream& out_file, const vector<string>& selectedDS,
+                           const vector<DataStructureInfo>& dataStructures) {
+    // Linked lists search linearly, so their size is capped to keep lookups O(4096)
+    static const vector<BenchOperations> operations = {
+        {"stack", "s.push((C::ValueType)key);", "benchSink += s.top();", "benchSink += s.pop();", 0},
+        {"stack_concurrent", "s.push((C::ValueType)key);", "benchSink += s.top();", "benchSink += s.pop();", 0,
+         {{"pushpop", BENCH_STACK_PUSHPOP, 0}}},
+        {"queue", "s.enqueue((C::ValueType)key);", "benchSink += s.front();", "benchSink += s.dequeue();", 0},
+        {"queue_spsc", "s.enqueue((C::ValueType)key);", "benchSink += s.front();", "benchSink += s.dequeue();", 0,
+         {{"transfer", BENCH_QUEUE_TRANSFER, 2}}},
+        {"queue_mpmc", "s.enqueue((C::ValueType)key);", "benchSink += s.front();", "benchSink += s.dequeue();", 0,
+         {{"fanio", BENCH_QUEUE_FANIO, 0}}},
+        {"queue_blocking", "if (!s.tryEnqueue((C::ValueType)key)) { throw overflow_error(\"Queue Overflow\"); }",
+         "benchSink += s.front();", "benchSink += s.dequeue();", 0, {{"handoff", BENCH_QUEUE_BLOCKING, 0}}},
+        {"queue_channel", "s.enqueue((C::ValueType)key);", "benchSink += s.front();", "benchSink += s.dequeue();", 0,
+         {{"coroutines", BENCH_QUEUE_COROUTINES, 1}}},
+        {"deque", "s.insertRear((C::ValueType)key);", "benchSink += s.getFront();", "benchSink += s.deleteFront();", 0},
+        {"deque_segmented", "s.insertRear((C::ValueType)key);", "benchSink += s[index];", "benchSink += s.deleteFront();", 0},
+        {"deque_workstealing", "s.insertRear((C::ValueType)key);", "benchSink += s.getRear();", "benchSink += s.deleteRear();", 0,
+         {{"fib", BENCH_DEQUE_FIB, 0}, {"fib_locked", BENCH_DEQUE_FIB_LOCKED, 0},
+          {"quicksort", BENCH_DEQUE_QUICKSORT, 0}, {"quicksort_locked", BENCH_DEQUE_QUICKSORT_LOCKED, 0}},
+         BENCH_FORK_JOIN},
+        {"slidingwindow", "s.push(s.isEmpty() ? 0 : s.newestTimestamp() + 1, (C::ValueType)key);",
+         "benchSink += s.windowMin() + s.windowMax();", "s.expireBefore(s.oldestTimestamp() + 1);", 0},
+        {"array", "s.pushBack((C::ValueType)key);", "benchSink += s.get((int)index);", "s.popBack();", 0,
+         {{"shortlived", BENCH_ARRAY_SHORTLIVED, 1}, {"scan", BENCH_ARRAY_SCAN_VECTOR, 1},
+          {"scan_scalar", BENCH_ARRAY_SCAN_SCALAR, 1}, {"parallel", BENCH_ARRAY_PARALLEL, 1},
+          {"sequential", BENCH_ARRAY_SEQUENTIAL, 1}}, BENCH_ARRAY_ALGORITHMS},
+        {"linkedlist", "s.insertAtBeginning((C::ValueType)key);", "benchSink += s.search((C::ValueType)key);",
+         "benchSink += s.deleteNode((C::ValueType)key);", 4096},
+        {"doublylinkedlist", "s.insertAtBeginning((C::ValueType)key);", "benchSink += s.search((C::ValueType)key);",
+         "benchSink += s.deleteNode((C::ValueType)key);", 4096},
+        {"circularlist", "s.insertAtBeginning((C::ValueType)key);", "benchSink += s.search((C::ValueType)key);",
+         "benchSink += s.deleteNode((C::ValueType)key);", 4096},
+        {"bst", "s.insert((C::ValueType)key);", "benchSink += s.search((C::ValueType)key);",
+         "benchSink += s.remove((C::ValueType)key);", 0},
+        {"heap", "s.insert((C::ValueType)key);", "benchSink += s.getMin();", "benchSink += s.extractMin();", 0},
+        {"hashtable", "s.insert((C::KeyType)key, (C::ValueType)key);",
+         "C::ValueType value; if (s.get((C::KeyType)key, value)) { benchSink += value; }",
+         "benchSink += s.remove((C::KeyType)key);", 0}
+    };
+    
+    // Operation code with the class name filled in for the C in "C::", "C s;", "C s(", "C& " and "<C>"
+    auto substitute = [](const string& className, string code) {
+        for (const string token : {"C::", "C s;", "C s(", "C& ", "<C>"}) {
+            size_t at = token.find('C');
+            for (size_t pos = code.find(token); pos != string::npos; pos = code.find(token, pos + className.size())) {
+                code.replace(pos + at, 1, className);
+            }
+        }
+        return code;
+    };
+    
+    // Lambda over one operation, naming only the parameters its body uses
+    auto lambda = [&](const string& className, const string& body, bool withIndex) {
+        string code = substitute(className, body);
+        string result = "[](" + className + "& s, uint64_t" + (code.find("key") != string::npos ? " key" : "");
+        if (withIndex) {
+            result += string(", size_t") + (code.find("index") != string::npos ? " index" : "");
+        }
+        return result + ") { " + code + " }";
+    };
+    
+    // Operations for a spec: its variant's entry, else the structure's
+    auto operationsFor = [&](const string& spec) -> const BenchOperations* {
+        const BenchOperations* found = nullptr;
+        for (const auto& entry : operations) {
+            if (entry.name == snippetName(spec, dataStructures) || (!found && entry.name == specName(spec))) {
+                found = &entry;
+            }
+        }
+        return found && hasNumericTypes(parseSpec(spec)) ? found : nullptr;
+    };
+    
+    // Specs with options contain commas, so quote them for CSV
+    auto csvLabel = [](const string& spec) {
+        return spec.find(',') != string::npos ? "\\\"" + spec + "\\\"" : spec;
+    };
+    
+    out_file << BENCH_SUPPORT;
+    set<string> supportWritten;
+    for (const auto& spec : selectedDS) {
+        const BenchOperations* ops = operationsFor(spec);
+        if (ops && !ops->support.empty() && supportWritten.insert(ops->support).second) {
+            out_file << ops->support;
+        }
+    }
+    out_file << BENCH_MAIN;
+    for (const auto& spec : selectedDS) {
+        string ds = specName(spec);
+        string className = getClassName(ds, dataStructures);
+        const BenchOperations* ops = operationsFor(spec);
+        
+        out_file << "        \n";
+        out_file << "        // " << spec << "\n";
+        if (!ops) {
+            out_file << "        // " << className << " has no numeric keys to benchmark with; add a workload here\n";
+            continue;
+        }
+        
+        string label = csvLabel(spec);
+        string size = ops->maxSize ? "min(n, (size_t)" + to_string(ops->maxSize) + ")" : "n";
+        out_file << "        {\n";
+        out_file << "            size_t size = " << size << ";\n";
+        out_file << "            vector<uint64_t> keys = benchKeys(size + n, 2 * size, zipf);\n";
+        out_file << "            auto insert = " << lambda(className, ops->insert, false) << ";\n";
+        out_file << "            auto lookup = " << lambda(className, ops->lookup, true) << ";\n";
+        out_file << "            auto remove = " << lambda(className, ops->remove, false) << ";\n";
+        out_file << "            benchStructure<" << className << ">(\"" << label << "\", dist, keys, size / 10 + 1, n / 10 + 1, false,\n";
+        out_file << "                " << string(className.size(), ' ') << "insert, lookup, remove);  // warmup\n";
+        out_file << "            benchStructure<" << className << ">(\"" << label << "\", dist, keys, size, n, true,\n";
+        out_file << "                " << string(className.size(), ' ') << "insert, lookup, remove);\n";
+        out_file << "        }\n";
+    }
+    out_file << "    }\n";
+    
+    // Extra workloads: stress and throughput from 1 to N threads for thread-safe
+    // structures, and structure-specific runs
+    for (const auto& spec : selectedDS) {
+        const BenchOperations* ops = operationsFor(spec);
+        if (!ops) {
+            continue;
+        }
+        for (const auto& workload : ops->scaling) {
+            out_file << "    \n";
+            if (workload.threads) {
+                out_file << "    // " << spec << " with " << workload.threads
+                         << (workload.threads == 1 ? " thread\n" : " threads\n");
+            } else {
+                out_file << "    // " << spec << " with 1 to hardware_concurrency() threads\n";
+            }
+            out_file << "    {\n";
+            out_file << "        const char* name = \"" << csvLabel(spec) << "\";\n";
+            out_file << "        benchScaling(name, \"" << workload.name << "\", " << workload.threads
+                     << ", [&](unsigned" << (workload.body.find("threads") != string::npos ? " threads" : "") << ") -> size_t {\n";
+            istringstream body(substitute(getClassName(specName(spec), dataStructures), workload.body));
+            string line;
+            while (getline(body, line)) {
+                out_file << (line.empty() ? "" : "            " + line) << "\n";
+            }
+            out_file << "        });\n";
+            out_file << "    }\n";
+        }
+    }
+    out_file << "    \n";
+    out_file << "    // Print the sink so the compiler cannot drop the lookups\n";
+    out_file << "    cerr << \"checksum: \" << benchSink << endl;\n";
+    out_file << "    return benchFailed ? 1 : 0;\n";
+    out_file << "}\n";
+}
+
 /**
  * Extract program name from path
  */
@@ -506,6 +2878,10 @@ string getProgramName(char* programPath) {
  * Get current date and time as formatted string
  */
 string getFormattedDateTime() {
+    // localtime() shares one buffer; manifest workers call this concurrently
+    static mutex timeMutex;
+    lock_guard<mutex> lock(timeMutex);
+    
     time_t now = time(0);
     tm* ltm = localtime(&now);
     
@@ -526,8 +2902,30 @@ void printSuccess(const string& output_file, int count) {
     cout << endl << COLOR_GREEN << COLOR_BOLD << "SUCCESS!" << COLOR_RESET << COLOR_GREEN << endl;
     cout << "+-----------------------------------------------------+" << endl;
     cout << "| " << setw(51) << left << "Output file generated:" << "|" << endl;
-    cout << "| " << setw(51) << output_file << "|" << endl;
+    cout << "| " << setw(51) << (output_file == "-" ? "<stdout>" : output_file) << "|" << endl;
     cout << "+-----------------------------------------------------+" << endl;
     cout << "| " << setw(51) << left << "Data structures included: " + to_string(count) << "|" << endl;
     cout << "+-----------------------------------------------------+" << COLOR_RESET << endl;
-}
\ No newline at end of file
+}
+
+/**
+ * Report per-phase wall time and byte counts as JSON on stderr (--timings)
+ */
+void printTimings(const GenerationStats& stats) {
+    if (!stats.timingsEnabled) {
+        return;
+    }
+    
+    ostringstream json;
+    json << fixed << setprecision(3);
+    json << "{\"phases\": [";
+    double total = 0;
+    for (size_t i = 0; i < stats.phases.size(); i++) {
+        const auto& entry = stats.phases[i];
+        json << (i ? ", " : "") << "{\"phase\": \"" << entry.phase << "\", \"wall_ms\": " << entry.wallMs
+             << ", \"bytes\": " << entry.bytes << ", \"count\": " << entry.count << "}";
+        total += entry.wallMs;
+    }
+    json << "], \"sum_ms\": " << total << "}";
+    cerr << json.str() << endl;
+}
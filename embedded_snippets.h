@@ -0,0 +1,7685 @@
+/**
+ * Embedded snippet library for DSLord
+ *
+ * GENERATED FILE - do not edit by hand. Edit the files in snippets/ and run:
+ *   dslord --embed-snippets embedded_snippets.h
+ */
+
+#ifndef DSLORD_EMBEDDED_SNIPPETS_H
+#define DSLORD_EMBEDDED_SNIPPETS_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct EmbeddedSnippet {
+    const char* name;
+    const char* content;
+    size_t length;
+    uint64_t hash;          // FNV-1a of content and includes, used for cache keys
+    const char* includes;   // #include lines stripped from the snippet
+};
+
+static const EmbeddedSnippet EMBEDDED_SNIPPETS[] = {
+    {"stack",
+R"DSLORD(/**
+ * Stack - A Last-In-First-Out (LIFO) data structure implementation
+ * Operations:
+ * - push: Add an element to the top of the stack
+ * - pop: Remove the top element from the stack
+ * - top: Get the top element without removing it
+ * - isEmpty: Check if the stack is empty
+ * - size: Get the number of elements in the stack
+ */
+class Stack {
+public:
+    // Element type (dslord: -stack:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity (dslord: -stack:capacity=<n>). When GROWABLE is set it is only the
+    // initial capacity and the storage doubles when full (dslord: -stack:growable)
+    static const int MAX_SIZE = 1000;
+    static const bool GROWABLE = false;
+    ValueType* data;
+    int dataCapacity;
+    int stackTop;
+    // Move the elements into storage twice as large; throws overflow_error
+    // when that many elements no longer fit in an int
+    void grow() {
+        if (dataCapacity > INT_MAX / 2) {
+            throw overflow_error("Stack Overflow");
+        }
+        ValueType* newData = new ValueType[dataCapacity * 2];
+        for (int i = 0; i <= stackTop; i++) {
+            newData[i] = data[i];
+        }
+        delete[] data;
+        data = newData;
+        dataCapacity *= 2;
+    }
+public:
+    // Constructor
+    Stack() : data(new ValueType[MAX_SIZE]), dataCapacity(MAX_SIZE) {
+        stackTop = -1;
+    }
+    // Destructor
+    ~Stack() {
+        delete[] data;
+    }
+    // Copy constructor
+    Stack(const Stack& other) : data(new ValueType[other.dataCapacity]), dataCapacity(other.dataCapacity) {
+        stackTop = other.stackTop;
+        for (int i = 0; i <= stackTop; i++) {
+            data[i] = other.data[i];
+        }
+    }
+    // Assignment operator
+    Stack& operator=(const Stack& other) {
+        if (this != &other) {
+            Stack copy(other);
+            swap(data, copy.data);
+            swap(dataCapacity, copy.dataCapacity);
+            swap(stackTop, copy.stackTop);
+        }
+        return *this;
+    }
+    // Add an element to the top of the stack
+    void push(const ValueType& value) {
+        if (stackTop >= dataCapacity - 1) {
+            if (!GROWABLE) {
+                throw overflow_error("Stack Overflow");
+            }
+            grow();
+        }
+        data[++stackTop] = value;
+    }
+    // Remove and return the top element from the stack
+    ValueType pop() {
+        if (isEmpty()) {
+            throw underflow_error("Stack Underflow");
+        }
+        return data[stackTop--];
+    }
+    // Get the top element without removing it
+    ValueType top() const {
+        if (isEmpty()) {
+            throw underflow_error("Stack is empty");
+        }
+        return data[stackTop];
+    }
+    // Check if the stack is empty
+    bool isEmpty() const {
+        return stackTop < 0;
+    }
+    // Get the number of elements in the stack
+    int size() const {
+        return stackTop + 1;
+    }
+    // Display all elements in the stack (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Stack is empty" << endl;
+            return;
+        }
+        
+        cout << "Stack elements: ";
+        for (int i = stackTop; i >= 0; i--) {
+            cout << data[i] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 3239, 0xe420d2b49e8296efULL,
+    "#include <climits>\n#include <iostream>\n"},
+    {"stack_concurrent",
+R"DSLORD(/**
+ * Stack - A lock-free Last-In-First-Out (LIFO) stack that any number of threads
+ * can push to and pop from at once (dslord: -stack:concurrent). It is a Treiber
+ * stack: the top is a single word updated with compare-and-swap.
+ *
+ * The top is a tagged word (32-bit tag, 32-bit node reference) and the tag
+ * changes on every update, so a thread holding a stale top always fails its
+ * CAS instead of hitting ABA. Popped nodes are recycled through a second
+ * tagged free list and their memory is only released by the destructor, so
+ * reading a node another thread has just popped is never a use-after-free.
+ * Under contention a failed push or pop tries an elimination slot, where a
+ * push hands its node straight to a pop without touching the top.
+ * Operations:
+ * - push: Add an element to the top of the stack
+ * - pop: Remove the top element from the stack (throws when empty)
+ * - tryPop: Remove the top element if there is one
+ * - top: Get the top element without removing it
+ * - isEmpty: Check if the stack is empty
+ * - size: Get the number of elements in the stack
+ */
+class Stack {
+public:
+    // Element type (dslord: -stack:T=<type>)
+    typedef int ValueType;
+private:
+    // Node storage: block b holds FIRST_BLOCK_SIZE << b nodes and is never
+    // moved or freed while the stack exists
+    static const int FIRST_BLOCK_BITS = 6;
+    static const uint32_t FIRST_BLOCK_SIZE = 1u << FIRST_BLOCK_BITS;
+    static const int MAX_BLOCKS = 32 - FIRST_BLOCK_BITS;
+    static const uint32_t MAX_NODES = 0xFFFFFFFFu - FIRST_BLOCK_SIZE;
+    // Elimination slots tried after a failed CAS, and how long a push waits there
+    static const int ELIMINATION_SLOTS = 8;
+    static const int ELIMINATION_SPINS = 128;
+    struct Node {
+        ValueType value;
+        atomic<uint32_t> next;  // reference of the node below, 0 at the bottom
+    };
+    // Tagged words hold the tag in the high 32 bits and a node reference
+    // (1-based index, 0 for none) in the low 32 bits
+    static uint32_t refOf(uint64_t word) {
+        return (uint32_t)word;
+    }
+    // The word that replaces `word`: next tag, new reference
+    static uint64_t retag(uint64_t word, uint32_t ref) {
+        return (((word >> 32) + 1) << 32) | ref;
+    }
+    atomic<uint64_t> head;        // top of the stack
+    atomic<uint64_t> freeHead;    // recycled nodes
+    atomic<uint32_t> freshNodes;  // references handed out so far
+    atomic<int> count;
+    atomic<Node*> blocks[MAX_BLOCKS];
+    atomic<uint64_t> elimination[ELIMINATION_SLOTS];
+    static int highestBit(uint32_t x) {
+#if defined(__GNUC__)
+        return 31 - __builtin_clz(x);
+#else
+        int bit = 0;
+        while (x >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+    Node& nodeAt(uint32_t ref) const {
+        uint32_t position = ref - 1 + FIRST_BLOCK_SIZE;
+        int bit = highestBit(position);
+        return blocks[bit - FIRST_BLOCK_BITS].load(memory_order_acquire)[position - (1u << bit)];
+    }
+    // Take a recycled node, or a fresh one (allocating its block on first use)
+    uint32_t allocateNode() {
+        uint32_t ref = popNode(freeHead, false);
+        if (ref) {
+            return ref;
+        }
+        ref = freshNodes.fetch_add(1, memory_order_relaxed) + 1;
+        if (ref > MAX_NODES) {
+            throw overflow_error("Stack Overflow");
+        }
+        int bit = highestBit(ref - 1 + FIRST_BLOCK_SIZE);
+        atomic<Node*>& block = blocks[bit - FIRST_BLOCK_BITS];
+        if (!block.load(memory_order_acquire)) {
+            Node* nodes = new Node[size_t(1) << bit];
+            Node* expected = nullptr;
+            if (!block.compare_exchange_strong(expected, nodes, memory_order_acq_rel)) {
+                delete[] nodes;  // another thread allocated it first
+            }
+        }
+        return ref;
+    }
+    void releaseNode(uint32_t ref) {
+        pushNode(freeHead, ref, false);
+    }
+    void pushNode(atomic<uint64_t>& list, uint32_t ref, bool eliminate) {
+        Node& node = nodeAt(ref);
+        uint64_t top = list.load(memory_order_relaxed);
+        while (true) {
+            node.next.store(refOf(top), memory_order_relaxed);
+            if (list.compare_exchange_weak(top, retag(top, ref), memory_order_acq_rel, memory_order_relaxed)) {
+                return;
+            }
+            if (eliminate && eliminatePush(ref)) {
+                return;
+            }
+            top = list.load(memory_order_relaxed);
+        }
+    }
+    // Returns the popped node's reference, or 0 when the list is empty
+    uint32_t popNode(atomic<uint64_t>& list, bool eliminate) {
+        uint64_t top = list.load(memory_order_acquire);
+        while (uint32_t ref = refOf(top)) {
+            // The node may be popped and reused meanwhile; the tag makes the CAS fail then
+            uint32_t below = nodeAt(ref).next.load(memory_order_relaxed);
+            if (list.compare_exchange_weak(top, retag(top, below), memory_order_acq_rel, memory_order_acquire)) {
+                return ref;
+            }
+            if (eliminate && (ref = eliminatePop())) {
+                return ref;
+            }
+            top = list.load(memory_order_acquire);
+        }
+        return 0;
+    }
+    // Pseudo-random elimination slot (xorshift, one state per thread)
+    atomic<uint64_t>& randomSlot() {
+        static thread_local uint32_t state = (uint32_t)hash<thread::id>()(this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return elimination[state % ELIMINATION_SLOTS];
+    }
+    // Offer a node to a concurrent pop; true when one took it
+    bool eliminatePush(uint32_t ref) {
+        atomic<uint64_t>& slot = randomSlot();
+        uint64_t empty = slot.load(memory_order_relaxed);
+        if (refOf(empty)) {
+            return false;
+        }
+        uint64_t offer = retag(empty, ref);
+        if (!slot.compare_exchange_strong(empty, offer, memory_order_acq_rel)) {
+            return false;
+        }
+        for (int i = 0; i < ELIMINATION_SPINS; i++) {
+            if (slot.load(memory_order_acquire) != offer) {
+                return true;
+            }
+        }
+        // Withdraw the offer; failing means a pop took it after all
+        return !slot.compare_exchange_strong(offer, retag(offer, 0), memory_order_acq_rel);
+    }
+    // Take a node offered by a concurrent push, or 0
+    uint32_t eliminatePop() {
+        atomic<uint64_t>& slot = randomSlot();
+        uint64_t offer = slot.load(memory_order_acquire);
+        uint32_t ref = refOf(offer);
+        if (ref && slot.compare_exchange_strong(offer, retag(offer, 0), memory_order_acq_rel)) {
+            return ref;
+        }
+        return 0;
+    }
+public:
+    // Constructor
+    Stack() : head(0), freeHead(0), freshNodes(0), count(0) {
+        for (int i = 0; i < MAX_BLOCKS; i++) {
+            blocks[i].store(nullptr, memory_order_relaxed);
+        }
+        for (int i = 0; i < ELIMINATION_SLOTS; i++) {
+            elimination[i].store(0, memory_order_relaxed);
+        }
+    }
+    // Destructor (no other thread may still be using the stack)
+    ~Stack() {
+        for (int i = 0; i < MAX_BLOCKS; i++) {
+            delete[] blocks[i].load(memory_order_relaxed);
+        }
+    }
+    // Threads share one stack, so it cannot be copied
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+    // Add an element to the top of the stack
+    void push(const ValueType& value) {
+        uint32_t ref = allocateNode();
+        nodeAt(ref).value = value;
+        pushNode(head, ref, true);
+        count.fetch_add(1, memory_order_relaxed);
+    }
+    // Remove the top element into `value`; false when the stack is empty
+    bool tryPop(ValueType& value) {
+        uint32_t ref = popNode(head, true);
+        if (!ref) {
+            return false;
+        }
+        count.fetch_sub(1, memory_order_relaxed);
+        value = nodeAt(ref).value;
+        releaseNode(ref);
+        return true;
+    }
+    // Remove and return the top element from the stack
+    ValueType pop() {
+        ValueType value;
+        if (!tryPop(value)) {
+            throw underflow_error("Stack Underflow");
+        }
+)DSLORD"
+R"DSLORD(        return value;
+    }
+    // Get the top element without removing it (only stable while no other thread pops)
+    ValueType top() const {
+        uint32_t ref = refOf(head.load(memory_order_acquire));
+        if (!ref) {
+            throw underflow_error("Stack is empty");
+        }
+        return nodeAt(ref).value;
+    }
+    // Check if the stack is empty
+    bool isEmpty() const {
+        return refOf(head.load(memory_order_acquire)) == 0;
+    }
+    // Get the number of elements in the stack (a snapshot under concurrent use)
+    int size() const {
+        return max(0, count.load(memory_order_relaxed));
+    }
+    // Display all elements in the stack (for debugging, while no other thread pops)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Stack is empty" << endl;
+            return;
+        }
+        cout << "Stack elements: ";
+        for (uint32_t ref = refOf(head.load(memory_order_acquire)); ref; ref = nodeAt(ref).next.load(memory_order_relaxed)) {
+            cout << nodeAt(ref).value << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 9258, 0x9534915fae7868ccULL,
+    "#include <atomic>\n#include <cstdint>\n#include <functional>\n#include <iostream>\n#include <thread>\n"},
+    {"stack_segmented",
+R"DSLORD(/**
+ * Stack - A Last-In-First-Out (LIFO) data structure implementation backed by
+ * linked fixed-size chunks (dslord: -stack:segmented). Growing allocates a new
+ * chunk and never moves existing elements, so push and pop are O(1) worst case.
+ * One emptied chunk is kept as a spare so pushing and popping across a chunk
+ * boundary does not allocate every time.
+ * Operations:
+ * - push: Add an element to the top of the stack
+ * - pop: Remove the top element from the stack
+ * - top: Get the top element without removing it
+ * - isEmpty: Check if the stack is empty
+ * - size: Get the number of elements in the stack
+ * - reserve: Allocate chunks up front for a number of elements
+ * - shrinkToFit: Release every chunk not holding elements
+ * - capacity: Get the number of elements the allocated chunks can hold
+ */
+class Stack {
+public:
+    // Element type (dslord: -stack:T=<type>)
+    typedef int ValueType;
+private:
+    // Elements per chunk
+    static const int CHUNK_SIZE = 1024;
+    struct Chunk {
+        ValueType data[CHUNK_SIZE];
+        Chunk* below;
+    };
+    Chunk* topChunk;     // chunk holding the top element, nullptr when empty
+    int topUsed;         // elements in topChunk
+    int usedChunks;
+    Chunk* freeChunks;   // empty chunks kept for reuse, linked through `below`
+    int freeCount;
+    int reservedChunks;  // chunks requested by reserve()
+    int count;
+    // Make a new top chunk, reusing a free one when there is one
+    void pushChunk() {
+        Chunk* chunk = freeChunks;
+        if (chunk) {
+            freeChunks = chunk->below;
+            freeCount--;
+        } else {
+            chunk = new Chunk;
+        }
+        chunk->below = topChunk;
+        topChunk = chunk;
+        topUsed = 0;
+        usedChunks++;
+    }
+    // Retire the emptied top chunk. It stays allocated while that keeps at most
+    // one spare beyond what reserve() asked for; otherwise it is freed.
+    void popChunk() {
+        Chunk* chunk = topChunk;
+        topChunk = chunk->below;
+        topUsed = topChunk ? CHUNK_SIZE : 0;
+        usedChunks--;
+        if (usedChunks + freeCount < max(reservedChunks, usedChunks + 1)) {
+            chunk->below = freeChunks;
+            freeChunks = chunk;
+            freeCount++;
+        } else {
+            delete chunk;
+        }
+    }
+    // Free a chain of chunks
+    static void freeChain(Chunk* chunk) {
+        while (chunk) {
+            Chunk* below = chunk->below;
+            delete chunk;
+            chunk = below;
+        }
+    }
+public:
+    // Constructor
+    Stack() : topChunk(nullptr), topUsed(0), usedChunks(0), freeChunks(nullptr),
+              freeCount(0), reservedChunks(0), count(0) {}
+    // Destructor
+    ~Stack() {
+        freeChain(topChunk);
+        freeChain(freeChunks);
+    }
+    // Copy constructor (copies the elements, not the spare chunks)
+    Stack(const Stack& other) : Stack() {
+        Chunk** link = &topChunk;
+        for (Chunk* chunk = other.topChunk; chunk; chunk = chunk->below) {
+            int used = chunk == other.topChunk ? other.topUsed : CHUNK_SIZE;
+            Chunk* copy = new Chunk;
+            copy->below = nullptr;
+            *link = copy;
+            link = &copy->below;
+            for (int i = 0; i < used; i++) {
+                copy->data[i] = chunk->data[i];
+            }
+            usedChunks++;
+        }
+        topUsed = other.topUsed;
+        count = other.count;
+    }
+    // Assignment operator
+    Stack& operator=(const Stack& other) {
+        if (this != &other) {
+            Stack copy(other);
+            swap(topChunk, copy.topChunk);
+            swap(topUsed, copy.topUsed);
+            swap(usedChunks, copy.usedChunks);
+            swap(freeChunks, copy.freeChunks);
+            swap(freeCount, copy.freeCount);
+            swap(reservedChunks, copy.reservedChunks);
+            swap(count, copy.count);
+        }
+        return *this;
+    }
+    // Add an element to the top of the stack
+    void push(const ValueType& value) {
+        if (!topChunk || topUsed == CHUNK_SIZE) {
+            pushChunk();
+        }
+        topChunk->data[topUsed++] = value;
+        count++;
+    }
+    // Remove and return the top element from the stack
+    ValueType pop() {
+        if (isEmpty()) {
+            throw underflow_error("Stack Underflow");
+        }
+        ValueType value = topChunk->data[--topUsed];
+        count--;
+        if (topUsed == 0) {
+            popChunk();
+        }
+        return value;
+    }
+    // Get the top element without removing it
+    ValueType top() const {
+        if (isEmpty()) {
+            throw underflow_error("Stack is empty");
+        }
+        return topChunk->data[topUsed - 1];
+    }
+    // Check if the stack is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    // Get the number of elements in the stack
+    int size() const {
+        return count;
+    }
+    // Allocate enough chunks to hold `elements` without further allocation.
+    // They stay allocated until shrinkToFit().
+    void reserve(int elements) {
+        int chunks = (elements + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        reservedChunks = max(reservedChunks, chunks);
+        while (usedChunks + freeCount < chunks) {
+            Chunk* chunk = new Chunk;
+            chunk->below = freeChunks;
+            freeChunks = chunk;
+            freeCount++;
+        }
+    }
+    // Release every chunk not holding elements, including the spare
+    void shrinkToFit() {
+        freeChain(freeChunks);
+        freeChunks = nullptr;
+        freeCount = 0;
+        reservedChunks = 0;
+    }
+    // Get the number of elements the allocated chunks can hold
+    int capacity() const {
+        return (usedChunks + freeCount) * CHUNK_SIZE;
+    }
+    // Display all elements in the stack (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Stack is empty" << endl;
+            return;
+        }
+        cout << "Stack elements: ";
+        for (Chunk* chunk = topChunk; chunk; chunk = chunk->below) {
+            int used = chunk == topChunk ? topUsed : CHUNK_SIZE;
+            for (int i = used - 1; i >= 0; i--) {
+                cout << chunk->data[i] << " ";
+            }
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 6215, 0x7338039696d23f6dULL,
+    "#include <iostream>\n"},
+    {"queue",
+R"DSLORD(/**
+ * Queue - A First-In-First-Out (FIFO) data structure implementation
+ * Operations:
+ * - enqueue: Add an element to the end of the queue
+ * - dequeue: Remove the first element from the queue
+ * - enqueueBulk: Add a block of elements to the end of the queue
+ * - dequeueBulk: Remove a block of elements from the front of the queue
+ * - front: Get the first element without removing it
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity, a power of two so indices wrap with a mask (dslord: -queue:capacity=<n>).
+    // When GROWABLE is set it is only the initial capacity and the storage doubles
+    // when full (dslord: -queue:growable)
+    static const int MAX_SIZE = 1024;
+    static const bool GROWABLE = false;
+    ValueType* data;
+    int capacityMask;
+    int frontIdx;
+    int count;
+    // Move the elements into storage twice as large, unwrapping them to index 0;
+    // throws overflow_error when that many elements no longer fit in an int
+    void grow() {
+        int capacity = capacityMask + 1;
+        if (capacity > INT_MAX / 2) {
+            throw overflow_error("Queue Overflow");
+        }
+        ValueType* newData = new ValueType[capacity * 2];
+        for (int i = 0; i < count; i++) {
+            newData[i] = data[(frontIdx + i) & capacityMask];
+        }
+        delete[] data;
+        data = newData;
+        capacityMask = capacity * 2 - 1;
+        frontIdx = 0;
+    }
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+public:
+    // Constructor
+    Queue() : data(new ValueType[MAX_SIZE]), capacityMask(MAX_SIZE - 1) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+        frontIdx = 0;
+        count = 0;
+    }
+    // Destructor
+    ~Queue() {
+        delete[] data;
+    }
+    // Copy constructor
+    Queue(const Queue& other) : data(new ValueType[other.capacityMask + 1]), capacityMask(other.capacityMask) {
+        frontIdx = 0;
+        count = other.count;
+        for (int i = 0; i < count; i++) {
+            data[i] = other.data[(other.frontIdx + i) & other.capacityMask];
+        }
+    }
+    // Assignment operator
+    Queue& operator=(const Queue& other) {
+        if (this != &other) {
+            Queue copy(other);
+            swap(data, copy.data);
+            swap(capacityMask, copy.capacityMask);
+            swap(frontIdx, copy.frontIdx);
+            swap(count, copy.count);
+        }
+        return *this;
+    }
+    // Add an element to the end of the queue
+    void enqueue(const ValueType& value) {
+        if (count > capacityMask) {
+            if (!GROWABLE) {
+                throw overflow_error("Queue Overflow");
+            }
+            grow();
+        }
+        data[(frontIdx + count) & capacityMask] = value;
+        count++;
+    }
+    // Remove and return the first element from the queue
+    ValueType dequeue() {
+        if (isEmpty()) {
+            throw underflow_error("Queue Underflow");
+        }
+        ValueType value = data[frontIdx];
+        frontIdx = (frontIdx + 1) & capacityMask;
+        count--;
+        return value;
+    }
+    // Add up to n elements from `values` to the end of the queue, with at most
+    // two block copies; returns how many fit (all of them when growable)
+    int enqueueBulk(const ValueType* values, int n) {
+        while (GROWABLE && n > capacityMask + 1 - count) {
+            grow();
+        }
+        n = max(0, min(n, capacityMask + 1 - count));
+        int rear = (frontIdx + count) & capacityMask;
+        int first = min(n, capacityMask + 1 - rear);
+        copyElements(data + rear, values, first);
+        copyElements(data, values + first, n - first);
+        count += n;
+        return n;
+    }
+    // Remove up to n elements from the front of the queue into `values`, with at
+    // most two block copies; returns how many were removed
+    int dequeueBulk(ValueType* values, int n) {
+        n = max(0, min(n, count));
+        int first = min(n, capacityMask + 1 - frontIdx);
+        copyElements(values, data + frontIdx, first);
+        copyElements(values + first, data, n - first);
+        frontIdx = (frontIdx + n) & capacityMask;
+        count -= n;
+        return n;
+    }
+    // Get the first element without removing it
+    ValueType front() const {
+        if (isEmpty()) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    // Get the number of elements in the queue
+    int size() const {
+        return count;
+    }
+    // Display all elements in the queue (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+        
+        cout << "Queue elements: ";
+        int index = frontIdx;
+        for (int i = 0; i < count; i++) {
+            cout << data[index] << " ";
+            index = (index + 1) & capacityMask;
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 5606, 0x248812561c805e60ULL,
+    "#include <climits>\n#include <cstring>\n#include <iostream>\n#include <type_traits>\n"},
+    {"queue_blocking",
+R"DSLORD(/**
+ * Queue - A blocking First-In-First-Out (FIFO) queue for producer and consumer
+ * threads (dslord: -queue:blocking). Consumers wait for elements instead of
+ * getting underflow_error, and producers wait for room when the queue is full.
+ *
+ * A waiting thread first spins briefly on a lock-free element count and only
+ * parks on a condition variable when nothing arrives, and producers only
+ * notify when a consumer is actually parked (once per batch for bulk calls),
+ * so a busy queue does not make a futex call per element.
+ * Operations:
+ * - enqueue: Add an element, waiting while the queue is full
+ * - tryEnqueue: Add an element if there is room
+ * - enqueueBulk: Add as many elements of a block as there is room for
+ * - dequeue: Remove the first element, waiting until there is one
+ * - tryDequeue: Remove the first element if there is one
+ * - dequeueFor: Remove the first element, waiting at most a timeout
+ * - dequeueUpTo: Remove up to n elements, waiting at most a timeout for the first
+ * - close: Refuse new elements and wake every waiting thread
+ * - front: Get the first element without removing it
+ * - isEmpty, isClosed, size: Query the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity, a power of two so indices wrap with a mask (dslord: -queue:blocking,capacity=<n>).
+    // When GROWABLE is set it is only the initial capacity, the storage doubles
+    // when full and producers never wait (dslord: -queue:blocking,growable)
+    static const int MAX_SIZE = 1024;
+    static const bool GROWABLE = false;
+    // Polls of the element count before a waiting thread parks
+    static const int SPIN_LIMIT = 256;
+    typedef chrono::steady_clock Clock;
+    mutable mutex lock;
+    condition_variable notEmpty;
+    condition_variable notFull;
+    ValueType* data;
+    int capacityMask;
+    int frontIdx;
+    atomic<int> count;  // written under the lock, read without it while spinning
+    atomic<bool> closed;
+    int waitingConsumers;
+    int waitingProducers;
+    // Move the elements into storage twice as large, unwrapping them to index 0;
+    // throws overflow_error when that many elements no longer fit in an int
+    void grow() {
+        int capacity = capacityMask + 1;
+        if (capacity > INT_MAX / 2) {
+            throw overflow_error("Queue Overflow");
+        }
+        ValueType* newData = new ValueType[capacity * 2];
+        int first = min((int)count, capacity - frontIdx);
+        copyElements(newData, data + frontIdx, first);
+        copyElements(newData + first, data, count - first);
+        delete[] data;
+        data = newData;
+        capacityMask = capacity * 2 - 1;
+        frontIdx = 0;
+    }
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    // Poll the lock-free state until `ready` holds or the spin budget is spent,
+    // yielding the core for the second half
+    void spinFor(bool (Queue::*ready)() const) const {
+        for (int i = 0; i < SPIN_LIMIT && !(this->*ready)(); i++) {
+            if (i >= SPIN_LIMIT / 2) {
+                this_thread::yield();
+            }
+        }
+    }
+    bool hasElementsOrClosed() const {
+        return count.load(memory_order_acquire) > 0 || closed.load(memory_order_acquire);
+    }
+    bool hasRoomOrClosed() const {
+        return GROWABLE || count.load(memory_order_acquire) <= capacityMask || closed.load(memory_order_acquire);
+    }
+    // Wait (spin, then park) until there is an element or the queue is closed,
+    // giving up at `deadline` when one is given; returns with the lock held
+    bool waitForElements(unique_lock<mutex>& guard, const Clock::time_point* deadline) {
+        if (count == 0 && !closed) {
+            guard.unlock();
+            spinFor(&Queue::hasElementsOrClosed);
+            guard.lock();
+        }
+        while (count == 0 && !closed) {
+            bool timedOut = false;
+            waitingConsumers++;
+            if (deadline) {
+                timedOut = notEmpty.wait_until(guard, *deadline) == cv_status::timeout;
+            } else {
+                notEmpty.wait(guard);
+            }
+            waitingConsumers--;
+            if (timedOut) {
+                break;
+            }
+        }
+        return count > 0;
+    }
+    // Wait (spin, then park) until there is room or the queue is closed
+    void waitForRoom(unique_lock<mutex>& guard) {
+        if (!GROWABLE && count > capacityMask && !closed) {
+            guard.unlock();
+            spinFor(&Queue::hasRoomOrClosed);
+            guard.lock();
+        }
+        while (!GROWABLE && count > capacityMask && !closed) {
+            waitingProducers++;
+            notFull.wait(guard);
+            waitingProducers--;
+        }
+    }
+    // Append under the lock; the caller has made room
+    void push(const ValueType& value) {
+        if (count > capacityMask) {
+            grow();
+        }
+        data[(frontIdx + count) & capacityMask] = value;
+        count.fetch_add(1, memory_order_release);
+    }
+    // Remove up to n elements under the lock with at most two block copies
+    int take(ValueType* values, int n) {
+        n = max(0, min(n, (int)count));
+        int first = min(n, capacityMask + 1 - frontIdx);
+        copyElements(values, data + frontIdx, first);
+        copyElements(values + first, data, n - first);
+        frontIdx = (frontIdx + n) & capacityMask;
+        count.fetch_sub(n, memory_order_release);
+        return n;
+    }
+    // Wake consumers after adding elements; called without the lock
+    void wakeConsumers(bool wake, int added) {
+        if (wake) {
+            if (added > 1) {
+                notEmpty.notify_all();
+            } else {
+                notEmpty.notify_one();
+            }
+        }
+    }
+    // Remove up to n elements once the lock is held and waiting is done
+    int takeAndWake(unique_lock<mutex>& guard, ValueType* values, int n) {
+        n = take(values, n);
+        bool wake = waitingProducers > 0 && n > 0;
+        guard.unlock();
+        if (wake) {
+            if (n > 1) {
+                notFull.notify_all();
+            } else {
+                notFull.notify_one();
+            }
+        }
+        return n;
+    }
+public:
+    // Constructor
+    Queue() : data(new ValueType[MAX_SIZE]), capacityMask(MAX_SIZE - 1), frontIdx(0), count(0),
+              closed(false), waitingConsumers(0), waitingProducers(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+    }
+    // Destructor (no thread may still be waiting on the queue)
+    ~Queue() {
+        delete[] data;
+    }
+    // Threads share one queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+    // Add an element to the end of the queue, waiting while it is full;
+    // throws logic_error once the queue is closed
+    void enqueue(const ValueType& value) {
+        unique_lock<mutex> guard(lock);
+        waitForRoom(guard);
+        if (closed) {
+            throw logic_error("Queue Closed");
+        }
+        push(value);
+        bool wake = waitingConsumers > 0;
+        guard.unlock();
+        wakeConsumers(wake, 1);
+    }
+    // Add an element if there is room; false when full or closed
+    bool tryEnqueue(const ValueType& value) {
+        unique_lock<mutex> guard(lock);
+        if (closed || (!GROWABLE && count > capacityMask)) {
+            return false;
+        }
+        push(value);
+        bool wake = waitingConsumers > 0;
+        guard.unlock();
+        wakeConsumers(wake, 1);
+        return true;
+    }
+    // Add up to n elements from `values` without waiting, with one wakeup for
+    // the whole batch; returns how many were added (0 once closed)
+)DSLORD"
+R"DSLORD(    int enqueueBulk(const ValueType* values, int n) {
+        unique_lock<mutex> guard(lock);
+        if (closed) {
+            return 0;
+        }
+        while (GROWABLE && n > capacityMask + 1 - count) {
+            grow();
+        }
+        n = max(0, min(n, capacityMask + 1 - (int)count));
+        int rear = (frontIdx + count) & capacityMask;
+        int first = min(n, capacityMask + 1 - rear);
+        copyElements(data + rear, values, first);
+        copyElements(data, values + first, n - first);
+        count.fetch_add(n, memory_order_release);
+        bool wake = waitingConsumers > 0 && n > 0;
+        guard.unlock();
+        wakeConsumers(wake, n);
+        return n;
+    }
+    // Remove and return the first element, waiting until there is one;
+    // throws underflow_error once the queue is closed and empty
+    ValueType dequeue() {
+        unique_lock<mutex> guard(lock);
+        if (!waitForElements(guard, nullptr)) {
+            throw underflow_error("Queue Closed");
+        }
+        ValueType value;
+        takeAndWake(guard, &value, 1);
+        return value;
+    }
+    // Remove the first element into `value` if there is one, without waiting
+    bool tryDequeue(ValueType& value) {
+        unique_lock<mutex> guard(lock);
+        return takeAndWake(guard, &value, 1) == 1;
+    }
+    // Remove the first element into `value`, waiting at most `timeout`;
+    // false on timeout or when the queue is closed and empty
+    template <typename Rep, typename Period>
+    bool dequeueFor(ValueType& value, const chrono::duration<Rep, Period>& timeout) {
+        Clock::time_point deadline = Clock::now() + chrono::duration_cast<Clock::duration>(timeout);
+        unique_lock<mutex> guard(lock);
+        if (!waitForElements(guard, &deadline)) {
+            return false;
+        }
+        return takeAndWake(guard, &value, 1) == 1;
+    }
+    // Remove up to n elements into `values`, waiting at most `timeout` for the
+    // first one; returns how many were removed (0 on timeout, or when the
+    // queue is closed and empty)
+    template <typename Rep, typename Period>
+    int dequeueUpTo(ValueType* values, int n, const chrono::duration<Rep, Period>& timeout) {
+        Clock::time_point deadline = Clock::now() + chrono::duration_cast<Clock::duration>(timeout);
+        unique_lock<mutex> guard(lock);
+        if (!waitForElements(guard, &deadline)) {
+            return 0;
+        }
+        return takeAndWake(guard, values, n);
+    }
+    // Refuse new elements and wake every waiting thread; consumers still drain
+    // what is left
+    void close() {
+        {
+            lock_guard<mutex> guard(lock);
+            closed = true;
+        }
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+    // Check if close() was called
+    bool isClosed() const {
+        return closed.load(memory_order_acquire);
+    }
+    // Get the first element without removing it
+    ValueType front() const {
+        lock_guard<mutex> guard(lock);
+        if (count == 0) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return count.load(memory_order_acquire) == 0;
+    }
+    // Get the number of elements in the queue
+    int size() const {
+        return count.load(memory_order_acquire);
+    }
+    // Display all elements in the queue (for debugging)
+    void display() const {
+        lock_guard<mutex> guard(lock);
+        if (count == 0) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+        cout << "Queue elements: ";
+        for (int i = 0; i < count; i++) {
+            cout << data[(frontIdx + i) & capacityMask] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 11921, 0x3414878ed1c2e287ULL,
+    "#include <atomic>\n#include <chrono>\n#include <climits>\n#include <condition_variable>\n#include <cstring>\n#include <iostream>\n#include <mutex>\n#include <thread>\n#include <type_traits>\n"},
+    {"queue_channel",
+R"DSLORD(/**
+ * Queue - A First-In-First-Out (FIFO) channel between C++20 coroutines
+ * (dslord: -queue:channel). `co_await queue.pop()` suspends a coroutine while
+ * the queue is empty and `co_await queue.push(value)` while it is full; a
+ * single-threaded Queue::Scheduler resumes them once they can go on, so any
+ * number of producers and consumers share one thread.
+ *
+ * Elements live in the same power-of-two ring buffer as the plain Queue. A
+ * value pushed while consumers wait is handed straight to the first of them,
+ * and popping from a full queue moves the first waiting producer's value in,
+ * so waiters are served in the order they arrived. Needs -std=c++20.
+ * Operations:
+ * - push: Awaitable enqueue, suspends while the queue is full
+ * - pop: Awaitable dequeue, suspends while the queue is empty
+ * - enqueue: Add an element to the end of the queue (throws when full)
+ * - dequeue: Remove the first element from the queue (throws when empty)
+ * - tryEnqueue, tryDequeue: Non-throwing enqueue and dequeue
+ * - front: Get the first element without removing it
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity, a power of two so indices wrap with a mask (dslord: -queue:channel,capacity=<n>)
+    static const int MAX_SIZE = 1024;
+    // Links a spawned coroutine into its scheduler's list of live tasks
+    struct TaskLink {
+        TaskLink* prev = nullptr;
+        TaskLink* next = nullptr;
+    };
+public:
+    class Scheduler;
+    // Return type of producer and consumer coroutines. A Task starts suspended
+    // and runs once it is passed to Scheduler::spawn(); its frame frees itself
+    // when the coroutine returns.
+    class Task {
+    public:
+        struct promise_type : TaskLink {
+            exception_ptr* failure = nullptr;  // where the scheduler collects exceptions
+            Task get_return_object() {
+                return Task(coroutine_handle<promise_type>::from_promise(*this));
+            }
+            suspend_always initial_suspend() noexcept {
+                return {};
+            }
+            suspend_never final_suspend() noexcept {
+                return {};
+            }
+            void return_void() {}
+            void unhandled_exception() {
+                *failure = current_exception();
+            }
+            ~promise_type() {
+                if (prev) {
+                    prev->next = next;
+                    next->prev = prev;
+                }
+            }
+        };
+        Task(Task&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        // A Task that was never spawned destroys its coroutine
+        ~Task() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+    private:
+        friend class Scheduler;
+        explicit Task(coroutine_handle<promise_type> handle) : handle(handle) {}
+        coroutine_handle<promise_type> handle;
+    };
+    // Runs coroutines on the calling thread: spawned tasks and waiters a queue
+    // has released are resumed in FIFO order
+    class Scheduler {
+    public:
+        Scheduler() {
+            live.prev = live.next = &live;
+        }
+        // Destroys the coroutines that have not finished; queues they were
+        // waiting on must not be used afterwards
+        ~Scheduler() {
+            ready.clear();
+            while (live.next != &live) {
+                coroutine_handle<Task::promise_type>::from_promise(static_cast<Task::promise_type&>(*live.next)).destroy();
+            }
+        }
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+        // The scheduler used by queues constructed without one (one per thread)
+        static Scheduler& local() {
+            static thread_local Scheduler scheduler;
+            return scheduler;
+        }
+        // Take ownership of a coroutine and queue it to start on the next run()
+        void spawn(Task task) {
+            Task::promise_type& promise = task.handle.promise();
+            promise.failure = &failure;
+            promise.prev = live.prev;
+            promise.next = &live;
+            live.prev->next = &promise;
+            live.prev = &promise;
+            ready.push_back(exchange(task.handle, nullptr));
+        }
+        // Queue a suspended coroutine to be resumed
+        void schedule(coroutine_handle<> handle) {
+            ready.push_back(handle);
+        }
+        // Resume coroutines until every one has finished or waits on a queue.
+        // An exception escaping a coroutine ends that coroutine and is rethrown here.
+        void run() {
+            while (!ready.empty()) {
+                coroutine_handle<> next = ready.front();
+                ready.pop_front();
+                next.resume();
+                if (failure) {
+                    rethrow_exception(exchange(failure, nullptr));
+                }
+            }
+        }
+        // Get the number of spawned coroutines that have not finished
+        size_t liveTasks() const {
+            size_t count = 0;
+            for (const TaskLink* link = live.next; link != &live; link = link->next) {
+                count++;
+            }
+            return count;
+        }
+    private:
+        TaskLink live;  // sentinel of the circular list of unfinished tasks
+        deque<coroutine_handle<>> ready;
+        exception_ptr failure;
+    };
+    // Awaiter returned by pop(); a suspended consumer waits in the queue's
+    // list until a producer hands it a value
+    class PopAwaiter {
+    public:
+        bool await_ready() {
+            return queue.tryDequeue(value);
+        }
+        void await_suspend(coroutine_handle<> handle) {
+            waiter = handle;
+            queue.addWaiter(queue.consumers, this);
+        }
+        ValueType await_resume() {
+            return value;
+        }
+    private:
+        friend class Queue;
+        explicit PopAwaiter(Queue& queue) : queue(queue) {}
+        Queue& queue;
+        ValueType value;
+        coroutine_handle<> waiter;
+        PopAwaiter* next = nullptr;
+    };
+    // Awaiter returned by push(); a suspended producer keeps its value until
+    // a consumer makes room for it
+    class PushAwaiter {
+    public:
+        bool await_ready() {
+            return queue.tryEnqueue(value);
+        }
+        void await_suspend(coroutine_handle<> handle) {
+            waiter = handle;
+            queue.addWaiter(queue.producers, this);
+        }
+        void await_resume() {}
+    private:
+        friend class Queue;
+        PushAwaiter(Queue& queue, const ValueType& value) : queue(queue), value(value) {}
+        Queue& queue;
+        ValueType value;
+        coroutine_handle<> waiter;
+        PushAwaiter* next = nullptr;
+    };
+private:
+    // FIFO of suspended awaiters, linked through their `next`
+    template <typename Awaiter>
+    struct WaitList {
+        Awaiter* head = nullptr;
+        Awaiter* tail = nullptr;
+    };
+    Scheduler& scheduler;
+    ValueType* data;
+    int frontIdx;
+    int count;
+    WaitList<PopAwaiter> consumers;   // only non-empty while the queue is empty
+    WaitList<PushAwaiter> producers;  // only non-empty while the queue is full
+    template <typename Awaiter>
+    static void addWaiter(WaitList<Awaiter>& list, Awaiter* awaiter) {
+        if (list.tail) {
+            list.tail->next = awaiter;
+        } else {
+            list.head = awaiter;
+        }
+        list.tail = awaiter;
+    }
+    template <typename Awaiter>
+    static Awaiter* takeWaiter(WaitList<Awaiter>& list) {
+        Awaiter* awaiter = list.head;
+        list.head = awaiter->next;
+        if (!list.head) {
+            list.tail = nullptr;
+        }
+        return awaiter;
+    }
+public:
+    // Constructor; the queue resumes waiters on `scheduler`
+    explicit Queue(Scheduler& scheduler) : scheduler(scheduler), data(new ValueType[MAX_SIZE]), frontIdx(0), count(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+    }
+)DSLORD"
+R"DSLORD(    // Constructor using this thread's Scheduler::local()
+    Queue() : Queue(Scheduler::local()) {}
+    // Destructor (coroutines still waiting on the queue are left suspended)
+    ~Queue() {
+        delete[] data;
+    }
+    // Waiting coroutines point at the queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+    // co_await push(value): add an element, suspending while the queue is full
+    PushAwaiter push(const ValueType& value) {
+        return PushAwaiter(*this, value);
+    }
+    // co_await pop(): remove the first element, suspending while the queue is empty
+    PopAwaiter pop() {
+        return PopAwaiter(*this);
+    }
+    // Add an element to the end of the queue; false when it is full
+    bool tryEnqueue(const ValueType& value) {
+        if (consumers.head) {
+            PopAwaiter* consumer = takeWaiter(consumers);
+            consumer->value = value;
+            scheduler.schedule(consumer->waiter);
+            return true;
+        }
+        if (count == MAX_SIZE) {
+            return false;
+        }
+        data[(frontIdx + count) & (MAX_SIZE - 1)] = value;
+        count++;
+        return true;
+    }
+    // Remove the first element into `value`; false when the queue is empty
+    bool tryDequeue(ValueType& value) {
+        if (count == 0) {
+            return false;
+        }
+        value = data[frontIdx];
+        frontIdx = (frontIdx + 1) & (MAX_SIZE - 1);
+        count--;
+        if (producers.head) {
+            PushAwaiter* producer = takeWaiter(producers);
+            data[(frontIdx + count) & (MAX_SIZE - 1)] = producer->value;
+            count++;
+            scheduler.schedule(producer->waiter);
+        }
+        return true;
+    }
+    // Add an element to the end of the queue
+    void enqueue(const ValueType& value) {
+        if (!tryEnqueue(value)) {
+            throw overflow_error("Queue Overflow");
+        }
+    }
+    // Remove and return the first element from the queue
+    ValueType dequeue() {
+        ValueType value;
+        if (!tryDequeue(value)) {
+            throw underflow_error("Queue Underflow");
+        }
+        return value;
+    }
+    // Get the first element without removing it
+    ValueType front() const {
+        if (isEmpty()) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    // Get the number of elements in the queue
+    int size() const {
+        return count;
+    }
+    // Display all elements in the queue (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+        cout << "Queue elements: ";
+        for (int i = 0; i < count; i++) {
+            cout << data[(frontIdx + i) & (MAX_SIZE - 1)] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 11123, 0x360318084d1b252eULL,
+    "#include <coroutine>\n#include <deque>\n#include <exception>\n#include <iostream>\n#include <utility>\n"},
+    {"queue_mpmc",
+R"DSLORD(/**
+ * Queue - A bounded lock-free First-In-First-Out (FIFO) queue for any number of
+ * producer and consumer threads (dslord: -queue:mpmc).
+ *
+ * Each slot carries a sequence number that says whether it is ready to be
+ * written for a given lap or read (Vyukov's bounded MPMC queue). Producers and
+ * consumers each claim a position with one compare-and-swap on their own
+ * counter, and the two counters sit on separate cache lines, so there is no
+ * global lock and no shared element count.
+ * Operations:
+ * - enqueue: Add an element to the end of the queue (throws when full)
+ * - tryEnqueue: Add an element if there is room
+ * - dequeue: Remove the first element from the queue (throws when empty)
+ * - tryDequeue: Remove the first element if there is one
+ * - front: Get the first element without removing it
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity, a power of two so positions wrap with a mask (dslord: -queue:mpmc,capacity=<n>)
+    static const int MAX_SIZE = 1024;
+    static const size_t MASK = MAX_SIZE - 1;
+    static const size_t CACHE_LINE = 64;
+    // A slot is writable for position p when sequence == p, and readable when
+    // sequence == p + 1; a read hands it on to the next lap (p + MAX_SIZE)
+    struct Cell {
+        atomic<size_t> sequence;
+        ValueType value;
+    };
+    Cell* const cells;
+    alignas(CACHE_LINE) atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) atomic<size_t> dequeuePos;
+public:
+    // Constructor
+    Queue() : cells(new Cell[MAX_SIZE]), enqueuePos(0), dequeuePos(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+        static_assert(MAX_SIZE >= 2, "Queue:mpmc needs at least two slots for its sequence numbers");
+        for (size_t i = 0; i < (size_t)MAX_SIZE; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+    // Destructor
+    ~Queue() {
+        delete[] cells;
+    }
+    // Threads share one queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+    // Add an element to the end of the queue; false when it is full
+    bool tryEnqueue(const ValueType& value) {
+        size_t position = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & MASK];
+            ptrdiff_t lap = (ptrdiff_t)(cell.sequence.load(memory_order_acquire) - position);
+            if (lap == 0) {
+                if (enqueuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;  // the slot still holds last lap's element
+            } else {
+                position = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+    // Add an element to the end of the queue
+    void enqueue(const ValueType& value) {
+        if (!tryEnqueue(value)) {
+            throw overflow_error("Queue Overflow");
+        }
+    }
+    // Remove the first element into `value`; false when it is empty
+    bool tryDequeue(ValueType& value) {
+        size_t position = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & MASK];
+            ptrdiff_t lap = (ptrdiff_t)(cell.sequence.load(memory_order_acquire) - (position + 1));
+            if (lap == 0) {
+                if (dequeuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + MASK + 1, memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;  // nothing written here yet
+            } else {
+                position = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+    // Remove and return the first element from the queue
+    ValueType dequeue() {
+        ValueType value;
+        if (!tryDequeue(value)) {
+            throw underflow_error("Queue Underflow");
+        }
+        return value;
+    }
+    // Get the first element without removing it (only stable while no other thread dequeues)
+    ValueType front() const {
+        size_t position = dequeuePos.load(memory_order_relaxed);
+        const Cell& cell = cells[position & MASK];
+        if (cell.sequence.load(memory_order_acquire) != position + 1) {
+            throw underflow_error("Queue is empty");
+        }
+        return cell.value;
+    }
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return size() == 0;
+    }
+    // Get the number of elements in the queue (a snapshot under concurrent use)
+    int size() const {
+        size_t first = dequeuePos.load(memory_order_acquire);
+        ptrdiff_t count = (ptrdiff_t)(enqueuePos.load(memory_order_acquire) - first);
+        return (int)max((ptrdiff_t)0, min(count, (ptrdiff_t)MAX_SIZE));
+    }
+    // Display all elements in the queue (for debugging, while no thread is using it)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+        cout << "Queue elements: ";
+        size_t last = enqueuePos.load(memory_order_acquire);
+        for (size_t position = dequeuePos.load(memory_order_acquire); position != last; position++) {
+            cout << cells[position & MASK].value << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 5748, 0xb902a36a980ab814ULL,
+    "#include <atomic>\n#include <cstddef>\n#include <iostream>\n"},
+    {"queue_spsc",
+R"DSLORD(/**
+ * Queue - A lock-free First-In-First-Out (FIFO) ring buffer for exactly one
+ * producer thread and one consumer thread (dslord: -queue:spsc).
+ *
+ * The capacity is a power of two, so positions are free-running counters that
+ * wrap into the buffer with a mask instead of a division. The producer owns
+ * `tail` and the consumer owns `head`; they sit on separate cache lines, and
+ * each side keeps a cached copy of the other's counter so it only reads the
+ * other core's cache line when the queue looks full (or empty).
+ * Operations:
+ * - enqueue: Add an element to the end of the queue (producer; throws when full)
+ * - tryEnqueue: Add an element if there is room (producer)
+ * - dequeue: Remove the first element from the queue (consumer; throws when empty)
+ * - tryDequeue: Remove the first element if there is one (consumer)
+ * - enqueueBulk, dequeueBulk: Move a block of elements with one index update
+ * - front: Get the first element without removing it (consumer)
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity, a power of two so positions wrap with a mask (dslord: -queue:spsc,capacity=<n>)
+    static const int MAX_SIZE = 1024;
+    static const size_t MASK = MAX_SIZE - 1;
+    static const size_t CACHE_LINE = 64;
+    ValueType* const data;
+    // Consumer side
+    alignas(CACHE_LINE) atomic<size_t> head;
+    size_t cachedTail;
+    // Producer side
+    alignas(CACHE_LINE) atomic<size_t> tail;
+    size_t cachedHead;  // the class is padded to a whole line, so nothing follows on this one
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+public:
+    // Constructor
+    Queue() : data(new ValueType[MAX_SIZE]), head(0), cachedTail(0), tail(0), cachedHead(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+    }
+    // Destructor
+    ~Queue() {
+        delete[] data;
+    }
+    // The two threads share one queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+    // Add an element to the end of the queue; false when it is full (producer only)
+    bool tryEnqueue(const ValueType& value) {
+        size_t position = tail.load(memory_order_relaxed);
+        if (position - cachedHead == (size_t)MAX_SIZE) {
+            cachedHead = head.load(memory_order_acquire);
+            if (position - cachedHead == (size_t)MAX_SIZE) {
+                return false;
+            }
+        }
+        data[position & MASK] = value;
+        tail.store(position + 1, memory_order_release);
+        return true;
+    }
+    // Add an element to the end of the queue (producer only)
+    void enqueue(const ValueType& value) {
+        if (!tryEnqueue(value)) {
+            throw overflow_error("Queue Overflow");
+        }
+    }
+    // Remove the first element into `value`; false when it is empty (consumer only)
+    bool tryDequeue(ValueType& value) {
+        size_t position = head.load(memory_order_relaxed);
+        if (position == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire);
+            if (position == cachedTail) {
+                return false;
+            }
+        }
+        value = data[position & MASK];
+        head.store(position + 1, memory_order_release);
+        return true;
+    }
+    // Add up to n elements from `values` with at most two block copies and a
+    // single publish; returns how many fit (producer only)
+    int enqueueBulk(const ValueType* values, int n) {
+        size_t position = tail.load(memory_order_relaxed);
+        size_t wanted = (size_t)max(n, 0);
+        if ((size_t)MAX_SIZE - (position - cachedHead) < wanted) {
+            cachedHead = head.load(memory_order_acquire);
+        }
+        size_t count = min(wanted, (size_t)MAX_SIZE - (position - cachedHead));
+        size_t start = position & MASK;
+        size_t first = min(count, (size_t)MAX_SIZE - start);
+        copyElements(data + start, values, first);
+        copyElements(data, values + first, count - first);
+        tail.store(position + count, memory_order_release);
+        return (int)count;
+    }
+    // Remove up to n elements into `values` with at most two block copies and a
+    // single release of the slots; returns how many were removed (consumer only)
+    int dequeueBulk(ValueType* values, int n) {
+        size_t position = head.load(memory_order_relaxed);
+        size_t wanted = (size_t)max(n, 0);
+        if (cachedTail - position < wanted) {
+            cachedTail = tail.load(memory_order_acquire);
+        }
+        size_t count = min(wanted, cachedTail - position);
+        size_t start = position & MASK;
+        size_t first = min(count, (size_t)MAX_SIZE - start);
+        copyElements(values, data + start, first);
+        copyElements(values + first, data, count - first);
+        head.store(position + count, memory_order_release);
+        return (int)count;
+    }
+    // Remove and return the first element from the queue (consumer only)
+    ValueType dequeue() {
+        ValueType value;
+        if (!tryDequeue(value)) {
+            throw underflow_error("Queue Underflow");
+        }
+        return value;
+    }
+    // Get the first element without removing it (consumer only)
+    ValueType front() {
+        size_t position = head.load(memory_order_relaxed);
+        if (position == tail.load(memory_order_acquire)) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[position & MASK];
+    }
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return size() == 0;
+    }
+    // Get the number of elements in the queue (a snapshot while the threads run)
+    int size() const {
+        size_t first = head.load(memory_order_acquire);
+        return (int)(tail.load(memory_order_acquire) - first);
+    }
+    // Display all elements in the queue (for debugging, while no thread is using it)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+        cout << "Queue elements: ";
+        size_t last = tail.load(memory_order_acquire);
+        for (size_t position = head.load(memory_order_acquire); position != last; position++) {
+            cout << data[position & MASK] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 6856, 0xfb18703af9f63172ULL,
+    "#include <atomic>\n#include <cstddef>\n#include <cstring>\n#include <iostream>\n#include <type_traits>\n"},
+    {"deque",
+R"DSLORD(/**
+ * Deque - A Double-ended Queue implementation
+ * Operations:
+ * - insertFront: Insert an element at the front
+ * - insertRear: Insert an element at the rear
+ * - deleteFront: Delete the front element
+ * - deleteRear: Delete the rear element
+ * - insertFrontBulk, insertRearBulk: Insert a block of elements at either end
+ * - deleteFrontBulk, deleteRearBulk: Delete a block of elements from either end
+ * - getFront: Get the front element
+ * - getRear: Get the rear element
+ * - isEmpty: Check if the deque is empty
+ * - isFull: Check if the deque is full
+ * - size: Get the number of elements in the deque
+ */
+class Deque {
+public:
+    // Element type (dslord: -deque:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity, a power of two so indices wrap with a mask (dslord: -deque:capacity=<n>).
+    // When GROWABLE is set it is only the initial capacity and the storage doubles
+    // when full (dslord: -deque:growable)
+    static const int MAX_SIZE = 1024;
+    static const bool GROWABLE = false;
+    
+    ValueType* data;
+    int capacityMask;
+    int front;
+    int count;
+    
+    // Index of the rear element
+    int rearIndex() const {
+        return (front + count - 1) & capacityMask;
+    }
+    
+    // Move the elements into storage twice as large, unwrapping them to index 0;
+    // throws overflow_error when that many elements no longer fit in an int
+    void grow() {
+        int capacity = capacityMask + 1;
+        if (capacity > INT_MAX / 2) {
+            throw overflow_error("Deque Overflow");
+        }
+        ValueType* newData = new ValueType[capacity * 2];
+        for (int i = 0; i < count; i++) {
+            newData[i] = data[(front + i) & capacityMask];
+        }
+        delete[] data;
+        data = newData;
+        capacityMask = capacity * 2 - 1;
+        front = 0;
+    }
+    
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    
+    // Copy n elements into the ring starting at index start, wrapping at most once
+    void copyIn(int start, const ValueType* values, int n) {
+        int first = min(n, capacityMask + 1 - start);
+        copyElements(data + start, values, first);
+        copyElements(data, values + first, n - first);
+    }
+    
+    // Copy n elements out of the ring starting at index start, wrapping at most once
+    void copyOut(int start, ValueType* values, int n) const {
+        int first = min(n, capacityMask + 1 - start);
+        copyElements(values, data + start, first);
+        copyElements(values + first, data, n - first);
+    }
+    
+    // How many of n new elements fit, growing first when growable
+    int roomFor(int n) {
+        while (GROWABLE && n > capacityMask + 1 - count) {
+            grow();
+        }
+        return max(0, min(n, capacityMask + 1 - count));
+    }
+public:
+    // Constructor
+    Deque() : data(new ValueType[MAX_SIZE]), capacityMask(MAX_SIZE - 1) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Deque capacity must be a power of two");
+        front = 0;
+        count = 0;
+    }
+    
+    // Destructor
+    ~Deque() {
+        delete[] data;
+    }
+    
+    // Copy constructor
+    Deque(const Deque& other) : data(new ValueType[other.capacityMask + 1]), capacityMask(other.capacityMask) {
+        front = 0;
+        count = other.count;
+        for (int i = 0; i < count; i++) {
+            data[i] = other.data[(other.front + i) & other.capacityMask];
+        }
+    }
+    
+    // Assignment operator
+    Deque& operator=(const Deque& other) {
+        if (this != &other) {
+            Deque copy(other);
+            swap(data, copy.data);
+            swap(capacityMask, copy.capacityMask);
+            swap(front, copy.front);
+            swap(count, copy.count);
+        }
+        return *this;
+    }
+    
+    // Check if the deque is full (never true for a growable deque)
+    bool isFull() const {
+        return !GROWABLE && count > capacityMask;
+    }
+    
+    // Check if the deque is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    // Insert an element at the front
+    void insertFront(const ValueType& value) {
+        if (isFull()) {
+            throw overflow_error("Deque Overflow");
+        }
+        if (count > capacityMask) {
+            grow();
+        }
+        
+        front = (front - 1) & capacityMask;
+        data[front] = value;
+        count++;
+    }
+    
+    // Insert an element at the rear
+    void insertRear(const ValueType& value) {
+        if (isFull()) {
+            throw overflow_error("Deque Overflow");
+        }
+        if (count > capacityMask) {
+            grow();
+        }
+        
+        data[(front + count) & capacityMask] = value;
+        count++;
+    }
+    
+    // Delete the front element
+    ValueType deleteFront() {
+        if (isEmpty()) {
+            throw underflow_error("Deque Underflow");
+        }
+        
+        ValueType value = data[front];
+        front = (front + 1) & capacityMask;
+        count--;
+        return value;
+    }
+    
+    // Delete the rear element
+    ValueType deleteRear() {
+        if (isEmpty()) {
+            throw underflow_error("Deque Underflow");
+        }
+        
+        ValueType value = data[rearIndex()];
+        count--;
+        return value;
+    }
+    
+    // Insert up to n elements from `values` at the front, keeping their order
+    // (values[0] becomes the front); returns how many fit (all when growable)
+    int insertFrontBulk(const ValueType* values, int n) {
+        n = roomFor(n);
+        front = (front - n) & capacityMask;
+        copyIn(front, values, n);
+        count += n;
+        return n;
+    }
+    
+    // Insert up to n elements from `values` at the rear, in order; returns how
+    // many fit (all when growable)
+    int insertRearBulk(const ValueType* values, int n) {
+        n = roomFor(n);
+        copyIn((front + count) & capacityMask, values, n);
+        count += n;
+        return n;
+    }
+    
+    // Delete up to n elements from the front into `values`, front first;
+    // returns how many were deleted
+    int deleteFrontBulk(ValueType* values, int n) {
+        n = max(0, min(n, count));
+        copyOut(front, values, n);
+        front = (front + n) & capacityMask;
+        count -= n;
+        return n;
+    }
+    
+    // Delete up to n elements from the rear into `values`, in front-to-rear
+    // order; returns how many were deleted
+    int deleteRearBulk(ValueType* values, int n) {
+        n = max(0, min(n, count));
+        copyOut((front + count - n) & capacityMask, values, n);
+        count -= n;
+        return n;
+    }
+    
+    // Get the front element
+    ValueType getFront() const {
+        if (isEmpty()) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return data[front];
+    }
+    
+    // Get the rear element
+    ValueType getRear() const {
+        if (isEmpty()) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return data[rearIndex()];
+    }
+    
+    // Get the number of elements in the deque
+    int size() const {
+        return count;
+    }
+    
+    // Display all elements in the deque
+    void display() const {
+        if (isEmpty()) {
+            cout << "Deque is empty" << endl;
+            return;
+        }
+        
+        cout << "Deque elements: ";
+        
+        // Traverse from front to rear
+        for (int i = 0; i < count; i++) {
+            cout << data[(front + i) & capacityMask] << (i + 1 < count ? " " : "");
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 7914, 0x3bb5e7c356bb39daULL,
+    "#include <climits>\n#include <cstring>\n#include <type_traits>\n"},
+    {"deque_segmented",
+R"DSLORD(/**
+ * Deque - A Double-ended Queue implementation backed by fixed-size blocks and
+ * a map of block pointers, like std::deque (dslord: -deque:segmented).
+ *
+ * Growing at either end allocates one block and at most moves block pointers
+ * in the map, never elements, so inserting is O(1) without reallocation
+ * stalls and references to elements stay valid until those elements are
+ * deleted. Element i is found with one shift and one mask, so operator[] and
+ * the random-access iterators are O(1). One emptied block is kept as a spare
+ * so pushing and popping across a block boundary does not allocate every time.
+ * Operations:
+ * - insertFront: Insert an element at the front
+ * - insertRear: Insert an element at the rear
+ * - deleteFront: Delete the front element
+ * - deleteRear: Delete the rear element
+ * - getFront: Get the front element
+ * - getRear: Get the rear element
+ * - operator[], get: Access the element at a position from the front
+ * - begin, end: Random-access iterators from front to rear
+ * - isEmpty: Check if the deque is empty
+ * - isFull: Check if the deque is full (never true)
+ * - size: Get the number of elements in the deque
+ */
+class Deque {
+public:
+    // Element type (dslord: -deque:T=<type>)
+    typedef int ValueType;
+    
+private:
+    // Elements per block, a power of two so a position splits with a shift and a mask
+    static const int BLOCK_BITS = 10;
+    static const size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+    static const size_t BLOCK_MASK = BLOCK_SIZE - 1;
+    
+    // Smallest block map
+    static const size_t MIN_MAP_SIZE = 8;
+    
+    ValueType** map;      // block pointers; blocks in use are map[mapStart, mapStart + blockCount)
+    size_t mapSize;
+    size_t mapStart;
+    size_t blockCount;
+    size_t offset;        // position of the front element in map[mapStart]
+    size_t count;
+    ValueType* spareBlock;  // an emptied block kept for reuse, or nullptr
+    
+    ValueType* allocateBlock() {
+        ValueType* block = spareBlock;
+        if (block) {
+            spareBlock = nullptr;
+        } else {
+            block = new ValueType[BLOCK_SIZE];
+        }
+        return block;
+    }
+    
+    void releaseBlock(ValueType* block) {
+        if (spareBlock) {
+            delete[] block;
+        } else {
+            spareBlock = block;
+        }
+    }
+    
+    // Make room for one more block pointer at either end of the map. When the
+    // map is at most half used the blocks are recentered in place, otherwise
+    // they move to a map twice as large; either way only pointers move.
+    void remap() {
+        size_t newSize = (blockCount + 1) * 2 <= mapSize ? mapSize : mapSize * 2;
+        size_t newStart = (newSize - blockCount) / 2;
+        if (newSize == mapSize) {
+            memmove(map + newStart, map + mapStart, blockCount * sizeof(ValueType*));
+        } else {
+            ValueType** newMap = new ValueType*[newSize];
+            memcpy(newMap + newStart, map + mapStart, blockCount * sizeof(ValueType*));
+            delete[] map;
+            map = newMap;
+            mapSize = newSize;
+        }
+        mapStart = newStart;
+    }
+    
+    void addBlockFront() {
+        if (mapStart == 0) {
+            remap();
+        }
+        map[--mapStart] = allocateBlock();
+        blockCount++;
+        offset += BLOCK_SIZE;
+    }
+    
+    void addBlockRear() {
+        if (mapStart + blockCount == mapSize) {
+            remap();
+        }
+        map[mapStart + blockCount++] = allocateBlock();
+    }
+    
+    // Release the last block once the deque is empty, recentering the map
+    void resetIfEmpty() {
+        if (count == 0 && blockCount > 0) {
+            releaseBlock(map[mapStart]);
+            blockCount = 0;
+            offset = 0;
+            mapStart = mapSize / 2;
+        }
+    }
+    
+    // Element at a position counted from the start of the first block
+    ValueType& slot(size_t position) const {
+        return map[mapStart + (position >> BLOCK_BITS)][position & BLOCK_MASK];
+    }
+    
+    // Iterator over positions from the front; it stays valid while no element
+    // is inserted or deleted at the front
+    template <typename Reference, typename Pointer>
+    class Iterator {
+    public:
+        typedef random_access_iterator_tag iterator_category;
+        typedef ValueType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Pointer pointer;
+        typedef Reference reference;
+        
+        Iterator() : deque(nullptr), index(0) {}
+        
+        // An iterator converts to a const_iterator
+        operator Iterator<const ValueType&, const ValueType*>() const {
+            return Iterator<const ValueType&, const ValueType*>(deque, index);
+        }
+        
+        Reference operator*() const { return deque->slot(deque->offset + index); }
+        Pointer operator->() const { return &deque->slot(deque->offset + index); }
+        Reference operator[](difference_type n) const { return deque->slot(deque->offset + index + n); }
+        
+        Iterator& operator++() { index++; return *this; }
+        Iterator operator++(int) { Iterator old = *this; index++; return old; }
+        Iterator& operator--() { index--; return *this; }
+        Iterator operator--(int) { Iterator old = *this; index--; return old; }
+        Iterator& operator+=(difference_type n) { index += n; return *this; }
+        Iterator& operator-=(difference_type n) { index -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(deque, index + n); }
+        Iterator operator-(difference_type n) const { return Iterator(deque, index - n); }
+        friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+        
+        // Differences and comparisons also mix iterators with const_iterators
+        template <typename R, typename P>
+        difference_type operator-(const Iterator<R, P>& other) const { return (difference_type)(index - other.index); }
+        template <typename R, typename P>
+        bool operator==(const Iterator<R, P>& other) const { return index == other.index; }
+        template <typename R, typename P>
+        bool operator!=(const Iterator<R, P>& other) const { return index != other.index; }
+        template <typename R, typename P>
+        bool operator<(const Iterator<R, P>& other) const { return index < other.index; }
+        template <typename R, typename P>
+        bool operator>(const Iterator<R, P>& other) const { return index > other.index; }
+        template <typename R, typename P>
+        bool operator<=(const Iterator<R, P>& other) const { return index <= other.index; }
+        template <typename R, typename P>
+        bool operator>=(const Iterator<R, P>& other) const { return index >= other.index; }
+        
+    private:
+        friend class Deque;
+        template <typename R, typename P>
+        friend class Iterator;
+        Iterator(const Deque* deque, size_t index) : deque(deque), index(index) {}
+        const Deque* deque;
+        size_t index;
+    };
+    
+public:
+    typedef Iterator<ValueType&, ValueType*> iterator;
+    typedef Iterator<const ValueType&, const ValueType*> const_iterator;
+    
+    // Constructor
+    Deque() : map(new ValueType*[MIN_MAP_SIZE]), mapSize(MIN_MAP_SIZE), mapStart(MIN_MAP_SIZE / 2),
+              blockCount(0), offset(0), count(0), spareBlock(nullptr) {}
+    
+    // Destructor
+    ~Deque() {
+        for (size_t i = 0; i < blockCount; i++) {
+            delete[] map[mapStart + i];
+        }
+        delete[] map;
+        delete[] spareBlock;
+    }
+    
+    // Copy constructor
+    Deque(const Deque& other) : Deque() {
+        for (size_t i = 0; i < other.count; i++) {
+            insertRear(other[i]);
+        }
+    }
+    
+    // Assignment operator
+    Deque& operator=(const Deque& other) {
+        if (this != &other) {
+            Deque copy(other);
+            swap(map, copy.map);
+            swap(mapSize, copy.mapSize);
+            swap(mapStart, copy.mapStart);
+            swap(blockCount, copy.blockCount);
+            swap(offset, copy.offset);
+            swap(count, copy.count);
+            swap(spareBlock, copy.spareBlock);
+        }
+        return *this;
+    }
+    
+)DSLORD"
+R"DSLORD(    // Check if the deque is full (never: it grows a block at a time)
+    bool isFull() const {
+        return false;
+    }
+    
+    // Check if the deque is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    // Insert an element at the front
+    void insertFront(const ValueType& value) {
+        if (offset == 0) {
+            addBlockFront();
+        }
+        
+        slot(offset - 1) = value;
+        offset--;
+        count++;
+    }
+    
+    // Insert an element at the rear
+    void insertRear(const ValueType& value) {
+        if (offset + count == blockCount * BLOCK_SIZE) {
+            addBlockRear();
+        }
+        
+        slot(offset + count) = value;
+        count++;
+    }
+    
+    // Delete the front element
+    ValueType deleteFront() {
+        if (isEmpty()) {
+            throw underflow_error("Deque Underflow");
+        }
+        
+        ValueType value = slot(offset);
+        offset++;
+        count--;
+        if (offset == BLOCK_SIZE && count > 0) {
+            releaseBlock(map[mapStart++]);
+            blockCount--;
+            offset = 0;
+        }
+        resetIfEmpty();
+        return value;
+    }
+    
+    // Delete the rear element
+    ValueType deleteRear() {
+        if (isEmpty()) {
+            throw underflow_error("Deque Underflow");
+        }
+        
+        count--;
+        ValueType value = slot(offset + count);
+        if (((offset + count) & BLOCK_MASK) == 0 && count > 0) {
+            releaseBlock(map[mapStart + --blockCount]);
+        }
+        resetIfEmpty();
+        return value;
+    }
+    
+    // Get the front element
+    ValueType getFront() const {
+        if (isEmpty()) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return slot(offset);
+    }
+    
+    // Get the rear element
+    ValueType getRear() const {
+        if (isEmpty()) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return slot(offset + count - 1);
+    }
+    
+    // Element at a position from the front (unchecked)
+    ValueType& operator[](size_t position) {
+        return slot(offset + position);
+    }
+    
+    const ValueType& operator[](size_t position) const {
+        return slot(offset + position);
+    }
+    
+    // Get the element at a position from the front
+    ValueType get(size_t position) const {
+        if (position >= count) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return slot(offset + position);
+    }
+    
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+    
+    // Get the number of elements in the deque
+    size_t size() const {
+        return count;
+    }
+    
+    // Display all elements in the deque
+    void display() const {
+        if (isEmpty()) {
+            cout << "Deque is empty" << endl;
+            return;
+        }
+        
+        cout << "Deque elements: ";
+        
+        // Traverse from front to rear
+        for (size_t i = 0; i < count; i++) {
+            cout << slot(offset + i) << (i + 1 < count ? " " : "");
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 11443, 0x5f901194d65724efULL,
+    "#include <cstddef>\n#include <cstring>\n#include <iostream>\n#include <iterator>\n"},
+    {"deque_workstealing",
+R"DSLORD(/**
+ * Deque - A lock-free work-stealing double-ended queue (Chase-Lev, with the
+ * C11 memory orderings of Le et al.) for task schedulers (dslord: -deque:workstealing).
+ *
+ * One owner thread inserts and deletes at the rear; any thread may steal from
+ * the front. The owner only touches its `bottom` index and issues a fence, so
+ * pushing and popping need no atomic read-modify-write unless a thief and the
+ * owner race for the last element. Thieves claim elements with one
+ * compare-and-swap on `top`. The circular buffer doubles when full; a thief
+ * may still be reading the old buffer, so retired buffers are only freed by
+ * the destructor (at most as much memory again as the final buffer).
+ * Elements are read by thieves before they are claimed, so ValueType must be
+ * trivially copyable (a task pointer or index, typically).
+ * Operations:
+ * - insertRear: Insert an element at the rear (owner only)
+ * - deleteRear, tryDeleteRear: Delete the rear element (owner only)
+ * - deleteFront, trySteal: Steal the front element (any thread)
+ * - getRear: Get the rear element (owner only)
+ * - isEmpty: Check if the deque is empty
+ * - isFull: Check if the deque is full (never true)
+ * - size: Get the number of elements in the deque
+ */
+class Deque {
+public:
+    // Element type (dslord: -deque:T=<type>)
+    typedef int ValueType;
+    
+private:
+    static_assert(is_trivially_copyable<ValueType>::value, "Work-stealing Deque elements must be trivially copyable");
+    
+    // Initial capacity, a power of two
+    static const int64_t INITIAL_CAPACITY = 64;
+    static const size_t CACHE_LINE = 64;
+    
+    // Circular storage indexed by the free-running top and bottom counters
+    struct Buffer {
+        int64_t mask;
+        atomic<ValueType>* slots;
+        
+        explicit Buffer(int64_t capacity) : mask(capacity - 1), slots(new atomic<ValueType>[capacity]) {}
+        ~Buffer() {
+            delete[] slots;
+        }
+        
+        ValueType get(int64_t index) const {
+            return slots[index & mask].load(memory_order_relaxed);
+        }
+        void put(int64_t index, ValueType value) {
+            slots[index & mask].store(value, memory_order_relaxed);
+        }
+    };
+    
+    alignas(CACHE_LINE) atomic<int64_t> top;     // next element to steal
+    alignas(CACHE_LINE) atomic<int64_t> bottom;  // next free slot at the rear (owner)
+    atomic<Buffer*> buffer;
+    vector<Buffer*> retired;                     // old buffers thieves may still read (owner)
+    
+    // Copy [top, bottom) into a buffer twice as large and publish it
+    Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+        Buffer* larger = new Buffer((old->mask + 1) * 2);
+        for (int64_t i = t; i < b; i++) {
+            larger->put(i, old->get(i));
+        }
+        retired.push_back(old);
+        buffer.store(larger, memory_order_release);
+        return larger;
+    }
+    
+    // One steal attempt: 1 stolen, 0 empty, -1 lost a race (worth retrying)
+    int stealOnce(ValueType& value) {
+        int64_t t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = bottom.load(memory_order_acquire);
+        if (t >= b) {
+            return 0;
+        }
+        
+        value = buffer.load(memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            return -1;
+        }
+        return 1;
+    }
+    
+public:
+    // Constructor
+    Deque() : top(0), bottom(0), buffer(new Buffer(INITIAL_CAPACITY)) {}
+    
+    // Destructor (no other thread may still be using the deque)
+    ~Deque() {
+        delete buffer.load(memory_order_relaxed);
+        for (Buffer* old : retired) {
+            delete old;
+        }
+    }
+    
+    // Thieves hold on to the deque, so it cannot be copied
+    Deque(const Deque&) = delete;
+    Deque& operator=(const Deque&) = delete;
+    
+    // Check if the deque is full (never: the buffer grows)
+    bool isFull() const {
+        return false;
+    }
+    
+    // Check if the deque is empty (a snapshot under concurrent use)
+    bool isEmpty() const {
+        return size() == 0;
+    }
+    
+    // Insert an element at the rear (owner only)
+    void insertRear(const ValueType& value) {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_acquire);
+        Buffer* current = buffer.load(memory_order_relaxed);
+        if (b - t > current->mask) {
+            current = grow(current, t, b);
+        }
+        
+        current->put(b, value);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
+    }
+    
+    // Delete the rear element into `value`; false when the deque is empty or
+    // a thief took the last element (owner only)
+    bool tryDeleteRear(ValueType& value) {
+        int64_t b = bottom.load(memory_order_relaxed) - 1;
+        Buffer* current = buffer.load(memory_order_relaxed);
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = top.load(memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);
+            return false;
+        }
+        
+        value = current->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+            bottom.store(b + 1, memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    
+    // Delete the rear element (owner only)
+    ValueType deleteRear() {
+        ValueType value;
+        if (!tryDeleteRear(value)) {
+            throw underflow_error("Deque Underflow");
+        }
+        return value;
+    }
+    
+    // Steal the front element into `value`; false when the deque is empty or
+    // another thread won the race for it (any thread)
+    bool trySteal(ValueType& value) {
+        return stealOnce(value) == 1;
+    }
+    
+    // Steal the front element, retrying lost races (any thread)
+    ValueType deleteFront() {
+        ValueType value;
+        int result;
+        while ((result = stealOnce(value)) < 0) {
+        }
+        if (result == 0) {
+            throw underflow_error("Deque Underflow");
+        }
+        return value;
+    }
+    
+    // Get the rear element (owner only; a thief may steal it meanwhile)
+    ValueType getRear() const {
+        int64_t b = bottom.load(memory_order_relaxed);
+        if (top.load(memory_order_acquire) >= b) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return buffer.load(memory_order_relaxed)->get(b - 1);
+    }
+    
+    // Get the number of elements in the deque (a snapshot under concurrent use)
+    int size() const {
+        int64_t b = bottom.load(memory_order_acquire);
+        int64_t t = top.load(memory_order_acquire);
+        return (int)max((int64_t)0, b - t);
+    }
+    
+    // Display all elements in the deque (for debugging, while no thread is using it)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Deque is empty" << endl;
+            return;
+        }
+        
+        cout << "Deque elements: ";
+        
+        // Traverse from front to rear
+        Buffer* current = buffer.load(memory_order_acquire);
+        int64_t b = bottom.load(memory_order_acquire);
+        for (int64_t i = top.load(memory_order_acquire); i < b; i++) {
+            cout << current->get(i) << (i + 1 < b ? " " : "");
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 7565, 0x2dcbdde7a0eee35aULL,
+    "#include <atomic>\n#include <cstdint>\n#include <iostream>\n#include <type_traits>\n#include <vector>\n"},
+    {"array",
+R"DSLORD(/**
+ * DynamicArray - A Dynamic Array implementation (similar to C++ vector)
+ *
+ * Trivially copyable elements are stored in malloc'd memory. Growing that
+ * memory with realloc usually extends it in place, and glibc moves large
+ * blocks with mremap instead of copying them. Those elements are also
+ * shifted and copied with memmove/memcpy. Other element types are moved one
+ * at a time.
+ * Scans over 4- and 8-byte arithmetic elements (sum, min, max, minMaxIndex,
+ * count, find) run on SSE2, AVX2 or AVX-512 vectors, picked at runtime from
+ * what the CPU supports; other element types and compilers use plain loops.
+ * The parallel algorithms split arrays larger than a grain (32768 elements by
+ * default, see setParallelGrain) across a work-stealing pool shared by all
+ * arrays; smaller arrays are processed sequentially.
+ * Operations:
+ * - pushBack, emplaceBack: Add an element to the end of the array
+ * - popBack: Remove the last element
+ * - insert: Insert an element at a specific position
+ * - insertRange: Insert a block of elements at a specific position
+ * - removeAt: Remove an element at a specific position
+ * - eraseRange: Remove the elements in a range of positions
+ * - get: Get the element at a specific position
+ * - set: Set the element at a specific position
+ * - reserve: Make room for a number of elements up front
+ * - size: Get the number of elements in the array
+ * - capacity: Get the current capacity of the array
+ * - isEmpty: Check if the array is empty
+ * - clear: Remove all elements
+ * - sum, min, max, minMaxIndex: Reduce the elements in one pass
+ * - count, find: Count or locate the elements equal to a value
+ * - parallelSort, parallelTransform, parallelReduce, parallelPrefixSum:
+ *   Process large arrays on a shared work-stealing thread pool
+ */
+class DynamicArray {
+public:
+    // Element type (dslord: -array:T=<type>)
+    typedef int ValueType;
+private:
+    // Whether the storage comes from malloc and grows with realloc
+    static const bool REALLOCATABLE = is_trivially_copyable<ValueType>::value &&
+                                      alignof(ValueType) <= alignof(max_align_t);
+    
+    ValueType* data;
+    int arraySize;
+    int arrayCapacity;
+    int reservedCapacity;  // the largest reserve(); shrinking stops there
+    
+    static ValueType* allocate(int capacity) {
+        if (REALLOCATABLE) {
+            void* block = malloc((size_t)std::max(capacity, 1) * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            return static_cast<ValueType*>(block);
+        }
+        return new ValueType[capacity];
+    }
+    
+    static void release(ValueType* block) {
+        if (REALLOCATABLE) {
+            free(block);
+        } else {
+            delete[] block;
+        }
+    }
+    
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    
+    // Move n elements to a range that may overlap, as one memmove when the type allows
+    static void moveElements(ValueType* to, ValueType* from, int n) {
+        if (n <= 0 || to == from) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else if (to < from) {
+            for (int i = 0; i < n; i++) {
+                to[i] = move(from[i]);
+            }
+        } else {
+            for (int i = n - 1; i >= 0; i--) {
+                to[i] = move(from[i]);
+            }
+        }
+    }
+    
+    // Resize the array when needed
+    void resize(int newCapacity) {
+        if (REALLOCATABLE) {
+            void* block = realloc(static_cast<void*>(data), (size_t)std::max(newCapacity, 1) * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            data = static_cast<ValueType*>(block);
+        } else {
+            ValueType* newData = new ValueType[newCapacity];
+            moveElements(newData, data, arraySize);
+            delete[] data;
+            data = newData;
+        }
+        arrayCapacity = newCapacity;
+    }
+    
+    // Double the capacity until `needed` elements fit, stopping at INT_MAX
+    void ensureCapacity(long long needed) {
+        if (needed > INT_MAX) {
+            throw length_error("Array cannot hold more than INT_MAX elements");
+        }
+        if (needed > arrayCapacity) {
+            long long newCapacity = std::max(arrayCapacity, 1);
+            while (newCapacity < needed) {
+                newCapacity *= 2;
+            }
+            resize((int)std::min(newCapacity, (long long)INT_MAX));
+        }
+    }
+    
+    // Halve the capacity while at most a quarter of it is used, but never below
+    // what reserve() asked for
+    void shrinkIfSparse() {
+        int newCapacity = arrayCapacity;
+        while (arraySize > 0 && arraySize <= newCapacity / 4 && newCapacity / 2 >= reservedCapacity) {
+            newCapacity /= 2;
+        }
+        if (newCapacity != arrayCapacity) {
+            resize(newCapacity);
+        }
+    }
+    
+    // Make room for n elements at a position, shifting the tail once
+    void openGap(int position, int n) {
+        ensureCapacity((long long)arraySize + n);
+        moveElements(data + position + n, data + position, arraySize - position);
+        arraySize += n;
+    }
+public:
+    // Constructor
+    DynamicArray(int initialCapacity = 10) : arraySize(0), reservedCapacity(0) {
+        if (initialCapacity <= 0) {
+            initialCapacity = 10;
+        }
+        
+        data = allocate(initialCapacity);
+        arrayCapacity = initialCapacity;
+    }
+    
+    // Destructor
+    ~DynamicArray() {
+        release(data);
+    }
+    
+    // Copy constructor
+    DynamicArray(const DynamicArray& other)
+        : arraySize(other.arraySize), arrayCapacity(other.arrayCapacity), reservedCapacity(other.reservedCapacity) {
+        data = allocate(arrayCapacity);
+        copyElements(data, other.data, arraySize);
+    }
+    
+    // Move constructor; `other` is left empty with no storage
+    DynamicArray(DynamicArray&& other) noexcept
+        : data(other.data), arraySize(other.arraySize), arrayCapacity(other.arrayCapacity), reservedCapacity(other.reservedCapacity) {
+        other.data = nullptr;
+        other.arraySize = 0;
+        other.arrayCapacity = 0;
+        other.reservedCapacity = 0;
+    }
+    
+    // Assignment operator
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            DynamicArray copy(other);
+            swap(data, copy.data);
+            swap(arraySize, copy.arraySize);
+            swap(arrayCapacity, copy.arrayCapacity);
+            swap(reservedCapacity, copy.reservedCapacity);
+        }
+        
+        return *this;
+    }
+    
+    // Move assignment operator; `other` is left empty with no storage
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            release(data);
+            data = other.data;
+            arraySize = other.arraySize;
+            arrayCapacity = other.arrayCapacity;
+            reservedCapacity = other.reservedCapacity;
+            other.data = nullptr;
+            other.arraySize = 0;
+            other.arrayCapacity = 0;
+            other.reservedCapacity = 0;
+        }
+        
+        return *this;
+    }
+    
+    // Add an element to the end of the array
+    void pushBack(const ValueType& value) {
+        emplaceBack(value);
+    }
+    
+    void pushBack(ValueType&& value) {
+        emplaceBack(move(value));
+    }
+    
+    // Construct an element at the end of the array from `args`
+    template <typename... Args>
+    ValueType& emplaceBack(Args&&... args) {
+        if (arraySize >= arrayCapacity) {
+)DSLORD"
+R"DSLORD(            // Build the element before growing, as args may refer into the array
+            ValueType value(forward<Args>(args)...);
+            ensureCapacity((long long)arraySize + 1);
+            data[arraySize] = move(value);
+        } else if (REALLOCATABLE) {
+            new (data + arraySize) ValueType(forward<Args>(args)...);
+        } else {
+            data[arraySize] = ValueType(forward<Args>(args)...);
+        }
+        
+        return data[arraySize++];
+    }
+    
+    // Remove the last element
+    void popBack() {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        arraySize--;
+        
+        // Optionally shrink the array if it gets too empty
+        shrinkIfSparse();
+    }
+    
+    // Insert an element at a specific position
+    void insert(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Copy first, as value may be an element of this array
+        ValueType element(value);
+        openGap(position, 1);
+        data[position] = move(element);
+    }
+    
+    // Insert n elements at a specific position, shifting the elements after
+    // it once; `values` must not point into this array
+    void insertRange(int position, const ValueType* values, int n) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        if (n <= 0) {
+            return;
+        }
+        
+        openGap(position, n);
+        copyElements(data + position, values, n);
+    }
+    
+    // Remove an element at a specific position
+    void removeAt(int position) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        eraseRange(position, position + 1);
+    }
+    
+    // Remove the elements at positions [first, last), shifting the elements
+    // after them once
+    void eraseRange(int first, int last) {
+        // Check if the range is valid
+        if (first < 0 || first > last || last > arraySize) {
+            throw out_of_range("Invalid range");
+        }
+        
+        moveElements(data + first, data + last, arraySize - last);
+        arraySize -= last - first;
+        
+        // Optionally shrink the array if it gets too empty
+        shrinkIfSparse();
+    }
+    
+    // Get the element at a specific position
+    ValueType get(int position) const {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return data[position];
+    }
+    
+    // Set the element at a specific position
+    void set(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        data[position] = value;
+    }
+    
+    // Make room for at least n elements, so filling up to n never reallocates;
+    // removing elements never shrinks the array below n either
+    void reserve(int n) {
+        reservedCapacity = std::max(reservedCapacity, n);
+        if (n > arrayCapacity) {
+            resize(n);
+        }
+    }
+    
+    // Get the number of elements in the array
+    int size() const {
+        return arraySize;
+    }
+    
+    // Get the current capacity of the array
+    int capacity() const {
+        return arrayCapacity;
+    }
+    
+    // Check if the array is empty
+    bool isEmpty() const {
+        return arraySize == 0;
+    }
+    
+    // Remove all elements
+    void clear() {
+        arraySize = 0;
+        
+        // Optionally shrink the array, keeping any reserved capacity
+        int keep = std::max(10, reservedCapacity);
+        if (arrayCapacity > keep) {
+            resize(keep);
+        }
+    }
+    
+    // Vector scans and parallel algorithms, shared by every DynamicArray variant
+    // (dslord splices them in from snippets/fragments/array_algorithms.cpp). They
+    // use the variant's ValueType, data, arraySize, isEmpty() and moveElements(),
+    // and need the elements to be contiguous in data.
+public:
+    // Type sum() adds in: 64-bit for integers, ValueType otherwise
+    typedef conditional<is_integral<ValueType>::value,
+                        conditional<is_signed<ValueType>::value, long long, unsigned long long>::type,
+                        ValueType>::type SumType;
+    
+    // Vector instruction sets the scans can use, narrowest first
+    enum SimdLevel {
+        SIMD_SCALAR,  // plain loops
+        SIMD_SSE2,    // 16-byte vectors (SSE2, or NEON and the like off x86)
+        SIMD_AVX2,    // 32-byte vectors
+        SIMD_AVX512   // 64-byte vectors (AVX-512F)
+    };
+private:
+    // Element types the vector kernels handle: 4- and 8-byte arithmetic types
+    template <typename E>
+    struct VectorScanSupported {
+#if defined(__GNUC__)
+        static const bool value = is_arithmetic<E>::value && !is_same<E, bool>::value && (sizeof(E) == 4 || sizeof(E) == 8);
+#else
+        static const bool value = false;
+#endif
+    };
+    
+    // A scan over [data, data + n) and its results; the vector and scalar paths fill the same fields
+    template <typename E>
+    struct ScanJob {
+        enum Kind { SUM, MIN_MAX, MIN_MAX_INDEX, COUNT, FIND } kind;
+        const E* data;
+        int n;
+        const E* value;  // COUNT, FIND
+        SumType sum;     // SUM
+        E min, max;      // MIN_MAX
+        int minIndex, maxIndex;  // MIN_MAX_INDEX
+        int result;      // COUNT, FIND (-1 when not found)
+    };
+    
+    static SimdLevel detectSimdLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SIMD_AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SIMD_AVX2;
+        }
+        return __builtin_cpu_supports("sse2") ? SIMD_SSE2 : SIMD_SCALAR;
+#elif defined(__GNUC__)
+        return SIMD_SSE2;  // 16-byte vectors, e.g. NEON
+#else
+        return SIMD_SCALAR;
+#endif
+    }
+    
+    static SimdLevel& simdSetting() {
+        static SimdLevel level = detectSimdLevel();
+        return level;
+    }
+    
+    // The plain loops, for every element type and as the reference for the kernels
+    template <typename E>
+    static void scalarScan(ScanJob<E>& job) {
+        const E* p = job.data;
+        switch (job.kind) {
+        case ScanJob<E>::SUM:
+            job.sum = SumType();
+            for (int i = 0; i < job.n; i++) {
+                job.sum += p[i];
+            }
+            break;
+        case ScanJob<E>::MIN_MAX:
+        case ScanJob<E>::MIN_MAX_INDEX:
+            job.minIndex = job.maxIndex = 0;
+            for (int i = 1; i < job.n; i++) {
+                if (p[i] < p[job.minIndex]) {
+                    job.minIndex = i;
+                }
+                if (p[job.maxIndex] < p[i]) {
+                    job.maxIndex = i;
+                }
+            }
+            job.min = p[job.minIndex];
+            job.max = p[job.maxIndex];
+            break;
+        case ScanJob<E>::COUNT:
+            job.result = 0;
+            for (int i = 0; i < job.n; i++) {
+                job.result += p[i] == *job.value;
+            }
+            break;
+        case ScanJob<E>::FIND:
+            job.result = -1;
+            for (int i = 0; i < job.n; i++) {
+                if (p[i] == *job.value) {
+                    job.result = i;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    
+#if defined(__GNUC__)
+    // Kernels over BYTES-wide vectors of E, written with GCC/Clang vector
+    // extensions. They are inlined into the scan128/256/512 entry points, whose
+    // target attribute makes the compiler emit SSE2, AVX2 or AVX-512 code.
+    template <typename E, int BYTES>
+    struct VectorScan {
+        static const int LANES = BYTES / sizeof(E);
+        typedef E Vector __attribute__((vector_size(BYTES)));
+)DSLORD"
+R"DSLORD(        typedef typename conditional<sizeof(E) == 4, int32_t, int64_t>::type MaskLane;
+        typedef MaskLane Mask __attribute__((vector_size(BYTES)));
+        // Sums widen E to SumType, so a load of NARROW bytes fills one accumulator
+        static const int SUM_LANES = BYTES / sizeof(SumType);
+        typedef E Narrow __attribute__((vector_size(SUM_LANES * sizeof(E))));
+        typedef typename conditional<true, SumType, E>::type SumLane;  // dependent, so vector_size applies
+        typedef SumLane Sums __attribute__((vector_size(BYTES)));
+        
+        static inline __attribute__((always_inline)) SumType sum(const E* p, int n) {
+            Sums acc = {};
+            int i = 0;
+            // 16-byte vectors have no widening load before SSE4.1; the compiler
+            // vectorizes the plain loop below better than convertvector then
+            const bool WIDENS = sizeof(E) < sizeof(SumType);
+            for (; !(BYTES == 16 && WIDENS) && i + SUM_LANES <= n; i += SUM_LANES) {
+                Narrow v;
+                memcpy(&v, p + i, sizeof v);
+                acc += __builtin_convertvector(v, Sums);
+            }
+            SumType total = SumType();
+            for (int l = 0; l < SUM_LANES; l++) {
+                total += acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i];
+            }
+            return total;
+        }
+        
+        // Smallest and largest element of a non-empty range. Every lane starts
+        // at p[0], so as in the plain loops a NaN is never taken unless it is p[0].
+        static inline __attribute__((always_inline)) void minMax(const E* p, int n, E& lo, E& hi) {
+            int i = 0;
+            lo = hi = p[0];
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    vlo = v < vlo ? v : vlo;
+                    vhi = vhi < v ? v : vhi;
+                }
+                lo = vlo[0];
+                hi = vhi[0];
+                for (int l = 1; l < LANES; l++) {
+                    lo = vlo[l] < lo ? vlo[l] : lo;
+                    hi = hi < vhi[l] ? vhi[l] : hi;
+                }
+            }
+            for (; i < n; i++) {
+                lo = p[i] < lo ? p[i] : lo;
+                hi = hi < p[i] ? p[i] : hi;
+            }
+        }
+        
+        // Positions of the first smallest and the first largest element of a
+        // non-empty range, in one pass: each lane keeps its best values and where
+        // it saw them, starting at p[0] like minMax, and ties between lanes go to
+        // the earlier position
+        static inline __attribute__((always_inline)) void minMaxIndex(const E* p, int n, int& lo, int& hi) {
+            int i = 0;
+            lo = hi = 0;
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                Mask ilo = {}, ihi = {}, index;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                    index[l] = l;
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    Mask less = (Mask)(v < vlo);
+                    Mask more = (Mask)(vhi < v);
+                    vlo = less ? v : vlo;
+                    ilo = less ? index : ilo;
+                    vhi = more ? v : vhi;
+                    ihi = more ? index : ihi;
+                    index += LANES;
+                }
+                for (int l = 0; l < LANES; l++) {
+                    if (vlo[l] < p[lo] || (!(p[lo] < vlo[l]) && ilo[l] < lo)) {
+                        lo = (int)ilo[l];
+                    }
+                    if (p[hi] < vhi[l] || (!(vhi[l] < p[hi]) && ihi[l] < hi)) {
+                        hi = (int)ihi[l];
+                    }
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] < p[lo]) {
+                    lo = i;
+                }
+                if (p[hi] < p[i]) {
+                    hi = i;
+                }
+            }
+        }
+        
+        static inline __attribute__((always_inline)) int count(const E* p, int n, E x) {
+            // Matching lanes are -1, so subtracting counts them; a lane sees at most n / LANES matches
+            Mask acc = {};
+            int i = 0;
+            for (; i + LANES <= n; i += LANES) {
+                Vector v;
+                memcpy(&v, p + i, sizeof v);
+                acc -= (Mask)(v == x);
+            }
+            int total = 0;
+            for (int l = 0; l < LANES; l++) {
+                total += (int)acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i] == x;
+            }
+            return total;
+        }
+        
+        static inline __attribute__((always_inline)) int find(const E* p, int n, E x) {
+            // Compare a block of vectors, reduce the match mask once, and only
+            // search the block element by element when it holds a match
+            const int BLOCK = 16 * LANES;
+            int i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                Mask matches = {};
+                for (int j = 0; j < BLOCK; j += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i + j, sizeof v);
+                    matches |= (Mask)(v == x);
+                }
+                MaskLane any = 0;
+                for (int l = 0; l < LANES; l++) {
+                    any |= matches[l];
+                }
+                if (any) {
+                    break;
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] == x) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        
+        static inline __attribute__((always_inline)) void run(ScanJob<E>& job) {
+            switch (job.kind) {
+            case ScanJob<E>::SUM:
+                job.sum = sum(job.data, job.n);
+                break;
+            case ScanJob<E>::MIN_MAX:
+                minMax(job.data, job.n, job.min, job.max);
+                break;
+            case ScanJob<E>::MIN_MAX_INDEX:
+                minMaxIndex(job.data, job.n, job.minIndex, job.maxIndex);
+                job.min = job.data[job.minIndex];
+                job.max = job.data[job.maxIndex];
+                break;
+            case ScanJob<E>::COUNT:
+                job.result = count(job.data, job.n, *job.value);
+                break;
+            case ScanJob<E>::FIND:
+                job.result = find(job.data, job.n, *job.value);
+                break;
+            }
+        }
+    };
+    
+#if defined(__x86_64__) || defined(__i386__)
+    template <typename E>
+    __attribute__((target("avx512f"))) static void scan512(ScanJob<E>& job) {
+        VectorScan<E, 64>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("avx2"))) static void scan256(ScanJob<E>& job) {
+        VectorScan<E, 32>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("sse2"))) static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#else
+    template <typename E>
+    static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>& job, true_type) {
+        switch (simdLevel()) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SIMD_AVX512:
+            scan512(job);
+            return true;
+        case SIMD_AVX2:
+            scan256(job);
+            return true;
+#endif
+        case SIMD_SCALAR:
+            return false;
+        default:
+            scan128(job);
+            return true;
+        }
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>&, false_type) {
+        return false;
+    }
+    
+    // Run a scan with the kernels for simdLevel(), or the plain loops
+    template <typename E>
+    static void runScan(ScanJob<E>& job) {
+)DSLORD"
+R"DSLORD(        if (!vectorScan(job, integral_constant<bool, VectorScanSupported<E>::value>())) {
+            scalarScan(job);
+        }
+    }
+    
+    template <typename E>
+    ScanJob<E> scanJob(typename ScanJob<E>::Kind kind, const E* value = nullptr) const {
+        ScanJob<E> job = ScanJob<E>();
+        job.kind = kind;
+        job.data = data;
+        job.n = arraySize;
+        job.value = value;
+        return job;
+    }
+    
+    // Tasks spawned by one parallel call; wait() returns once all have run
+    struct TaskGroup {
+        atomic<int> pending;
+        mutex errorLock;
+        exception_ptr error;  // the first exception a task threw
+        
+        TaskGroup() : pending(0) {}
+        
+        void fail(exception_ptr exception) {
+            lock_guard<mutex> lock(errorLock);
+            if (!error) {
+                error = exception;
+            }
+        }
+    };
+    
+    // Fork-join pool shared by the parallel algorithms of every array: a worker
+    // per hardware thread but one, as the calling thread runs tasks while it
+    // waits. Each worker has its own task deque. Owners push and pop at the
+    // back, and idle threads steal from the front, where the largest pieces of
+    // a halved range are. Tasks are at least a grain of elements, so a mutex per
+    // deque costs little next to the work it hands out.
+    class WorkPool {
+    public:
+        static WorkPool& instance() {
+            static WorkPool pool;
+            return pool;
+        }
+        
+        int workerCount() const {
+            return (int)workers.size();
+        }
+        
+        // Queue a task on the calling thread's deque
+        void spawn(TaskGroup& group, function<void()> task) {
+            group.pending.fetch_add(1, memory_order_relaxed);
+            TaskQueue& queue = queues[queueIndex()];
+            {
+                lock_guard<mutex> lock(queue.lock);
+                queue.tasks.push_back(Task{move(task), &group});
+            }
+            queued.fetch_add(1, memory_order_release);
+            {
+                lock_guard<mutex> lock(sleepLock);
+            }
+            wakeUp.notify_one();
+        }
+        
+        // Run tasks, the group's or others', until the group has finished;
+        // rethrows the first exception one of its tasks threw
+        void wait(TaskGroup& group) {
+            while (group.pending.load(memory_order_acquire) > 0) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                } else {
+                    this_thread::yield();
+                }
+            }
+            if (group.error) {
+                rethrow_exception(group.error);
+            }
+        }
+    private:
+        struct Task {
+            function<void()> body;
+            TaskGroup* group;
+        };
+        
+        struct TaskQueue {
+            mutex lock;
+            deque<Task> tasks;
+        };
+        
+        vector<thread> workers;
+        unique_ptr<TaskQueue[]> queues;  // queues[0] for threads outside the pool, then one per worker
+        int queueCount;
+        atomic<int> queued;  // tasks in all queues, so idle threads skip the locks
+        mutex sleepLock;
+        condition_variable wakeUp;
+        bool stopping;
+        
+        WorkPool() : queued(0), stopping(false) {
+            int threads = std::max((int)thread::hardware_concurrency(), 1) - 1;
+            queueCount = threads + 1;
+            queues.reset(new TaskQueue[queueCount]);
+            for (int i = 1; i <= threads; i++) {
+                workers.emplace_back([this, i] {
+                    queueIndex() = i;
+                    workerLoop();
+                });
+            }
+        }
+        
+        ~WorkPool() {
+            {
+                lock_guard<mutex> lock(sleepLock);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        
+        // The deque of the calling thread: 0 unless it is a worker
+        static int& queueIndex() {
+            static thread_local int index = 0;
+            return index;
+        }
+        
+        void workerLoop() {
+            while (true) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                    continue;
+                }
+                unique_lock<mutex> lock(sleepLock);
+                wakeUp.wait(lock, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+                if (stopping) {
+                    return;
+                }
+            }
+        }
+        
+        // Pop the newest task of our own deque, or steal the oldest of another
+        bool take(Task& task) {
+            if (queued.load(memory_order_acquire) == 0) {
+                return false;
+            }
+            int own = queueIndex();
+            for (int i = 0; i < queueCount; i++) {
+                TaskQueue& queue = queues[(own + i) % queueCount];
+                lock_guard<mutex> lock(queue.lock);
+                if (!queue.tasks.empty()) {
+                    if (i == 0) {
+                        task = move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                    } else {
+                        task = move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                    }
+                    queued.fetch_sub(1, memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+        static void run(Task& task) {
+            try {
+                task.body();
+            } catch (...) {
+                task.group->fail(current_exception());
+            }
+            task.group->pending.fetch_sub(1, memory_order_release);
+        }
+    };
+    
+    static int& parallelGrainSetting() {
+        static int grain = 1 << 15;
+        return grain;
+    }
+    
+    // Whether n elements are worth splitting across the pool
+    static bool runsInParallel(int n) {
+        return n > parallelGrain() && WorkPool::instance().workerCount() > 0;
+    }
+    
+    // Run body(begin, end) on pieces of [begin, end) of at most grain
+    // elements, halving the range so that thieves take the largest pieces
+    template <typename Body>
+    static void parallelFor(int begin, int end, int grain, const Body& body) {
+        WorkPool& pool = WorkPool::instance();
+        TaskGroup group;
+        try {
+            splitRange(pool, group, begin, end, grain, body);
+        } catch (...) {
+            group.fail(current_exception());
+        }
+        pool.wait(group);
+    }
+    
+    template <typename Body>
+    static void splitRange(WorkPool& pool, TaskGroup& group, int begin, int end, int grain, const Body& body) {
+        while (end - begin > grain) {
+            int middle = begin + (end - begin) / 2;
+            pool.spawn(group, [&pool, &group, middle, end, grain, &body] {
+                splitRange(pool, group, middle, end, grain, body);
+            });
+            end = middle;
+        }
+        body(begin, end);
+    }
+    
+    // Merge the sorted runs [a, aEnd) and [b, bEnd) into out. Large merges are
+    // split at the middle element of the longer run and its position in the
+    // other run, which divides the output into two independent merges.
+    template <typename Compare>
+    static void mergeRuns(WorkPool& pool, TaskGroup& group, ValueType* a, ValueType* aEnd, ValueType* b, ValueType* bEnd,
+                          ValueType* out, int grain, const Compare& compare) {
+        while ((aEnd - a) + (bEnd - b) > grain && std::max(aEnd - a, bEnd - b) > 1) {
+            ValueType* aMiddle;
+            ValueType* bMiddle;
+            if (aEnd - a >= bEnd - b) {
+                aMiddle = a + (aEnd - a) / 2;
+                bMiddle = lower_bound(b, bEnd, *aMiddle, compare);
+            } else {
+                bMiddle = b + (bEnd - b) / 2;
+                aMiddle = upper_bound(a, aEnd, *bMiddle, compare);
+            }
+            ValueType* outMiddle = out + (aMiddle - a) + (bMiddle - b);
+)DSLORD"
+R"DSLORD(            pool.spawn(group, [&pool, &group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, &compare] {
+                mergeRuns(pool, group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, compare);
+            });
+            aEnd = aMiddle;
+            bEnd = bMiddle;
+        }
+        merge(make_move_iterator(a), make_move_iterator(aEnd), make_move_iterator(b), make_move_iterator(bEnd), out, compare);
+    }
+public:
+    // Get the vector instruction set the scans use: the widest the CPU
+    // supports, unless lowered with setSimdLevel
+    static SimdLevel simdLevel() {
+        return simdSetting();
+    }
+    
+    // Limit the scans to a level, e.g. SIMD_SCALAR to compare against the
+    // plain loops; levels above what the CPU supports are lowered to it.
+    // Not safe while other threads scan.
+    static void setSimdLevel(SimdLevel level) {
+        simdSetting() = std::min(level, detectSimdLevel());
+    }
+    
+    // Sum of the elements in SumType (0 when empty)
+    template <typename T = ValueType>
+    SumType sum() const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::SUM);
+        runScan(job);
+        return job.sum;
+    }
+    
+    // Get the smallest element
+    template <typename T = ValueType>
+    ValueType min() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.min;
+    }
+    
+    // Get the largest element
+    template <typename T = ValueType>
+    ValueType max() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.max;
+    }
+    
+    // Get the positions of the first smallest and the first largest element
+    template <typename T = ValueType>
+    pair<int, int> minMaxIndex() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX_INDEX);
+        runScan(job);
+        return make_pair(job.minIndex, job.maxIndex);
+    }
+    
+    // Count the elements equal to value
+    template <typename T = ValueType>
+    int count(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::COUNT, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the position of the first element equal to value, or -1
+    template <typename T = ValueType>
+    int find(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::FIND, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the number of elements below which the parallel algorithms run
+    // sequentially, and the size of the pieces they split the array into
+    static int parallelGrain() {
+        return parallelGrainSetting();
+    }
+    
+    // Set the grain (at least 1). Not safe while other threads run parallel algorithms.
+    static void setParallelGrain(int elements) {
+        parallelGrainSetting() = std::max(elements, 1);
+    }
+    
+    // Sort the elements with compare (ascending by default): runs are sorted
+    // in parallel, then merged pairwise, each merge itself split across threads.
+    // Not stable.
+    template <typename Compare = less<ValueType>>
+    void parallelSort(Compare compare = Compare()) {
+        if (!runsInParallel(arraySize)) {
+            sort(data, data + arraySize, compare);
+            return;
+        }
+        
+        // A few runs per thread, so the threads stay busy and few merge passes remain
+        int grain = parallelGrain();
+        int threads = WorkPool::instance().workerCount() + 1;
+        int run = std::max(grain, (arraySize + threads * 4 - 1) / (threads * 4));
+        int runs = (arraySize + run - 1) / run;
+        parallelFor(0, runs, 1, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                sort(data + r * run, data + (r == runs - 1 ? arraySize : (r + 1) * run), compare);
+            }
+        });
+        
+        unique_ptr<ValueType[]> buffer(new ValueType[arraySize]);
+        ValueType* from = data;
+        ValueType* to = buffer.get();
+        for (int width = run; width < arraySize; width = width > arraySize / 2 ? arraySize : width * 2) {
+            int pairs = (int)(((long long)arraySize + 2LL * width - 1) / (2LL * width));
+            parallelFor(0, pairs, 1, [&](int first, int last) {
+                WorkPool& pool = WorkPool::instance();
+                TaskGroup group;
+                try {
+                    for (int p = first; p < last; p++) {
+                        int low = (int)std::min<long long>(arraySize, 2LL * width * p);
+                        int middle = (int)std::min<long long>(arraySize, (long long)low + width);
+                        int high = (int)std::min<long long>(arraySize, (long long)middle + width);
+                        mergeRuns(pool, group, from + low, from + middle, from + middle, from + high, to + low, grain, compare);
+                    }
+                } catch (...) {
+                    group.fail(current_exception());
+                }
+                pool.wait(group);
+            });
+            swap(from, to);
+        }
+        if (from != data) {
+            parallelFor(0, arraySize, grain, [&](int begin, int end) {
+                moveElements(data + begin, from + begin, end - begin);
+            });
+        }
+    }
+    
+    // Replace every element with f(element); f runs on several threads at once
+    template <typename F>
+    void parallelTransform(F f) {
+        auto transform = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                data[i] = f(data[i]);
+            }
+        };
+        if (runsInParallel(arraySize)) {
+            parallelFor(0, arraySize, parallelGrain(), transform);
+        } else {
+            transform(0, arraySize);
+        }
+    }
+    
+    // Fold the elements into init with op, which must be associative: each
+    // thread reduces whole grains, and their results are combined in order
+    template <typename Op>
+    ValueType parallelReduce(ValueType init, Op op) const {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 0; i < arraySize; i++) {
+                init = op(move(init), data[i]);
+            }
+            return init;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<ValueType[]> partials(new ValueType[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                ValueType partial = data[c * grain];
+                for (int i = c * grain + 1; i < end; i++) {
+                    partial = op(move(partial), data[i]);
+                }
+                partials[c] = move(partial);
+            }
+        });
+        for (int c = 0; c < chunks; c++) {
+            init = op(move(init), partials[c]);
+        }
+        return init;
+    }
+    
+    // Replace every element with the sum of itself and all elements before it.
+    // Each grain is summed in parallel, the grain totals are added up in order,
+    // and a second parallel pass adds each grain's offset.
+    template <typename T = ValueType>
+    void parallelPrefixSum() {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 1; i < arraySize; i++) {
+                data[i] = data[i - 1] + data[i];
+            }
+            return;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<T[]> totals(new T[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain + 1; i < end; i++) {
+                    data[i] = data[i - 1] + data[i];
+                }
+                totals[c] = data[end - 1];
+            }
+        });
+)DSLORD"
+R"DSLORD(        for (int c = 1; c < chunks; c++) {
+            totals[c] = totals[c - 1] + totals[c];
+        }
+        parallelFor(1, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain; i < end; i++) {
+                    data[i] = totals[c - 1] + data[i];
+                }
+            }
+        });
+    }
+    
+    // Display the array (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Array is empty" << endl;
+            return;
+        }
+        
+        cout << "Array elements: ";
+        for (int i = 0; i < arraySize; i++) {
+            cout << data[i] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 41554, 0xd02add40e2b1aeb9ULL,
+    "#include <climits>\n#include <cstddef>\n#include <cstdlib>\n#include <cstring>\n#include <new>\n#include <type_traits>\n#include <utility>\n#include <algorithm>\n#include <atomic>\n#include <condition_variable>\n#include <cstdint>\n#include <deque>\n#include <exception>\n#include <functional>\n#include <iterator>\n#include <memory>\n#include <mutex>\n#include <thread>\n#include <vector>\n"},
+    {"array_inline",
+R"DSLORD(/**
+ * DynamicArray - A Dynamic Array that keeps its first elements inside the
+ * object (dslord: -array:inline=<n>).
+ *
+ * Up to INLINE_CAPACITY elements live in a buffer inside the object, so small
+ * arrays never allocate. Past that the elements move to the heap and grow as
+ * in the plain DynamicArray: trivially copyable elements in malloc'd storage
+ * that realloc extends, others with new[] and element moves. An array that
+ * shrinks back to the buffer's size moves back into it. Moving an array with
+ * inline elements moves them one by one; moving a heap array steals its storage.
+ * Scans (sum, min, max, minMaxIndex, count, find) use the same SSE2/AVX2/AVX-512
+ * kernels as the plain DynamicArray, and the parallel algorithms the same
+ * work-stealing pool.
+ * Operations:
+ * - pushBack, emplaceBack: Add an element to the end of the array
+ * - popBack: Remove the last element
+ * - insert: Insert an element at a specific position
+ * - insertRange: Insert a block of elements at a specific position
+ * - removeAt: Remove an element at a specific position
+ * - eraseRange: Remove the elements in a range of positions
+ * - get: Get the element at a specific position
+ * - set: Set the element at a specific position
+ * - reserve: Make room for a number of elements up front
+ * - size: Get the number of elements in the array
+ * - capacity: Get the current capacity of the array
+ * - isEmpty: Check if the array is empty
+ * - clear: Remove all elements
+ * - sum, min, max, minMaxIndex: Reduce the elements in one pass
+ * - count, find: Count or locate the elements equal to a value
+ * - parallelSort, parallelTransform, parallelReduce, parallelPrefixSum:
+ *   Process large arrays on a shared work-stealing thread pool
+ */
+class DynamicArray {
+public:
+    // Element type (dslord: -array:T=<type>)
+    typedef int ValueType;
+private:
+    // Elements stored inside the object before the array allocates (dslord: -array:inline=<n>)
+    static const int INLINE_CAPACITY = 16;
+    
+    // Whether heap storage comes from malloc and grows with realloc
+    static const bool REALLOCATABLE = is_trivially_copyable<ValueType>::value &&
+                                      alignof(ValueType) <= alignof(max_align_t);
+    
+    ValueType* data;  // inlineData, or heap storage once the array outgrows it
+    int arraySize;
+    int arrayCapacity;
+    int reservedCapacity;  // the largest reserve(); shrinking stops there
+    ValueType inlineData[INLINE_CAPACITY];
+    
+    static ValueType* allocate(int capacity) {
+        if (REALLOCATABLE) {
+            void* block = malloc((size_t)capacity * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            return static_cast<ValueType*>(block);
+        }
+        return new ValueType[capacity];
+    }
+    
+    static void release(ValueType* block) {
+        if (REALLOCATABLE) {
+            free(block);
+        } else {
+            delete[] block;
+        }
+    }
+    
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    
+    // Move n elements to a range that may overlap, as one memmove when the type allows
+    static void moveElements(ValueType* to, ValueType* from, int n) {
+        if (n <= 0 || to == from) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else if (to < from) {
+            for (int i = 0; i < n; i++) {
+                to[i] = move(from[i]);
+            }
+        } else {
+            for (int i = n - 1; i >= 0; i--) {
+                to[i] = move(from[i]);
+            }
+        }
+    }
+    
+    bool isInline() const {
+        return data == inlineData;
+    }
+    
+    // Resize the array when needed; capacities up to INLINE_CAPACITY use the inline buffer
+    void resize(int newCapacity) {
+        if (newCapacity <= INLINE_CAPACITY) {
+            if (!isInline()) {
+                moveElements(inlineData, data, arraySize);
+                release(data);
+                data = inlineData;
+            }
+            arrayCapacity = INLINE_CAPACITY;
+            return;
+        }
+        
+        if (REALLOCATABLE && !isInline()) {
+            void* block = realloc(static_cast<void*>(data), (size_t)newCapacity * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            data = static_cast<ValueType*>(block);
+        } else {
+            ValueType* newData = allocate(newCapacity);
+            moveElements(newData, data, arraySize);
+            if (!isInline()) {
+                release(data);
+            }
+            data = newData;
+        }
+        arrayCapacity = newCapacity;
+    }
+    
+    // Double the capacity until `needed` elements fit, stopping at INT_MAX
+    void ensureCapacity(long long needed) {
+        if (needed > INT_MAX) {
+            throw length_error("Array cannot hold more than INT_MAX elements");
+        }
+        if (needed > arrayCapacity) {
+            long long newCapacity = arrayCapacity;
+            while (newCapacity < needed) {
+                newCapacity *= 2;
+            }
+            resize((int)std::min(newCapacity, (long long)INT_MAX));
+        }
+    }
+    
+    // Halve the capacity while at most a quarter of it is used, but never below
+    // what reserve() asked for
+    void shrinkIfSparse() {
+        int newCapacity = arrayCapacity;
+        while (arraySize > 0 && arraySize <= newCapacity / 4 && newCapacity > INLINE_CAPACITY &&
+               newCapacity / 2 >= reservedCapacity) {
+            newCapacity /= 2;
+        }
+        if (newCapacity != arrayCapacity) {
+            resize(newCapacity);
+        }
+    }
+    
+    // Make room for n elements at a position, shifting the tail once
+    void openGap(int position, int n) {
+        ensureCapacity((long long)arraySize + n);
+        moveElements(data + position + n, data + position, arraySize - position);
+        arraySize += n;
+    }
+    
+    // Take other's elements, leaving it empty with its inline buffer
+    void takeFrom(DynamicArray& other) {
+        if (other.isInline()) {
+            moveElements(inlineData, other.inlineData, other.arraySize);
+        } else {
+            data = other.data;
+            arrayCapacity = other.arrayCapacity;
+            other.data = other.inlineData;
+            other.arrayCapacity = INLINE_CAPACITY;
+        }
+        arraySize = other.arraySize;
+        reservedCapacity = other.reservedCapacity;
+        other.arraySize = 0;
+        other.reservedCapacity = 0;
+    }
+public:
+    // Constructor; capacities up to INLINE_CAPACITY do not allocate
+    DynamicArray(int initialCapacity = 10) : data(inlineData), arraySize(0), arrayCapacity(INLINE_CAPACITY), reservedCapacity(0) {
+        static_assert(INLINE_CAPACITY > 0, "DynamicArray inline capacity must be positive");
+        
+        if (initialCapacity > INLINE_CAPACITY) {
+            resize(initialCapacity);
+        }
+    }
+    
+    // Destructor
+    ~DynamicArray() {
+        if (!isInline()) {
+            release(data);
+        }
+    }
+    
+    // Copy constructor
+    DynamicArray(const DynamicArray& other) : DynamicArray(other.arrayCapacity) {
+        copyElements(data, other.data, other.arraySize);
+        arraySize = other.arraySize;
+        reservedCapacity = other.reservedCapacity;
+    }
+    
+    // Move constructor; `other` is left empty
+    DynamicArray(DynamicArray&& other) noexcept : data(inlineData), arraySize(0), arrayCapacity(INLINE_CAPACITY), reservedCapacity(0) {
+        takeFrom(other);
+    }
+    
+    // Assignment operator
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            DynamicArray copy(other);
+)DSLORD"
+R"DSLORD(            *this = move(copy);
+        }
+        
+        return *this;
+    }
+    
+    // Move assignment operator; `other` is left empty
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            if (!isInline()) {
+                release(data);
+                data = inlineData;
+                arrayCapacity = INLINE_CAPACITY;
+            }
+            takeFrom(other);
+        }
+        
+        return *this;
+    }
+    
+    // Add an element to the end of the array
+    void pushBack(const ValueType& value) {
+        emplaceBack(value);
+    }
+    
+    void pushBack(ValueType&& value) {
+        emplaceBack(move(value));
+    }
+    
+    // Construct an element at the end of the array from `args`
+    template <typename... Args>
+    ValueType& emplaceBack(Args&&... args) {
+        if (arraySize >= arrayCapacity) {
+            // Build the element before growing, as args may refer into the array
+            ValueType value(forward<Args>(args)...);
+            ensureCapacity((long long)arraySize + 1);
+            data[arraySize] = move(value);
+        } else if (REALLOCATABLE) {
+            new (data + arraySize) ValueType(forward<Args>(args)...);
+        } else {
+            data[arraySize] = ValueType(forward<Args>(args)...);
+        }
+        
+        return data[arraySize++];
+    }
+    
+    // Remove the last element
+    void popBack() {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        arraySize--;
+        
+        // Optionally shrink the array if it gets too empty
+        shrinkIfSparse();
+    }
+    
+    // Insert an element at a specific position
+    void insert(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Copy first, as value may be an element of this array
+        ValueType element(value);
+        openGap(position, 1);
+        data[position] = move(element);
+    }
+    
+    // Insert n elements at a specific position, shifting the elements after
+    // it once; `values` must not point into this array
+    void insertRange(int position, const ValueType* values, int n) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        if (n <= 0) {
+            return;
+        }
+        
+        openGap(position, n);
+        copyElements(data + position, values, n);
+    }
+    
+    // Remove an element at a specific position
+    void removeAt(int position) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        eraseRange(position, position + 1);
+    }
+    
+    // Remove the elements at positions [first, last), shifting the elements
+    // after them once
+    void eraseRange(int first, int last) {
+        // Check if the range is valid
+        if (first < 0 || first > last || last > arraySize) {
+            throw out_of_range("Invalid range");
+        }
+        
+        moveElements(data + first, data + last, arraySize - last);
+        arraySize -= last - first;
+        
+        // Optionally shrink the array if it gets too empty
+        shrinkIfSparse();
+    }
+    
+    // Get the element at a specific position
+    ValueType get(int position) const {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return data[position];
+    }
+    
+    // Set the element at a specific position
+    void set(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        data[position] = value;
+    }
+    
+    // Make room for at least n elements, so filling up to n never reallocates;
+    // removing elements never shrinks the array below n either
+    void reserve(int n) {
+        reservedCapacity = std::max(reservedCapacity, n);
+        if (n > arrayCapacity) {
+            resize(n);
+        }
+    }
+    
+    // Get the number of elements in the array
+    int size() const {
+        return arraySize;
+    }
+    
+    // Get the current capacity of the array
+    int capacity() const {
+        return arrayCapacity;
+    }
+    
+    // Check if the array is empty
+    bool isEmpty() const {
+        return arraySize == 0;
+    }
+    
+    // Remove all elements, returning to the inline buffer unless more was reserved
+    void clear() {
+        arraySize = 0;
+        int keep = reservedCapacity > INLINE_CAPACITY ? reservedCapacity : INLINE_CAPACITY;
+        if (arrayCapacity != keep) {
+            resize(keep);
+        }
+    }
+    
+    // Vector scans and parallel algorithms, shared by every DynamicArray variant
+    // (dslord splices them in from snippets/fragments/array_algorithms.cpp). They
+    // use the variant's ValueType, data, arraySize, isEmpty() and moveElements(),
+    // and need the elements to be contiguous in data.
+public:
+    // Type sum() adds in: 64-bit for integers, ValueType otherwise
+    typedef conditional<is_integral<ValueType>::value,
+                        conditional<is_signed<ValueType>::value, long long, unsigned long long>::type,
+                        ValueType>::type SumType;
+    
+    // Vector instruction sets the scans can use, narrowest first
+    enum SimdLevel {
+        SIMD_SCALAR,  // plain loops
+        SIMD_SSE2,    // 16-byte vectors (SSE2, or NEON and the like off x86)
+        SIMD_AVX2,    // 32-byte vectors
+        SIMD_AVX512   // 64-byte vectors (AVX-512F)
+    };
+private:
+    // Element types the vector kernels handle: 4- and 8-byte arithmetic types
+    template <typename E>
+    struct VectorScanSupported {
+#if defined(__GNUC__)
+        static const bool value = is_arithmetic<E>::value && !is_same<E, bool>::value && (sizeof(E) == 4 || sizeof(E) == 8);
+#else
+        static const bool value = false;
+#endif
+    };
+    
+    // A scan over [data, data + n) and its results; the vector and scalar paths fill the same fields
+    template <typename E>
+    struct ScanJob {
+        enum Kind { SUM, MIN_MAX, MIN_MAX_INDEX, COUNT, FIND } kind;
+        const E* data;
+        int n;
+        const E* value;  // COUNT, FIND
+        SumType sum;     // SUM
+        E min, max;      // MIN_MAX
+        int minIndex, maxIndex;  // MIN_MAX_INDEX
+        int result;      // COUNT, FIND (-1 when not found)
+    };
+    
+    static SimdLevel detectSimdLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SIMD_AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SIMD_AVX2;
+        }
+        return __builtin_cpu_supports("sse2") ? SIMD_SSE2 : SIMD_SCALAR;
+#elif defined(__GNUC__)
+        return SIMD_SSE2;  // 16-byte vectors, e.g. NEON
+#else
+        return SIMD_SCALAR;
+#endif
+    }
+    
+    static SimdLevel& simdSetting() {
+        static SimdLevel level = detectSimdLevel();
+        return level;
+    }
+    
+    // The plain loops, for every element type and as the reference for the kernels
+    template <typename E>
+    static void scalarScan(ScanJob<E>& job) {
+        const E* p = job.data;
+        switch (job.kind) {
+        case ScanJob<E>::SUM:
+            job.sum = SumType();
+            for (int i = 0; i < job.n; i++) {
+                job.sum += p[i];
+            }
+            break;
+        case ScanJob<E>::MIN_MAX:
+        case ScanJob<E>::MIN_MAX_INDEX:
+            job.minIndex = job.maxIndex = 0;
+            for (int i = 1; i < job.n; i++) {
+                if (p[i] < p[job.minIndex]) {
+                    job.minIndex = i;
+                }
+                if (p[job.maxIndex] < p[i]) {
+                    job.maxIndex = i;
+                }
+            }
+            job.min = p[job.minIndex];
+            job.max = p[job.maxIndex];
+            break;
+)DSLORD"
+R"DSLORD(        case ScanJob<E>::COUNT:
+            job.result = 0;
+            for (int i = 0; i < job.n; i++) {
+                job.result += p[i] == *job.value;
+            }
+            break;
+        case ScanJob<E>::FIND:
+            job.result = -1;
+            for (int i = 0; i < job.n; i++) {
+                if (p[i] == *job.value) {
+                    job.result = i;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    
+#if defined(__GNUC__)
+    // Kernels over BYTES-wide vectors of E, written with GCC/Clang vector
+    // extensions. They are inlined into the scan128/256/512 entry points, whose
+    // target attribute makes the compiler emit SSE2, AVX2 or AVX-512 code.
+    template <typename E, int BYTES>
+    struct VectorScan {
+        static const int LANES = BYTES / sizeof(E);
+        typedef E Vector __attribute__((vector_size(BYTES)));
+        typedef typename conditional<sizeof(E) == 4, int32_t, int64_t>::type MaskLane;
+        typedef MaskLane Mask __attribute__((vector_size(BYTES)));
+        // Sums widen E to SumType, so a load of NARROW bytes fills one accumulator
+        static const int SUM_LANES = BYTES / sizeof(SumType);
+        typedef E Narrow __attribute__((vector_size(SUM_LANES * sizeof(E))));
+        typedef typename conditional<true, SumType, E>::type SumLane;  // dependent, so vector_size applies
+        typedef SumLane Sums __attribute__((vector_size(BYTES)));
+        
+        static inline __attribute__((always_inline)) SumType sum(const E* p, int n) {
+            Sums acc = {};
+            int i = 0;
+            // 16-byte vectors have no widening load before SSE4.1; the compiler
+            // vectorizes the plain loop below better than convertvector then
+            const bool WIDENS = sizeof(E) < sizeof(SumType);
+            for (; !(BYTES == 16 && WIDENS) && i + SUM_LANES <= n; i += SUM_LANES) {
+                Narrow v;
+                memcpy(&v, p + i, sizeof v);
+                acc += __builtin_convertvector(v, Sums);
+            }
+            SumType total = SumType();
+            for (int l = 0; l < SUM_LANES; l++) {
+                total += acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i];
+            }
+            return total;
+        }
+        
+        // Smallest and largest element of a non-empty range. Every lane starts
+        // at p[0], so as in the plain loops a NaN is never taken unless it is p[0].
+        static inline __attribute__((always_inline)) void minMax(const E* p, int n, E& lo, E& hi) {
+            int i = 0;
+            lo = hi = p[0];
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    vlo = v < vlo ? v : vlo;
+                    vhi = vhi < v ? v : vhi;
+                }
+                lo = vlo[0];
+                hi = vhi[0];
+                for (int l = 1; l < LANES; l++) {
+                    lo = vlo[l] < lo ? vlo[l] : lo;
+                    hi = hi < vhi[l] ? vhi[l] : hi;
+                }
+            }
+            for (; i < n; i++) {
+                lo = p[i] < lo ? p[i] : lo;
+                hi = hi < p[i] ? p[i] : hi;
+            }
+        }
+        
+        // Positions of the first smallest and the first largest element of a
+        // non-empty range, in one pass: each lane keeps its best values and where
+        // it saw them, starting at p[0] like minMax, and ties between lanes go to
+        // the earlier position
+        static inline __attribute__((always_inline)) void minMaxIndex(const E* p, int n, int& lo, int& hi) {
+            int i = 0;
+            lo = hi = 0;
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                Mask ilo = {}, ihi = {}, index;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                    index[l] = l;
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    Mask less = (Mask)(v < vlo);
+                    Mask more = (Mask)(vhi < v);
+                    vlo = less ? v : vlo;
+                    ilo = less ? index : ilo;
+                    vhi = more ? v : vhi;
+                    ihi = more ? index : ihi;
+                    index += LANES;
+                }
+                for (int l = 0; l < LANES; l++) {
+                    if (vlo[l] < p[lo] || (!(p[lo] < vlo[l]) && ilo[l] < lo)) {
+                        lo = (int)ilo[l];
+                    }
+                    if (p[hi] < vhi[l] || (!(vhi[l] < p[hi]) && ihi[l] < hi)) {
+                        hi = (int)ihi[l];
+                    }
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] < p[lo]) {
+                    lo = i;
+                }
+                if (p[hi] < p[i]) {
+                    hi = i;
+                }
+            }
+        }
+        
+        static inline __attribute__((always_inline)) int count(const E* p, int n, E x) {
+            // Matching lanes are -1, so subtracting counts them; a lane sees at most n / LANES matches
+            Mask acc = {};
+            int i = 0;
+            for (; i + LANES <= n; i += LANES) {
+                Vector v;
+                memcpy(&v, p + i, sizeof v);
+                acc -= (Mask)(v == x);
+            }
+            int total = 0;
+            for (int l = 0; l < LANES; l++) {
+                total += (int)acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i] == x;
+            }
+            return total;
+        }
+        
+        static inline __attribute__((always_inline)) int find(const E* p, int n, E x) {
+            // Compare a block of vectors, reduce the match mask once, and only
+            // search the block element by element when it holds a match
+            const int BLOCK = 16 * LANES;
+            int i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                Mask matches = {};
+                for (int j = 0; j < BLOCK; j += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i + j, sizeof v);
+                    matches |= (Mask)(v == x);
+                }
+                MaskLane any = 0;
+                for (int l = 0; l < LANES; l++) {
+                    any |= matches[l];
+                }
+                if (any) {
+                    break;
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] == x) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        
+        static inline __attribute__((always_inline)) void run(ScanJob<E>& job) {
+            switch (job.kind) {
+            case ScanJob<E>::SUM:
+                job.sum = sum(job.data, job.n);
+                break;
+            case ScanJob<E>::MIN_MAX:
+                minMax(job.data, job.n, job.min, job.max);
+                break;
+            case ScanJob<E>::MIN_MAX_INDEX:
+                minMaxIndex(job.data, job.n, job.minIndex, job.maxIndex);
+                job.min = job.data[job.minIndex];
+                job.max = job.data[job.maxIndex];
+                break;
+            case ScanJob<E>::COUNT:
+                job.result = count(job.data, job.n, *job.value);
+                break;
+            case ScanJob<E>::FIND:
+                job.result = find(job.data, job.n, *job.value);
+                break;
+            }
+        }
+    };
+    
+#if defined(__x86_64__) || defined(__i386__)
+    template <typename E>
+    __attribute__((target("avx512f"))) static void scan512(ScanJob<E>& job) {
+        VectorScan<E, 64>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("avx2"))) static void scan256(ScanJob<E>& job) {
+        VectorScan<E, 32>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("sse2"))) static void scan128(ScanJob<E>& job) {
+)DSLORD"
+R"DSLORD(        VectorScan<E, 16>::run(job);
+    }
+#else
+    template <typename E>
+    static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>& job, true_type) {
+        switch (simdLevel()) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SIMD_AVX512:
+            scan512(job);
+            return true;
+        case SIMD_AVX2:
+            scan256(job);
+            return true;
+#endif
+        case SIMD_SCALAR:
+            return false;
+        default:
+            scan128(job);
+            return true;
+        }
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>&, false_type) {
+        return false;
+    }
+    
+    // Run a scan with the kernels for simdLevel(), or the plain loops
+    template <typename E>
+    static void runScan(ScanJob<E>& job) {
+        if (!vectorScan(job, integral_constant<bool, VectorScanSupported<E>::value>())) {
+            scalarScan(job);
+        }
+    }
+    
+    template <typename E>
+    ScanJob<E> scanJob(typename ScanJob<E>::Kind kind, const E* value = nullptr) const {
+        ScanJob<E> job = ScanJob<E>();
+        job.kind = kind;
+        job.data = data;
+        job.n = arraySize;
+        job.value = value;
+        return job;
+    }
+    
+    // Tasks spawned by one parallel call; wait() returns once all have run
+    struct TaskGroup {
+        atomic<int> pending;
+        mutex errorLock;
+        exception_ptr error;  // the first exception a task threw
+        
+        TaskGroup() : pending(0) {}
+        
+        void fail(exception_ptr exception) {
+            lock_guard<mutex> lock(errorLock);
+            if (!error) {
+                error = exception;
+            }
+        }
+    };
+    
+    // Fork-join pool shared by the parallel algorithms of every array: a worker
+    // per hardware thread but one, as the calling thread runs tasks while it
+    // waits. Each worker has its own task deque. Owners push and pop at the
+    // back, and idle threads steal from the front, where the largest pieces of
+    // a halved range are. Tasks are at least a grain of elements, so a mutex per
+    // deque costs little next to the work it hands out.
+    class WorkPool {
+    public:
+        static WorkPool& instance() {
+            static WorkPool pool;
+            return pool;
+        }
+        
+        int workerCount() const {
+            return (int)workers.size();
+        }
+        
+        // Queue a task on the calling thread's deque
+        void spawn(TaskGroup& group, function<void()> task) {
+            group.pending.fetch_add(1, memory_order_relaxed);
+            TaskQueue& queue = queues[queueIndex()];
+            {
+                lock_guard<mutex> lock(queue.lock);
+                queue.tasks.push_back(Task{move(task), &group});
+            }
+            queued.fetch_add(1, memory_order_release);
+            {
+                lock_guard<mutex> lock(sleepLock);
+            }
+            wakeUp.notify_one();
+        }
+        
+        // Run tasks, the group's or others', until the group has finished;
+        // rethrows the first exception one of its tasks threw
+        void wait(TaskGroup& group) {
+            while (group.pending.load(memory_order_acquire) > 0) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                } else {
+                    this_thread::yield();
+                }
+            }
+            if (group.error) {
+                rethrow_exception(group.error);
+            }
+        }
+    private:
+        struct Task {
+            function<void()> body;
+            TaskGroup* group;
+        };
+        
+        struct TaskQueue {
+            mutex lock;
+            deque<Task> tasks;
+        };
+        
+        vector<thread> workers;
+        unique_ptr<TaskQueue[]> queues;  // queues[0] for threads outside the pool, then one per worker
+        int queueCount;
+        atomic<int> queued;  // tasks in all queues, so idle threads skip the locks
+        mutex sleepLock;
+        condition_variable wakeUp;
+        bool stopping;
+        
+        WorkPool() : queued(0), stopping(false) {
+            int threads = std::max((int)thread::hardware_concurrency(), 1) - 1;
+            queueCount = threads + 1;
+            queues.reset(new TaskQueue[queueCount]);
+            for (int i = 1; i <= threads; i++) {
+                workers.emplace_back([this, i] {
+                    queueIndex() = i;
+                    workerLoop();
+                });
+            }
+        }
+        
+        ~WorkPool() {
+            {
+                lock_guard<mutex> lock(sleepLock);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        
+        // The deque of the calling thread: 0 unless it is a worker
+        static int& queueIndex() {
+            static thread_local int index = 0;
+            return index;
+        }
+        
+        void workerLoop() {
+            while (true) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                    continue;
+                }
+                unique_lock<mutex> lock(sleepLock);
+                wakeUp.wait(lock, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+                if (stopping) {
+                    return;
+                }
+            }
+        }
+        
+        // Pop the newest task of our own deque, or steal the oldest of another
+        bool take(Task& task) {
+            if (queued.load(memory_order_acquire) == 0) {
+                return false;
+            }
+            int own = queueIndex();
+            for (int i = 0; i < queueCount; i++) {
+                TaskQueue& queue = queues[(own + i) % queueCount];
+                lock_guard<mutex> lock(queue.lock);
+                if (!queue.tasks.empty()) {
+                    if (i == 0) {
+                        task = move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                    } else {
+                        task = move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                    }
+                    queued.fetch_sub(1, memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+        static void run(Task& task) {
+            try {
+                task.body();
+            } catch (...) {
+                task.group->fail(current_exception());
+            }
+            task.group->pending.fetch_sub(1, memory_order_release);
+        }
+    };
+    
+    static int& parallelGrainSetting() {
+        static int grain = 1 << 15;
+        return grain;
+    }
+    
+    // Whether n elements are worth splitting across the pool
+    static bool runsInParallel(int n) {
+        return n > parallelGrain() && WorkPool::instance().workerCount() > 0;
+    }
+    
+    // Run body(begin, end) on pieces of [begin, end) of at most grain
+    // elements, halving the range so that thieves take the largest pieces
+    template <typename Body>
+    static void parallelFor(int begin, int end, int grain, const Body& body) {
+        WorkPool& pool = WorkPool::instance();
+        TaskGroup group;
+        try {
+            splitRange(pool, group, begin, end, grain, body);
+        } catch (...) {
+            group.fail(current_exception());
+        }
+        pool.wait(group);
+    }
+    
+    template <typename Body>
+    static void splitRange(WorkPool& pool, TaskGroup& group, int begin, int end, int grain, const Body& body) {
+        while (end - begin > grain) {
+            int middle = begin + (end - begin) / 2;
+            pool.spawn(group, [&pool, &group, middle, end, grain, &body] {
+                splitRange(pool, group, middle, end, grain, body);
+            });
+            end = middle;
+        }
+        body(begin, end);
+    }
+    
+    // Merge the sorted runs [a, aEnd) and [b, bEnd) into out. Large merges are
+    // split at the middle element of the longer run and its position in the
+)DSLORD"
+R"DSLORD(    // other run, which divides the output into two independent merges.
+    template <typename Compare>
+    static void mergeRuns(WorkPool& pool, TaskGroup& group, ValueType* a, ValueType* aEnd, ValueType* b, ValueType* bEnd,
+                          ValueType* out, int grain, const Compare& compare) {
+        while ((aEnd - a) + (bEnd - b) > grain && std::max(aEnd - a, bEnd - b) > 1) {
+            ValueType* aMiddle;
+            ValueType* bMiddle;
+            if (aEnd - a >= bEnd - b) {
+                aMiddle = a + (aEnd - a) / 2;
+                bMiddle = lower_bound(b, bEnd, *aMiddle, compare);
+            } else {
+                bMiddle = b + (bEnd - b) / 2;
+                aMiddle = upper_bound(a, aEnd, *bMiddle, compare);
+            }
+            ValueType* outMiddle = out + (aMiddle - a) + (bMiddle - b);
+            pool.spawn(group, [&pool, &group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, &compare] {
+                mergeRuns(pool, group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, compare);
+            });
+            aEnd = aMiddle;
+            bEnd = bMiddle;
+        }
+        merge(make_move_iterator(a), make_move_iterator(aEnd), make_move_iterator(b), make_move_iterator(bEnd), out, compare);
+    }
+public:
+    // Get the vector instruction set the scans use: the widest the CPU
+    // supports, unless lowered with setSimdLevel
+    static SimdLevel simdLevel() {
+        return simdSetting();
+    }
+    
+    // Limit the scans to a level, e.g. SIMD_SCALAR to compare against the
+    // plain loops; levels above what the CPU supports are lowered to it.
+    // Not safe while other threads scan.
+    static void setSimdLevel(SimdLevel level) {
+        simdSetting() = std::min(level, detectSimdLevel());
+    }
+    
+    // Sum of the elements in SumType (0 when empty)
+    template <typename T = ValueType>
+    SumType sum() const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::SUM);
+        runScan(job);
+        return job.sum;
+    }
+    
+    // Get the smallest element
+    template <typename T = ValueType>
+    ValueType min() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.min;
+    }
+    
+    // Get the largest element
+    template <typename T = ValueType>
+    ValueType max() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.max;
+    }
+    
+    // Get the positions of the first smallest and the first largest element
+    template <typename T = ValueType>
+    pair<int, int> minMaxIndex() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX_INDEX);
+        runScan(job);
+        return make_pair(job.minIndex, job.maxIndex);
+    }
+    
+    // Count the elements equal to value
+    template <typename T = ValueType>
+    int count(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::COUNT, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the position of the first element equal to value, or -1
+    template <typename T = ValueType>
+    int find(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::FIND, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the number of elements below which the parallel algorithms run
+    // sequentially, and the size of the pieces they split the array into
+    static int parallelGrain() {
+        return parallelGrainSetting();
+    }
+    
+    // Set the grain (at least 1). Not safe while other threads run parallel algorithms.
+    static void setParallelGrain(int elements) {
+        parallelGrainSetting() = std::max(elements, 1);
+    }
+    
+    // Sort the elements with compare (ascending by default): runs are sorted
+    // in parallel, then merged pairwise, each merge itself split across threads.
+    // Not stable.
+    template <typename Compare = less<ValueType>>
+    void parallelSort(Compare compare = Compare()) {
+        if (!runsInParallel(arraySize)) {
+            sort(data, data + arraySize, compare);
+            return;
+        }
+        
+        // A few runs per thread, so the threads stay busy and few merge passes remain
+        int grain = parallelGrain();
+        int threads = WorkPool::instance().workerCount() + 1;
+        int run = std::max(grain, (arraySize + threads * 4 - 1) / (threads * 4));
+        int runs = (arraySize + run - 1) / run;
+        parallelFor(0, runs, 1, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                sort(data + r * run, data + (r == runs - 1 ? arraySize : (r + 1) * run), compare);
+            }
+        });
+        
+        unique_ptr<ValueType[]> buffer(new ValueType[arraySize]);
+        ValueType* from = data;
+        ValueType* to = buffer.get();
+        for (int width = run; width < arraySize; width = width > arraySize / 2 ? arraySize : width * 2) {
+            int pairs = (int)(((long long)arraySize + 2LL * width - 1) / (2LL * width));
+            parallelFor(0, pairs, 1, [&](int first, int last) {
+                WorkPool& pool = WorkPool::instance();
+                TaskGroup group;
+                try {
+                    for (int p = first; p < last; p++) {
+                        int low = (int)std::min<long long>(arraySize, 2LL * width * p);
+                        int middle = (int)std::min<long long>(arraySize, (long long)low + width);
+                        int high = (int)std::min<long long>(arraySize, (long long)middle + width);
+                        mergeRuns(pool, group, from + low, from + middle, from + middle, from + high, to + low, grain, compare);
+                    }
+                } catch (...) {
+                    group.fail(current_exception());
+                }
+                pool.wait(group);
+            });
+            swap(from, to);
+        }
+        if (from != data) {
+            parallelFor(0, arraySize, grain, [&](int begin, int end) {
+                moveElements(data + begin, from + begin, end - begin);
+            });
+        }
+    }
+    
+    // Replace every element with f(element); f runs on several threads at once
+    template <typename F>
+    void parallelTransform(F f) {
+        auto transform = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                data[i] = f(data[i]);
+            }
+        };
+        if (runsInParallel(arraySize)) {
+            parallelFor(0, arraySize, parallelGrain(), transform);
+        } else {
+            transform(0, arraySize);
+        }
+    }
+    
+    // Fold the elements into init with op, which must be associative: each
+    // thread reduces whole grains, and their results are combined in order
+    template <typename Op>
+    ValueType parallelReduce(ValueType init, Op op) const {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 0; i < arraySize; i++) {
+                init = op(move(init), data[i]);
+            }
+            return init;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<ValueType[]> partials(new ValueType[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                ValueType partial = data[c * grain];
+                for (int i = c * grain + 1; i < end; i++) {
+                    partial = op(move(partial), data[i]);
+                }
+                partials[c] = move(partial);
+            }
+        });
+        for (int c = 0; c < chunks; c++) {
+            init = op(move(init), partials[c]);
+        }
+        return init;
+    }
+    
+    // Replace every element with the sum of itself and all elements before it.
+    // Each grain is summed in parallel, the grain totals are added up in order,
+)DSLORD"
+R"DSLORD(    // and a second parallel pass adds each grain's offset.
+    template <typename T = ValueType>
+    void parallelPrefixSum() {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 1; i < arraySize; i++) {
+                data[i] = data[i - 1] + data[i];
+            }
+            return;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<T[]> totals(new T[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain + 1; i < end; i++) {
+                    data[i] = data[i - 1] + data[i];
+                }
+                totals[c] = data[end - 1];
+            }
+        });
+        for (int c = 1; c < chunks; c++) {
+            totals[c] = totals[c - 1] + totals[c];
+        }
+        parallelFor(1, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain; i < end; i++) {
+                    data[i] = totals[c - 1] + data[i];
+                }
+            }
+        });
+    }
+    
+    // Display the array (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Array is empty" << endl;
+            return;
+        }
+        
+        cout << "Array elements: ";
+        for (int i = 0; i < arraySize; i++) {
+            cout << data[i] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 42483, 0x26376b5b6b89c4f6ULL,
+    "#include <climits>\n#include <cstddef>\n#include <cstdlib>\n#include <cstring>\n#include <new>\n#include <type_traits>\n#include <utility>\n#include <algorithm>\n#include <atomic>\n#include <condition_variable>\n#include <cstdint>\n#include <deque>\n#include <exception>\n#include <functional>\n#include <iterator>\n#include <memory>\n#include <mutex>\n#include <thread>\n#include <vector>\n"},
+    {"array_mapped",
+R"DSLORD(/**
+ * DynamicArray - A Dynamic Array stored in a memory-mapped file (dslord: -array:mapped)
+ *
+ * The file holds a 64-byte header (magic, element size, element count)
+ * followed by the elements exactly as they are in memory, so reopening an
+ * existing file maps it and checks the header without reading or parsing the
+ * elements. Pages are loaded on first access, and arrays can be larger than
+ * RAM. Growing extends the file with ftruncate and the mapping with mremap
+ * (munmap/mmap where mremap is missing), so the elements are never copied.
+ * madvise hints tune the kernel's read-ahead, and sync() flushes the
+ * elements and their count to the file. A default-constructed array uses an
+ * anonymous mapping instead of a file, as does a copy. Elements must be
+ * trivially copyable; they are moved with memmove. POSIX only.
+ * Scans over 4- and 8-byte arithmetic elements (sum, min, max, minMaxIndex,
+ * count, find) run on SSE2, AVX2 or AVX-512 vectors like the plain
+ * DynamicArray's, and the parallel algorithms use the same work-stealing pool.
+ * Operations:
+ * - pushBack, emplaceBack: Add an element to the end of the array
+ * - popBack: Remove the last element
+ * - insert: Insert an element at a specific position
+ * - insertRange: Insert a block of elements at a specific position
+ * - removeAt: Remove an element at a specific position
+ * - eraseRange: Remove the elements in a range of positions
+ * - get: Get the element at a specific position
+ * - set: Set the element at a specific position
+ * - reserve: Make room for a number of elements up front
+ * - size: Get the number of elements in the array
+ * - capacity: Get the current capacity of the array
+ * - isEmpty: Check if the array is empty
+ * - clear: Remove all elements
+ * - advise: Tell the kernel how the elements will be accessed
+ * - sync: Write the elements and their count to the file
+ * - sum, min, max, minMaxIndex: Reduce the elements in one pass
+ * - count, find: Count or locate the elements equal to a value
+ * - parallelSort, parallelTransform, parallelReduce, parallelPrefixSum:
+ *   Process large arrays on a shared work-stealing thread pool
+ */
+class DynamicArray {
+public:
+    // Element type (dslord: -array:T=<type>)
+    typedef int ValueType;
+    
+    // Access hints for the mapped pages, passed to madvise
+    enum AccessPattern {
+        ACCESS_NORMAL,      // default read-ahead
+        ACCESS_SEQUENTIAL,  // aggressive read-ahead; pages behind the reader can be dropped early
+        ACCESS_RANDOM,      // no read-ahead
+        ACCESS_WILLNEED     // read the whole array in now (once; keeps the current pattern)
+    };
+private:
+    // Bytes before the first element; keeps the elements 64-byte aligned
+    static const size_t HEADER_BYTES = 64;
+    
+    // Start of every array file
+    struct FileHeader {
+        char magic[8];
+        uint32_t elementSize;
+        uint32_t headerBytes;
+        int64_t count;  // elements in use, written by sync() and on close
+    };
+    
+    int fd;                 // the file, or -1 for an anonymous mapping
+    char* mapping;          // header followed by the elements; null once moved from
+    size_t mappedBytes;
+    ValueType* data;
+    int arraySize;
+    int arrayCapacity;
+    AccessPattern pattern;  // the last lasting hint, reapplied when the mapping moves
+    
+    static const char* fileMagic() {
+        return "DSLARRAY";
+    }
+    
+    [[noreturn]] static void fail(const string& what) {
+        throw system_error(errno, generic_category(), "DynamicArray: " + what);
+    }
+    
+    // Mapping size for a capacity: the header and elements, in whole pages
+    static size_t bytesFor(int capacity) {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t bytes = HEADER_BYTES + (size_t)capacity * sizeof(ValueType);
+        return (bytes + page - 1) / page * page;
+    }
+    
+    static int capacityOf(size_t bytes) {
+        size_t capacity = bytes > HEADER_BYTES ? (bytes - HEADER_BYTES) / sizeof(ValueType) : 0;
+        return (int)std::min(capacity, (size_t)INT_MAX);
+    }
+    
+    FileHeader* header() const {
+        return reinterpret_cast<FileHeader*>(mapping);
+    }
+    
+    void adopt(void* block, size_t bytes) {
+        mapping = static_cast<char*>(block);
+        mappedBytes = bytes;
+        data = reinterpret_cast<ValueType*>(mapping + HEADER_BYTES);
+        arrayCapacity = capacityOf(bytes);
+    }
+    
+    void mapNew(size_t bytes) {
+        void* block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                           fd >= 0 ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS, fd, 0);
+        if (block == MAP_FAILED) {
+            fail("mmap");
+        }
+        adopt(block, bytes);
+    }
+    
+    void writeHeader() {
+        memcpy(header()->magic, fileMagic(), sizeof header()->magic);
+        header()->elementSize = (uint32_t)sizeof(ValueType);
+        header()->headerBytes = (uint32_t)HEADER_BYTES;
+        header()->count = arraySize;
+    }
+    
+    void applyPattern() {
+        static const int advice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM};
+        if (mapping && pattern != ACCESS_NORMAL) {
+            madvise(mapping, mappedBytes, advice[pattern]);
+        }
+    }
+    
+    // Unmap and close, trimming the file to the elements in use
+    void release() {
+        if (!mapping) {
+            return;
+        }
+        header()->count = arraySize;
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        if (fd >= 0) {
+            if (ftruncate(fd, (off_t)(HEADER_BYTES + (size_t)arraySize * sizeof(ValueType))) != 0) {
+                // The file keeps its spare capacity; the header still has the right count
+            }
+            close(fd);
+            fd = -1;
+        }
+    }
+    
+    // Move n elements to a range that may overlap
+    static void moveElements(ValueType* to, const ValueType* from, int n) {
+        if (n > 0 && to != from) {
+            memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        }
+    }
+    
+    // Resize the mapping, and the file behind it, to hold newCapacity elements.
+    // The file grows before the mapping and shrinks after it, so no mapped page
+    // is ever past the end of the file.
+    void resize(int newCapacity) {
+        size_t newBytes = bytesFor(newCapacity);
+        if (!mapping) {
+            mapNew(newBytes);
+            writeHeader();
+            return;
+        }
+        if (fd >= 0 && newBytes > mappedBytes && ftruncate(fd, (off_t)newBytes) != 0) {
+            fail("ftruncate");
+        }
+#if defined(__linux__)
+        void* block = mremap(mapping, mappedBytes, newBytes, MREMAP_MAYMOVE);
+        if (block == MAP_FAILED) {
+            fail("mremap");
+        }
+        size_t oldBytes = mappedBytes;
+        adopt(block, newBytes);
+#else
+        char* old = mapping;
+        size_t oldBytes = mappedBytes;
+        mapNew(newBytes);
+        if (fd < 0) {
+            memcpy(mapping, old, std::min(oldBytes, newBytes));
+        }
+        munmap(old, oldBytes);
+#endif
+        if (fd >= 0 && newBytes < oldBytes && ftruncate(fd, (off_t)newBytes) != 0) {
+            fail("ftruncate");
+        }
+        applyPattern();
+    }
+    
+    // Double the capacity until `needed` elements fit, stopping at INT_MAX
+    void ensureCapacity(long long needed) {
+        if (needed > INT_MAX) {
+            throw length_error("Array cannot hold more than INT_MAX elements");
+        }
+        if (needed > arrayCapacity) {
+            long long newCapacity = std::max(arrayCapacity, 1);
+            while (newCapacity < needed) {
+                newCapacity *= 2;
+            }
+            resize((int)std::min(newCapacity, (long long)INT_MAX));
+        }
+    }
+    
+    // Make room for n elements at a position, shifting the tail once
+    void openGap(int position, int n) {
+        ensureCapacity((long long)arraySize + n);
+        moveElements(data + position + n, data + position, arraySize - position);
+        arraySize += n;
+    }
+public:
+    // Constructor; the elements live in anonymous memory, not in a file
+    DynamicArray(int initialCapacity = 10) : fd(-1), mapping(nullptr), mappedBytes(0), data(nullptr), arraySize(0),
+)DSLORD"
+R"DSLORD(                                             arrayCapacity(0), pattern(ACCESS_NORMAL) {
+        static_assert(is_trivially_copyable<ValueType>::value, "DynamicArray:mapped needs a trivially copyable element type");
+        
+        resize(initialCapacity > 0 ? initialCapacity : 10);
+    }
+    
+    // Open the array stored in a file, creating the file if it does not exist.
+    // An existing file is mapped as it is; throws runtime_error if it is not an
+    // array of this element type, and system_error if it cannot be opened or mapped.
+    explicit DynamicArray(const string& path, int initialCapacity = 10)
+        : fd(-1), mapping(nullptr), mappedBytes(0), data(nullptr), arraySize(0), arrayCapacity(0), pattern(ACCESS_NORMAL) {
+        static_assert(is_trivially_copyable<ValueType>::value, "DynamicArray:mapped needs a trivially copyable element type");
+        
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            fail("cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            close(fd);
+            errno = error;
+            fail("cannot stat " + path);
+        }
+        
+        try {
+            if (info.st_size == 0) {
+                size_t bytes = bytesFor(initialCapacity > 0 ? initialCapacity : 10);
+                if (ftruncate(fd, (off_t)bytes) != 0) {
+                    fail("cannot extend " + path);
+                }
+                mapNew(bytes);
+                writeHeader();
+                return;
+            }
+            
+            mapNew((size_t)info.st_size);
+            const FileHeader* existing = header();
+            if ((size_t)info.st_size < HEADER_BYTES || memcmp(existing->magic, fileMagic(), sizeof existing->magic) != 0 ||
+                existing->elementSize != sizeof(ValueType) || existing->headerBytes != HEADER_BYTES ||
+                existing->count < 0 || existing->count > arrayCapacity) {
+                throw runtime_error("DynamicArray: " + path + " is not an array of this element type");
+            }
+            arraySize = (int)existing->count;
+        } catch (...) {
+            if (mapping) {
+                munmap(mapping, mappedBytes);
+            }
+            close(fd);
+            throw;
+        }
+    }
+    
+    // Destructor; a file-backed array records its count and trims the file to it
+    ~DynamicArray() {
+        release();
+    }
+    
+    // Copy constructor; the copy is in anonymous memory even if other is file-backed
+    DynamicArray(const DynamicArray& other) : DynamicArray(other.arraySize) {
+        memcpy(static_cast<void*>(data), static_cast<const void*>(other.data), (size_t)other.arraySize * sizeof(ValueType));
+        arraySize = other.arraySize;
+    }
+    
+    // Move constructor; `other` is left empty with no storage
+    DynamicArray(DynamicArray&& other) noexcept
+        : fd(other.fd), mapping(other.mapping), mappedBytes(other.mappedBytes), data(other.data),
+          arraySize(other.arraySize), arrayCapacity(other.arrayCapacity), pattern(other.pattern) {
+        other.fd = -1;
+        other.mapping = nullptr;
+        other.data = nullptr;
+        other.mappedBytes = 0;
+        other.arraySize = 0;
+        other.arrayCapacity = 0;
+    }
+    
+    // Assignment operator; copies the elements into this array's storage
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            if (other.arraySize > arrayCapacity) {
+                resize(other.arraySize);
+            }
+            memcpy(static_cast<void*>(data), static_cast<const void*>(other.data), (size_t)other.arraySize * sizeof(ValueType));
+            arraySize = other.arraySize;
+        }
+        
+        return *this;
+    }
+    
+    // Move assignment operator; this array's file is closed first, and `other` is left empty with no storage
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd = other.fd;
+            mapping = other.mapping;
+            mappedBytes = other.mappedBytes;
+            data = other.data;
+            arraySize = other.arraySize;
+            arrayCapacity = other.arrayCapacity;
+            pattern = other.pattern;
+            other.fd = -1;
+            other.mapping = nullptr;
+            other.data = nullptr;
+            other.mappedBytes = 0;
+            other.arraySize = 0;
+            other.arrayCapacity = 0;
+        }
+        
+        return *this;
+    }
+    
+    // Add an element to the end of the array
+    void pushBack(const ValueType& value) {
+        emplaceBack(value);
+    }
+    
+    // Construct an element at the end of the array from `args`
+    template <typename... Args>
+    ValueType& emplaceBack(Args&&... args) {
+        // Build the element before growing, as args may refer into the array
+        ValueType value(forward<Args>(args)...);
+        if (arraySize >= arrayCapacity) {
+            ensureCapacity((long long)arraySize + 1);
+        }
+        data[arraySize] = value;
+        
+        return data[arraySize++];
+    }
+    
+    // Remove the last element; the file keeps its capacity
+    void popBack() {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        arraySize--;
+    }
+    
+    // Insert an element at a specific position
+    void insert(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Copy first, as value may be an element of this array
+        ValueType element(value);
+        openGap(position, 1);
+        data[position] = element;
+    }
+    
+    // Insert n elements at a specific position, shifting the elements after
+    // it once; `values` must not point into this array
+    void insertRange(int position, const ValueType* values, int n) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        if (n <= 0) {
+            return;
+        }
+        
+        openGap(position, n);
+        memcpy(static_cast<void*>(data + position), static_cast<const void*>(values), (size_t)n * sizeof(ValueType));
+    }
+    
+    // Remove an element at a specific position
+    void removeAt(int position) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        eraseRange(position, position + 1);
+    }
+    
+    // Remove the elements at positions [first, last), shifting the elements
+    // after them once
+    void eraseRange(int first, int last) {
+        // Check if the range is valid
+        if (first < 0 || first > last || last > arraySize) {
+            throw out_of_range("Invalid range");
+        }
+        
+        moveElements(data + first, data + last, arraySize - last);
+        arraySize -= last - first;
+    }
+    
+    // Get the element at a specific position
+    ValueType get(int position) const {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return data[position];
+    }
+    
+    // Set the element at a specific position
+    void set(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        data[position] = value;
+    }
+    
+    // Make room for at least n elements, so filling up to n never remaps
+    void reserve(int n) {
+        if (n > arrayCapacity) {
+            resize(n);
+        }
+    }
+    
+    // Get the number of elements in the array
+    int size() const {
+        return arraySize;
+    }
+    
+    // Get the current capacity of the array
+    int capacity() const {
+        return arrayCapacity;
+    }
+    
+    // Check if the array is empty
+    bool isEmpty() const {
+        return arraySize == 0;
+    }
+    
+)DSLORD"
+R"DSLORD(    // Remove all elements, shrinking the mapping (and file) back to one page
+    void clear() {
+        arraySize = 0;
+        resize(0);
+    }
+    
+    // Whether the elements are stored in a file
+    bool isFileBacked() const {
+        return fd >= 0;
+    }
+    
+    // Hint how the elements will be read. SEQUENTIAL and RANDOM stay in effect
+    // (also after the array grows); WILLNEED starts reading every page now.
+    void advise(AccessPattern hint) {
+        if (!mapping) {
+            return;
+        }
+        if (hint == ACCESS_WILLNEED) {
+            madvise(mapping, mappedBytes, MADV_WILLNEED);
+            return;
+        }
+        pattern = hint;
+        if (hint == ACCESS_NORMAL) {
+            madvise(mapping, mappedBytes, MADV_NORMAL);
+        }
+        applyPattern();
+    }
+    
+    // Record the element count in the file and write every changed page to
+    // disk, returning once they are stored; does nothing to anonymous memory
+    void sync() {
+        if (!mapping) {
+            return;
+        }
+        header()->count = arraySize;
+        if (fd >= 0 && msync(mapping, mappedBytes, MS_SYNC) != 0) {
+            fail("msync");
+        }
+    }
+    
+    // Vector scans and parallel algorithms, shared by every DynamicArray variant
+    // (dslord splices them in from snippets/fragments/array_algorithms.cpp). They
+    // use the variant's ValueType, data, arraySize, isEmpty() and moveElements(),
+    // and need the elements to be contiguous in data.
+public:
+    // Type sum() adds in: 64-bit for integers, ValueType otherwise
+    typedef conditional<is_integral<ValueType>::value,
+                        conditional<is_signed<ValueType>::value, long long, unsigned long long>::type,
+                        ValueType>::type SumType;
+    
+    // Vector instruction sets the scans can use, narrowest first
+    enum SimdLevel {
+        SIMD_SCALAR,  // plain loops
+        SIMD_SSE2,    // 16-byte vectors (SSE2, or NEON and the like off x86)
+        SIMD_AVX2,    // 32-byte vectors
+        SIMD_AVX512   // 64-byte vectors (AVX-512F)
+    };
+private:
+    // Element types the vector kernels handle: 4- and 8-byte arithmetic types
+    template <typename E>
+    struct VectorScanSupported {
+#if defined(__GNUC__)
+        static const bool value = is_arithmetic<E>::value && !is_same<E, bool>::value && (sizeof(E) == 4 || sizeof(E) == 8);
+#else
+        static const bool value = false;
+#endif
+    };
+    
+    // A scan over [data, data + n) and its results; the vector and scalar paths fill the same fields
+    template <typename E>
+    struct ScanJob {
+        enum Kind { SUM, MIN_MAX, MIN_MAX_INDEX, COUNT, FIND } kind;
+        const E* data;
+        int n;
+        const E* value;  // COUNT, FIND
+        SumType sum;     // SUM
+        E min, max;      // MIN_MAX
+        int minIndex, maxIndex;  // MIN_MAX_INDEX
+        int result;      // COUNT, FIND (-1 when not found)
+    };
+    
+    static SimdLevel detectSimdLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SIMD_AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SIMD_AVX2;
+        }
+        return __builtin_cpu_supports("sse2") ? SIMD_SSE2 : SIMD_SCALAR;
+#elif defined(__GNUC__)
+        return SIMD_SSE2;  // 16-byte vectors, e.g. NEON
+#else
+        return SIMD_SCALAR;
+#endif
+    }
+    
+    static SimdLevel& simdSetting() {
+        static SimdLevel level = detectSimdLevel();
+        return level;
+    }
+    
+    // The plain loops, for every element type and as the reference for the kernels
+    template <typename E>
+    static void scalarScan(ScanJob<E>& job) {
+        const E* p = job.data;
+        switch (job.kind) {
+        case ScanJob<E>::SUM:
+            job.sum = SumType();
+            for (int i = 0; i < job.n; i++) {
+                job.sum += p[i];
+            }
+            break;
+        case ScanJob<E>::MIN_MAX:
+        case ScanJob<E>::MIN_MAX_INDEX:
+            job.minIndex = job.maxIndex = 0;
+            for (int i = 1; i < job.n; i++) {
+                if (p[i] < p[job.minIndex]) {
+                    job.minIndex = i;
+                }
+                if (p[job.maxIndex] < p[i]) {
+                    job.maxIndex = i;
+                }
+            }
+            job.min = p[job.minIndex];
+            job.max = p[job.maxIndex];
+            break;
+        case ScanJob<E>::COUNT:
+            job.result = 0;
+            for (int i = 0; i < job.n; i++) {
+                job.result += p[i] == *job.value;
+            }
+            break;
+        case ScanJob<E>::FIND:
+            job.result = -1;
+            for (int i = 0; i < job.n; i++) {
+                if (p[i] == *job.value) {
+                    job.result = i;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    
+#if defined(__GNUC__)
+    // Kernels over BYTES-wide vectors of E, written with GCC/Clang vector
+    // extensions. They are inlined into the scan128/256/512 entry points, whose
+    // target attribute makes the compiler emit SSE2, AVX2 or AVX-512 code.
+    template <typename E, int BYTES>
+    struct VectorScan {
+        static const int LANES = BYTES / sizeof(E);
+        typedef E Vector __attribute__((vector_size(BYTES)));
+        typedef typename conditional<sizeof(E) == 4, int32_t, int64_t>::type MaskLane;
+        typedef MaskLane Mask __attribute__((vector_size(BYTES)));
+        // Sums widen E to SumType, so a load of NARROW bytes fills one accumulator
+        static const int SUM_LANES = BYTES / sizeof(SumType);
+        typedef E Narrow __attribute__((vector_size(SUM_LANES * sizeof(E))));
+        typedef typename conditional<true, SumType, E>::type SumLane;  // dependent, so vector_size applies
+        typedef SumLane Sums __attribute__((vector_size(BYTES)));
+        
+        static inline __attribute__((always_inline)) SumType sum(const E* p, int n) {
+            Sums acc = {};
+            int i = 0;
+            // 16-byte vectors have no widening load before SSE4.1; the compiler
+            // vectorizes the plain loop below better than convertvector then
+            const bool WIDENS = sizeof(E) < sizeof(SumType);
+            for (; !(BYTES == 16 && WIDENS) && i + SUM_LANES <= n; i += SUM_LANES) {
+                Narrow v;
+                memcpy(&v, p + i, sizeof v);
+                acc += __builtin_convertvector(v, Sums);
+            }
+            SumType total = SumType();
+            for (int l = 0; l < SUM_LANES; l++) {
+                total += acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i];
+            }
+            return total;
+        }
+        
+        // Smallest and largest element of a non-empty range. Every lane starts
+        // at p[0], so as in the plain loops a NaN is never taken unless it is p[0].
+        static inline __attribute__((always_inline)) void minMax(const E* p, int n, E& lo, E& hi) {
+            int i = 0;
+            lo = hi = p[0];
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    vlo = v < vlo ? v : vlo;
+                    vhi = vhi < v ? v : vhi;
+                }
+                lo = vlo[0];
+                hi = vhi[0];
+                for (int l = 1; l < LANES; l++) {
+                    lo = vlo[l] < lo ? vlo[l] : lo;
+                    hi = hi < vhi[l] ? vhi[l] : hi;
+                }
+            }
+            for (; i < n; i++) {
+                lo = p[i] < lo ? p[i] : lo;
+                hi = hi < p[i] ? p[i] : hi;
+            }
+        }
+        
+        // Positions of the first smallest and the first largest element of a
+        // non-empty range, in one pass: each lane keeps its best values and where
+        // it saw them, starting at p[0] like minMax, and ties between lanes go to
+        // the earlier position
+)DSLORD"
+R"DSLORD(        static inline __attribute__((always_inline)) void minMaxIndex(const E* p, int n, int& lo, int& hi) {
+            int i = 0;
+            lo = hi = 0;
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                Mask ilo = {}, ihi = {}, index;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                    index[l] = l;
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    Mask less = (Mask)(v < vlo);
+                    Mask more = (Mask)(vhi < v);
+                    vlo = less ? v : vlo;
+                    ilo = less ? index : ilo;
+                    vhi = more ? v : vhi;
+                    ihi = more ? index : ihi;
+                    index += LANES;
+                }
+                for (int l = 0; l < LANES; l++) {
+                    if (vlo[l] < p[lo] || (!(p[lo] < vlo[l]) && ilo[l] < lo)) {
+                        lo = (int)ilo[l];
+                    }
+                    if (p[hi] < vhi[l] || (!(vhi[l] < p[hi]) && ihi[l] < hi)) {
+                        hi = (int)ihi[l];
+                    }
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] < p[lo]) {
+                    lo = i;
+                }
+                if (p[hi] < p[i]) {
+                    hi = i;
+                }
+            }
+        }
+        
+        static inline __attribute__((always_inline)) int count(const E* p, int n, E x) {
+            // Matching lanes are -1, so subtracting counts them; a lane sees at most n / LANES matches
+            Mask acc = {};
+            int i = 0;
+            for (; i + LANES <= n; i += LANES) {
+                Vector v;
+                memcpy(&v, p + i, sizeof v);
+                acc -= (Mask)(v == x);
+            }
+            int total = 0;
+            for (int l = 0; l < LANES; l++) {
+                total += (int)acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i] == x;
+            }
+            return total;
+        }
+        
+        static inline __attribute__((always_inline)) int find(const E* p, int n, E x) {
+            // Compare a block of vectors, reduce the match mask once, and only
+            // search the block element by element when it holds a match
+            const int BLOCK = 16 * LANES;
+            int i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                Mask matches = {};
+                for (int j = 0; j < BLOCK; j += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i + j, sizeof v);
+                    matches |= (Mask)(v == x);
+                }
+                MaskLane any = 0;
+                for (int l = 0; l < LANES; l++) {
+                    any |= matches[l];
+                }
+                if (any) {
+                    break;
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] == x) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        
+        static inline __attribute__((always_inline)) void run(ScanJob<E>& job) {
+            switch (job.kind) {
+            case ScanJob<E>::SUM:
+                job.sum = sum(job.data, job.n);
+                break;
+            case ScanJob<E>::MIN_MAX:
+                minMax(job.data, job.n, job.min, job.max);
+                break;
+            case ScanJob<E>::MIN_MAX_INDEX:
+                minMaxIndex(job.data, job.n, job.minIndex, job.maxIndex);
+                job.min = job.data[job.minIndex];
+                job.max = job.data[job.maxIndex];
+                break;
+            case ScanJob<E>::COUNT:
+                job.result = count(job.data, job.n, *job.value);
+                break;
+            case ScanJob<E>::FIND:
+                job.result = find(job.data, job.n, *job.value);
+                break;
+            }
+        }
+    };
+    
+#if defined(__x86_64__) || defined(__i386__)
+    template <typename E>
+    __attribute__((target("avx512f"))) static void scan512(ScanJob<E>& job) {
+        VectorScan<E, 64>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("avx2"))) static void scan256(ScanJob<E>& job) {
+        VectorScan<E, 32>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("sse2"))) static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#else
+    template <typename E>
+    static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>& job, true_type) {
+        switch (simdLevel()) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SIMD_AVX512:
+            scan512(job);
+            return true;
+        case SIMD_AVX2:
+            scan256(job);
+            return true;
+#endif
+        case SIMD_SCALAR:
+            return false;
+        default:
+            scan128(job);
+            return true;
+        }
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>&, false_type) {
+        return false;
+    }
+    
+    // Run a scan with the kernels for simdLevel(), or the plain loops
+    template <typename E>
+    static void runScan(ScanJob<E>& job) {
+        if (!vectorScan(job, integral_constant<bool, VectorScanSupported<E>::value>())) {
+            scalarScan(job);
+        }
+    }
+    
+    template <typename E>
+    ScanJob<E> scanJob(typename ScanJob<E>::Kind kind, const E* value = nullptr) const {
+        ScanJob<E> job = ScanJob<E>();
+        job.kind = kind;
+        job.data = data;
+        job.n = arraySize;
+        job.value = value;
+        return job;
+    }
+    
+    // Tasks spawned by one parallel call; wait() returns once all have run
+    struct TaskGroup {
+        atomic<int> pending;
+        mutex errorLock;
+        exception_ptr error;  // the first exception a task threw
+        
+        TaskGroup() : pending(0) {}
+        
+        void fail(exception_ptr exception) {
+            lock_guard<mutex> lock(errorLock);
+            if (!error) {
+                error = exception;
+            }
+        }
+    };
+    
+    // Fork-join pool shared by the parallel algorithms of every array: a worker
+    // per hardware thread but one, as the calling thread runs tasks while it
+    // waits. Each worker has its own task deque. Owners push and pop at the
+    // back, and idle threads steal from the front, where the largest pieces of
+    // a halved range are. Tasks are at least a grain of elements, so a mutex per
+    // deque costs little next to the work it hands out.
+    class WorkPool {
+    public:
+        static WorkPool& instance() {
+            static WorkPool pool;
+            return pool;
+        }
+        
+        int workerCount() const {
+            return (int)workers.size();
+        }
+        
+        // Queue a task on the calling thread's deque
+        void spawn(TaskGroup& group, function<void()> task) {
+            group.pending.fetch_add(1, memory_order_relaxed);
+            TaskQueue& queue = queues[queueIndex()];
+            {
+                lock_guard<mutex> lock(queue.lock);
+                queue.tasks.push_back(Task{move(task), &group});
+            }
+            queued.fetch_add(1, memory_order_release);
+            {
+                lock_guard<mutex> lock(sleepLock);
+            }
+            wakeUp.notify_one();
+        }
+        
+        // Run tasks, the group's or others', until the group has finished;
+        // rethrows the first exception one of its tasks threw
+        void wait(TaskGroup& group) {
+            while (group.pending.load(memory_order_acquire) > 0) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                } else {
+                    this_thread::yield();
+                }
+            }
+            if (group.error) {
+                rethrow_exception(group.error);
+            }
+        }
+    private:
+        struct Task {
+            function<void()> body;
+            TaskGroup* group;
+        };
+        
+        struct TaskQueue {
+)DSLORD"
+R"DSLORD(            mutex lock;
+            deque<Task> tasks;
+        };
+        
+        vector<thread> workers;
+        unique_ptr<TaskQueue[]> queues;  // queues[0] for threads outside the pool, then one per worker
+        int queueCount;
+        atomic<int> queued;  // tasks in all queues, so idle threads skip the locks
+        mutex sleepLock;
+        condition_variable wakeUp;
+        bool stopping;
+        
+        WorkPool() : queued(0), stopping(false) {
+            int threads = std::max((int)thread::hardware_concurrency(), 1) - 1;
+            queueCount = threads + 1;
+            queues.reset(new TaskQueue[queueCount]);
+            for (int i = 1; i <= threads; i++) {
+                workers.emplace_back([this, i] {
+                    queueIndex() = i;
+                    workerLoop();
+                });
+            }
+        }
+        
+        ~WorkPool() {
+            {
+                lock_guard<mutex> lock(sleepLock);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        
+        // The deque of the calling thread: 0 unless it is a worker
+        static int& queueIndex() {
+            static thread_local int index = 0;
+            return index;
+        }
+        
+        void workerLoop() {
+            while (true) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                    continue;
+                }
+                unique_lock<mutex> lock(sleepLock);
+                wakeUp.wait(lock, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+                if (stopping) {
+                    return;
+                }
+            }
+        }
+        
+        // Pop the newest task of our own deque, or steal the oldest of another
+        bool take(Task& task) {
+            if (queued.load(memory_order_acquire) == 0) {
+                return false;
+            }
+            int own = queueIndex();
+            for (int i = 0; i < queueCount; i++) {
+                TaskQueue& queue = queues[(own + i) % queueCount];
+                lock_guard<mutex> lock(queue.lock);
+                if (!queue.tasks.empty()) {
+                    if (i == 0) {
+                        task = move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                    } else {
+                        task = move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                    }
+                    queued.fetch_sub(1, memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+        static void run(Task& task) {
+            try {
+                task.body();
+            } catch (...) {
+                task.group->fail(current_exception());
+            }
+            task.group->pending.fetch_sub(1, memory_order_release);
+        }
+    };
+    
+    static int& parallelGrainSetting() {
+        static int grain = 1 << 15;
+        return grain;
+    }
+    
+    // Whether n elements are worth splitting across the pool
+    static bool runsInParallel(int n) {
+        return n > parallelGrain() && WorkPool::instance().workerCount() > 0;
+    }
+    
+    // Run body(begin, end) on pieces of [begin, end) of at most grain
+    // elements, halving the range so that thieves take the largest pieces
+    template <typename Body>
+    static void parallelFor(int begin, int end, int grain, const Body& body) {
+        WorkPool& pool = WorkPool::instance();
+        TaskGroup group;
+        try {
+            splitRange(pool, group, begin, end, grain, body);
+        } catch (...) {
+            group.fail(current_exception());
+        }
+        pool.wait(group);
+    }
+    
+    template <typename Body>
+    static void splitRange(WorkPool& pool, TaskGroup& group, int begin, int end, int grain, const Body& body) {
+        while (end - begin > grain) {
+            int middle = begin + (end - begin) / 2;
+            pool.spawn(group, [&pool, &group, middle, end, grain, &body] {
+                splitRange(pool, group, middle, end, grain, body);
+            });
+            end = middle;
+        }
+        body(begin, end);
+    }
+    
+    // Merge the sorted runs [a, aEnd) and [b, bEnd) into out. Large merges are
+    // split at the middle element of the longer run and its position in the
+    // other run, which divides the output into two independent merges.
+    template <typename Compare>
+    static void mergeRuns(WorkPool& pool, TaskGroup& group, ValueType* a, ValueType* aEnd, ValueType* b, ValueType* bEnd,
+                          ValueType* out, int grain, const Compare& compare) {
+        while ((aEnd - a) + (bEnd - b) > grain && std::max(aEnd - a, bEnd - b) > 1) {
+            ValueType* aMiddle;
+            ValueType* bMiddle;
+            if (aEnd - a >= bEnd - b) {
+                aMiddle = a + (aEnd - a) / 2;
+                bMiddle = lower_bound(b, bEnd, *aMiddle, compare);
+            } else {
+                bMiddle = b + (bEnd - b) / 2;
+                aMiddle = upper_bound(a, aEnd, *bMiddle, compare);
+            }
+            ValueType* outMiddle = out + (aMiddle - a) + (bMiddle - b);
+            pool.spawn(group, [&pool, &group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, &compare] {
+                mergeRuns(pool, group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, compare);
+            });
+            aEnd = aMiddle;
+            bEnd = bMiddle;
+        }
+        merge(make_move_iterator(a), make_move_iterator(aEnd), make_move_iterator(b), make_move_iterator(bEnd), out, compare);
+    }
+public:
+    // Get the vector instruction set the scans use: the widest the CPU
+    // supports, unless lowered with setSimdLevel
+    static SimdLevel simdLevel() {
+        return simdSetting();
+    }
+    
+    // Limit the scans to a level, e.g. SIMD_SCALAR to compare against the
+    // plain loops; levels above what the CPU supports are lowered to it.
+    // Not safe while other threads scan.
+    static void setSimdLevel(SimdLevel level) {
+        simdSetting() = std::min(level, detectSimdLevel());
+    }
+    
+    // Sum of the elements in SumType (0 when empty)
+    template <typename T = ValueType>
+    SumType sum() const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::SUM);
+        runScan(job);
+        return job.sum;
+    }
+    
+    // Get the smallest element
+    template <typename T = ValueType>
+    ValueType min() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.min;
+    }
+    
+    // Get the largest element
+    template <typename T = ValueType>
+    ValueType max() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.max;
+    }
+    
+    // Get the positions of the first smallest and the first largest element
+    template <typename T = ValueType>
+    pair<int, int> minMaxIndex() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX_INDEX);
+        runScan(job);
+        return make_pair(job.minIndex, job.maxIndex);
+    }
+    
+    // Count the elements equal to value
+    template <typename T = ValueType>
+    int count(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::COUNT, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the position of the first element equal to value, or -1
+    template <typename T = ValueType>
+    int find(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::FIND, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the number of elements below which the parallel algorithms run
+    // sequentially, and the size of the pieces they split the array into
+    static int parallelGrain() {
+        return parallelGrainSetting();
+    }
+)DSLORD"
+R"DSLORD(    
+    // Set the grain (at least 1). Not safe while other threads run parallel algorithms.
+    static void setParallelGrain(int elements) {
+        parallelGrainSetting() = std::max(elements, 1);
+    }
+    
+    // Sort the elements with compare (ascending by default): runs are sorted
+    // in parallel, then merged pairwise, each merge itself split across threads.
+    // Not stable.
+    template <typename Compare = less<ValueType>>
+    void parallelSort(Compare compare = Compare()) {
+        if (!runsInParallel(arraySize)) {
+            sort(data, data + arraySize, compare);
+            return;
+        }
+        
+        // A few runs per thread, so the threads stay busy and few merge passes remain
+        int grain = parallelGrain();
+        int threads = WorkPool::instance().workerCount() + 1;
+        int run = std::max(grain, (arraySize + threads * 4 - 1) / (threads * 4));
+        int runs = (arraySize + run - 1) / run;
+        parallelFor(0, runs, 1, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                sort(data + r * run, data + (r == runs - 1 ? arraySize : (r + 1) * run), compare);
+            }
+        });
+        
+        unique_ptr<ValueType[]> buffer(new ValueType[arraySize]);
+        ValueType* from = data;
+        ValueType* to = buffer.get();
+        for (int width = run; width < arraySize; width = width > arraySize / 2 ? arraySize : width * 2) {
+            int pairs = (int)(((long long)arraySize + 2LL * width - 1) / (2LL * width));
+            parallelFor(0, pairs, 1, [&](int first, int last) {
+                WorkPool& pool = WorkPool::instance();
+                TaskGroup group;
+                try {
+                    for (int p = first; p < last; p++) {
+                        int low = (int)std::min<long long>(arraySize, 2LL * width * p);
+                        int middle = (int)std::min<long long>(arraySize, (long long)low + width);
+                        int high = (int)std::min<long long>(arraySize, (long long)middle + width);
+                        mergeRuns(pool, group, from + low, from + middle, from + middle, from + high, to + low, grain, compare);
+                    }
+                } catch (...) {
+                    group.fail(current_exception());
+                }
+                pool.wait(group);
+            });
+            swap(from, to);
+        }
+        if (from != data) {
+            parallelFor(0, arraySize, grain, [&](int begin, int end) {
+                moveElements(data + begin, from + begin, end - begin);
+            });
+        }
+    }
+    
+    // Replace every element with f(element); f runs on several threads at once
+    template <typename F>
+    void parallelTransform(F f) {
+        auto transform = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                data[i] = f(data[i]);
+            }
+        };
+        if (runsInParallel(arraySize)) {
+            parallelFor(0, arraySize, parallelGrain(), transform);
+        } else {
+            transform(0, arraySize);
+        }
+    }
+    
+    // Fold the elements into init with op, which must be associative: each
+    // thread reduces whole grains, and their results are combined in order
+    template <typename Op>
+    ValueType parallelReduce(ValueType init, Op op) const {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 0; i < arraySize; i++) {
+                init = op(move(init), data[i]);
+            }
+            return init;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<ValueType[]> partials(new ValueType[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                ValueType partial = data[c * grain];
+                for (int i = c * grain + 1; i < end; i++) {
+                    partial = op(move(partial), data[i]);
+                }
+                partials[c] = move(partial);
+            }
+        });
+        for (int c = 0; c < chunks; c++) {
+            init = op(move(init), partials[c]);
+        }
+        return init;
+    }
+    
+    // Replace every element with the sum of itself and all elements before it.
+    // Each grain is summed in parallel, the grain totals are added up in order,
+    // and a second parallel pass adds each grain's offset.
+    template <typename T = ValueType>
+    void parallelPrefixSum() {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 1; i < arraySize; i++) {
+                data[i] = data[i - 1] + data[i];
+            }
+            return;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<T[]> totals(new T[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain + 1; i < end; i++) {
+                    data[i] = data[i - 1] + data[i];
+                }
+                totals[c] = data[end - 1];
+            }
+        });
+        for (int c = 1; c < chunks; c++) {
+            totals[c] = totals[c - 1] + totals[c];
+        }
+        parallelFor(1, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain; i < end; i++) {
+                    data[i] = totals[c - 1] + data[i];
+                }
+            }
+        });
+    }
+    
+    // Display the array (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Array is empty" << endl;
+            return;
+        }
+        
+        cout << "Array elements: ";
+        for (int i = 0; i < arraySize; i++) {
+            cout << data[i] << " ";
+        }
+        cout << endl;
+    }
+};
+)DSLORD"
+    , 46907, 0x3e2ab3490c0c81e6ULL,
+    "#include <algorithm>\n#include <cerrno>\n#include <climits>\n#include <cstddef>\n#include <cstdint>\n#include <cstring>\n#include <fcntl.h>\n#include <string>\n#include <sys/mman.h>\n#include <sys/stat.h>\n#include <system_error>\n#include <type_traits>\n#include <unistd.h>\n#include <utility>\n#include <atomic>\n#include <condition_variable>\n#include <deque>\n#include <exception>\n#include <functional>\n#include <iterator>\n#include <memory>\n#include <mutex>\n#include <thread>\n#include <vector>\n"},
+    {"slidingwindow",
+R"DSLORD(/**
+ * SlidingWindow - Rolling minimum and maximum over a time window of samples
+ *
+ * Two monotonic deques keep only the samples that can still become the
+ * minimum (values increasing from front to rear) or the maximum (values
+ * decreasing). A new sample first removes the rear candidates it beats, so
+ * every sample enters and leaves each deque at most once: push, expireBefore,
+ * windowMin and windowMax are O(1) amortized and nothing rescans the window.
+ * The deques are growable power-of-two ring buffers like Deque's.
+ * Operations:
+ * - push: Add a sample; timestamps must not decrease
+ * - pushBulk: Add a block of samples in one pass
+ * - expireBefore: Drop the samples older than a timestamp
+ * - windowMin: Get the smallest value in the window
+ * - windowMax: Get the largest value in the window
+ * - oldestTimestamp, newestTimestamp: Get the window's time span
+ * - isEmpty: Check if the window is empty
+ * - size: Get the number of samples in the window
+ */
+class SlidingWindow {
+public:
+    // Sample value type (dslord: -slidingwindow:T=<type>)
+    typedef int ValueType;
+    typedef int64_t TimestampType;
+private:
+    // Initial capacity of each ring, a power of two
+    static const int INITIAL_CAPACITY = 64;
+    struct Sample {
+        TimestampType timestamp;
+        ValueType value;
+    };
+    // Growable circular double-ended queue of E, indexed with a mask
+    template <typename E>
+    class Ring {
+    public:
+        Ring() : data(new E[INITIAL_CAPACITY]), capacityMask(INITIAL_CAPACITY - 1), front(0), count(0) {}
+        ~Ring() {
+            delete[] data;
+        }
+        Ring(const Ring& other) : data(new E[other.capacityMask + 1]), capacityMask(other.capacityMask), front(0), count(other.count) {
+            for (int i = 0; i < count; i++) {
+                data[i] = other.data[(other.front + i) & other.capacityMask];
+            }
+        }
+        Ring& operator=(const Ring& other) {
+            if (this != &other) {
+                Ring copy(other);
+                swap(data, copy.data);
+                swap(capacityMask, copy.capacityMask);
+                swap(front, copy.front);
+                swap(count, copy.count);
+            }
+            return *this;
+        }
+        bool isEmpty() const {
+            return count == 0;
+        }
+        int size() const {
+            return count;
+        }
+        const E& first() const {
+            return data[front];
+        }
+        const E& last() const {
+            return data[(front + count - 1) & capacityMask];
+        }
+        // Grow until n more elements fit, so a batch needs no further checks
+        void reserve(int n) {
+            while (n > capacityMask + 1 - count) {
+                grow();
+            }
+        }
+        // Append; the caller has reserved room
+        void pushLast(const E& element) {
+            data[(front + count) & capacityMask] = element;
+            count++;
+        }
+        void popFirst() {
+            front = (front + 1) & capacityMask;
+            count--;
+        }
+        void popLast() {
+            count--;
+        }
+    private:
+        E* data;
+        int capacityMask;
+        int front;
+        int count;
+        // Move the elements into storage twice as large, unwrapping them to index 0;
+        // throws overflow_error when that many elements no longer fit in an int
+        void grow() {
+            int capacity = capacityMask + 1;
+            if (capacity > INT_MAX / 2) {
+                throw overflow_error("SlidingWindow Overflow");
+            }
+            E* newData = new E[capacity * 2];
+            int first = min(count, capacity - front);
+            copyElements(newData, data + front, first);
+            copyElements(newData + first, data, count - first);
+            delete[] data;
+            data = newData;
+            capacityMask = capacity * 2 - 1;
+            front = 0;
+        }
+        // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+        static void copyElements(E* to, const E* from, int n) {
+            if (n <= 0) {
+                return;
+            }
+            if (is_trivially_copyable<E>::value) {
+                memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(E));
+            } else {
+                for (int i = 0; i < n; i++) {
+                    to[i] = from[i];
+                }
+            }
+        }
+    };
+    Ring<TimestampType> timestamps;  // every sample in the window, oldest first
+    Ring<Sample> minCandidates;      // values strictly increasing from front to rear
+    Ring<Sample> maxCandidates;      // values strictly decreasing from front to rear
+    // Add one sample once every ring has room for it
+    void append(TimestampType timestamp, const ValueType& value) {
+        if (!timestamps.isEmpty() && timestamp < timestamps.last()) {
+            throw invalid_argument("SlidingWindow timestamps must not decrease");
+        }
+        while (!minCandidates.isEmpty() && !(minCandidates.last().value < value)) {
+            minCandidates.popLast();
+        }
+        while (!maxCandidates.isEmpty() && !(value < maxCandidates.last().value)) {
+            maxCandidates.popLast();
+        }
+        Sample sample = {timestamp, value};
+        minCandidates.pushLast(sample);
+        maxCandidates.pushLast(sample);
+        timestamps.pushLast(timestamp);
+    }
+public:
+    // Add a sample; throws invalid_argument if its timestamp is older than the newest
+    void push(TimestampType timestamp, const ValueType& value) {
+        timestamps.reserve(1);
+        minCandidates.reserve(1);
+        maxCandidates.reserve(1);
+        append(timestamp, value);
+    }
+    // Add n samples in one pass, growing the rings once up front; the
+    // timestamps must not decrease (the samples before a bad one are kept)
+    void pushBulk(const TimestampType* sampleTimestamps, const ValueType* values, int n) {
+        if (n <= 0) {
+            return;
+        }
+        timestamps.reserve(n);
+        minCandidates.reserve(n);
+        maxCandidates.reserve(n);
+        for (int i = 0; i < n; i++) {
+            append(sampleTimestamps[i], values[i]);
+        }
+    }
+    // Drop every sample with a timestamp before `timestamp`; returns how many were dropped
+    int expireBefore(TimestampType timestamp) {
+        int expired = 0;
+        while (!timestamps.isEmpty() && timestamps.first() < timestamp) {
+            timestamps.popFirst();
+            expired++;
+        }
+        while (!minCandidates.isEmpty() && minCandidates.first().timestamp < timestamp) {
+            minCandidates.popFirst();
+        }
+        while (!maxCandidates.isEmpty() && maxCandidates.first().timestamp < timestamp) {
+            maxCandidates.popFirst();
+        }
+        return expired;
+    }
+    // Get the smallest value in the window
+    ValueType windowMin() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+        return minCandidates.first().value;
+    }
+    // Get the largest value in the window
+    ValueType windowMax() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+        return maxCandidates.first().value;
+    }
+    // Get the timestamp of the oldest sample in the window
+    TimestampType oldestTimestamp() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+        return timestamps.first();
+    }
+    // Get the timestamp of the newest sample in the window
+    TimestampType newestTimestamp() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+        return timestamps.last();
+    }
+    // Check if the window is empty
+    bool isEmpty() const {
+        return timestamps.isEmpty();
+    }
+    // Get the number of samples in the window
+    int size() const {
+        return timestamps.size();
+    }
+    // Display the window's span, size and extremes
+    void display() const {
+        if (isEmpty()) {
+            cout << "SlidingWindow is empty" << endl;
+            return;
+        }
+)DSLORD"
+R"DSLORD(        cout << "SlidingWindow [" << oldestTimestamp() << ", " << newestTimestamp() << "]: "
+             << size() << " samples, min " << windowMin() << ", max " << windowMax() << endl;
+    }
+};
+)DSLORD"
+    , 8314, 0xc97c69031c1c8935ULL,
+    "#include <climits>\n#include <cstdint>\n#include <cstring>\n#include <type_traits>\n"},
+    {"linkedlist",
+R"DSLORD(/**
+ * LinkedList - A Singly Linked List implementation
+ * Operations:
+ * - insertAtBeginning: Insert a node at the beginning of the list
+ * - insertAtEnd: Insert a node at the end of the list
+ * - insertAt: Insert a node at a specific position
+ * - deleteNode: Delete a node with a specific value
+ * - search: Search for a node with a specific value
+ * - display: Display all nodes in the list
+ */
+class LinkedList {
+public:
+    // Element type (dslord: -linkedlist:T=<type>)
+    typedef int ValueType;
+private:
+    // Node structure for Linked List
+    struct Node {
+        ValueType data;
+        Node* next;
+        
+        // Constructor
+        Node(const ValueType& value) : data(value), next(nullptr) {}
+    };
+    
+    Node* head;
+    int nodeCount;
+public:
+    // Constructor
+    LinkedList() : head(nullptr), nodeCount(0) {}
+    
+    // Destructor to free memory
+    ~LinkedList() {
+        Node* current = head;
+        while (current != nullptr) {
+            Node* next = current->next;
+            delete current;
+            current = next;
+        }
+        head = nullptr;
+    }
+    
+    // Insert a node at the beginning of the list
+    void insertAtBeginning(const ValueType& value) {
+        Node* newNode = new Node(value);
+        newNode->next = head;
+        head = newNode;
+        nodeCount++;
+    }
+    
+    // Insert a node at the end of the list
+    void insertAtEnd(const ValueType& value) {
+        Node* newNode = new Node(value);
+        
+        // If list is empty, make the new node the head
+        if (head == nullptr) {
+            head = newNode;
+            nodeCount++;
+            return;
+        }
+        
+        // Traverse to the end of the list
+        Node* current = head;
+        while (current->next != nullptr) {
+            current = current->next;
+        }
+        
+        // Link the new node
+        current->next = newNode;
+        nodeCount++;
+    }
+    
+    // Insert a node at a specific position (0-based indexing)
+    void insertAt(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > nodeCount) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Insert at beginning if position is 0
+        if (position == 0) {
+            insertAtBeginning(value);
+            return;
+        }
+        
+        // Create new node
+        Node* newNode = new Node(value);
+        
+        // Traverse to the position
+        Node* current = head;
+        for (int i = 0; i < position - 1; i++) {
+            current = current->next;
+        }
+        
+        // Link the new node
+        newNode->next = current->next;
+        current->next = newNode;
+        nodeCount++;
+    }
+    
+    // Delete a node with a specific value
+    bool deleteNode(const ValueType& value) {
+        // Check if list is empty
+        if (head == nullptr) {
+            return false;
+        }
+        
+        // If head node has the value
+        if (head->data == value) {
+            Node* temp = head;
+            head = head->next;
+            delete temp;
+            nodeCount--;
+            return true;
+        }
+        
+        // Traverse the list to find the node with the value
+        Node* current = head;
+        while (current->next != nullptr && current->next->data != value) {
+            current = current->next;
+        }
+        
+        // If node found, delete it
+        if (current->next != nullptr) {
+            Node* temp = current->next;
+            current->next = temp->next;
+            delete temp;
+            nodeCount--;
+            return true;
+        }
+        
+        return false; // Node not found
+    }
+    
+    // Search for a node with a specific value
+    bool search(const ValueType& value) const {
+        Node* current = head;
+        while (current != nullptr) {
+            if (current->data == value) {
+                return true;
+            }
+            current = current->next;
+        }
+        return false;
+    }
+    
+    // Get the number of nodes in the list
+    int size() const {
+        return nodeCount;
+    }
+    
+    // Check if the list is empty
+    bool isEmpty() const {
+        return head == nullptr;
+    }
+    
+    // Display all nodes in the list
+    void display() const {
+        if (isEmpty()) {
+            cout << "List is empty" << endl;
+            return;
+        }
+        
+        cout << "Linked List elements: ";
+        Node* current = head;
+        while (current != nullptr) {
+            cout << current->data;
+            current = current->next;
+            if (current != nullptr) {
+                cout << " -> ";
+            }
+        }
+        cout << endl;
+    }
+}; 
+)DSLORD"
+    , 4702, 0x558f3dfb6c89328cULL,
+    ""},
+    {"doublylinkedlist",
+R"DSLORD(/**
+ * DoublyLinkedList - A Doubly Linked List implementation
+ * Operations:
+ * - insertAtBeginning: Insert a node at the beginning of the list
+ * - insertAtEnd: Insert a node at the end of the list
+ * - insertAt: Insert a node at a specific position
+ * - deleteNode: Delete a node with a specific value
+ * - search: Search for a node with a specific value
+ * - display: Display all nodes in the list (forward and backward)
+ */
+class DoublyLinkedList {
+public:
+    // Element type (dslord: -doublylinkedlist:T=<type>)
+    typedef int ValueType;
+private:
+    // Node structure for Doubly Linked List
+    struct Node {
+        ValueType data;
+        Node* next;
+        Node* prev;
+        
+        // Constructor
+        Node(const ValueType& value) : data(value), next(nullptr), prev(nullptr) {}
+    };
+    
+    Node* head;
+    Node* tail;
+    int nodeCount;
+public:
+    // Constructor
+    DoublyLinkedList() : head(nullptr), tail(nullptr), nodeCount(0) {}
+    
+    // Destructor to free memory
+    ~DoublyLinkedList() {
+        Node* current = head;
+        while (current != nullptr) {
+            Node* next = current->next;
+            delete current;
+            current = next;
+        }
+        head = nullptr;
+        tail = nullptr;
+    }
+    
+    // Insert a node at the beginning of the list
+    void insertAtBeginning(const ValueType& value) {
+        Node* newNode = new Node(value);
+        
+        // If list is empty
+        if (head == nullptr) {
+            head = newNode;
+            tail = newNode;
+        } else {
+            newNode->next = head;
+            head->prev = newNode;
+            head = newNode;
+        }
+        
+        nodeCount++;
+    }
+    
+    // Insert a node at the end of the list
+    void insertAtEnd(const ValueType& value) {
+        Node* newNode = new Node(value);
+        
+        // If list is empty
+        if (tail == nullptr) {
+            head = newNode;
+            tail = newNode;
+        } else {
+            newNode->prev = tail;
+            tail->next = newNode;
+            tail = newNode;
+        }
+        
+        nodeCount++;
+    }
+    
+    // Insert a node at a specific position (0-based indexing)
+    void insertAt(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > nodeCount) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Insert at beginning if position is 0
+        if (position == 0) {
+            insertAtBeginning(value);
+            return;
+        }
+        
+        // Insert at end if position is equal to nodeCount
+        if (position == nodeCount) {
+            insertAtEnd(value);
+            return;
+        }
+        
+        // Create new node
+        Node* newNode = new Node(value);
+        
+        // Traverse to the position
+        Node* current = head;
+        for (int i = 0; i < position; i++) {
+            current = current->next;
+        }
+        
+        // Link the new node
+        newNode->prev = current->prev;
+        newNode->next = current;
+        current->prev->next = newNode;
+        current->prev = newNode;
+        
+        nodeCount++;
+    }
+    
+    // Delete a node with a specific value
+    bool deleteNode(const ValueType& value) {
+        // Check if list is empty
+        if (head == nullptr) {
+            return false;
+        }
+        
+        // If head node has the value
+        if (head->data == value) {
+            Node* temp = head;
+            
+            // If only one node in the list
+            if (head == tail) {
+                head = nullptr;
+                tail = nullptr;
+            } else {
+                head = head->next;
+                head->prev = nullptr;
+            }
+            
+            delete temp;
+            nodeCount--;
+            return true;
+        }
+        
+        // If tail node has the value
+        if (tail->data == value) {
+            Node* temp = tail;
+            tail = tail->prev;
+            tail->next = nullptr;
+            delete temp;
+            nodeCount--;
+            return true;
+        }
+        
+        // Traverse the list to find the node with the value
+        Node* current = head->next;
+        while (current != nullptr && current->data != value) {
+            current = current->next;
+        }
+        
+        // If node found, delete it
+        if (current != nullptr) {
+            current->prev->next = current->next;
+            current->next->prev = current->prev;
+            delete current;
+            nodeCount--;
+            return true;
+        }
+        
+        return false; // Node not found
+    }
+    
+    // Search for a node with a specific value
+    bool search(const ValueType& value) const {
+        Node* current = head;
+        while (current != nullptr) {
+            if (current->data == value) {
+                return true;
+            }
+            current = current->next;
+        }
+        return false;
+    }
+    
+    // Get the number of nodes in the list
+    int size() const {
+        return nodeCount;
+    }
+    
+    // Check if the list is empty
+    bool isEmpty() const {
+        return head == nullptr;
+    }
+    
+    // Display all nodes in the list (forward)
+    void displayForward() const {
+        if (isEmpty()) {
+            cout << "List is empty" << endl;
+            return;
+        }
+        
+        cout << "Doubly Linked List (forward): ";
+        Node* current = head;
+        while (current != nullptr) {
+            cout << current->data;
+            current = current->next;
+            if (current != nullptr) {
+                cout << " <-> ";
+            }
+        }
+        cout << endl;
+    }
+    
+    // Display all nodes in the list (backward)
+    void displayBackward() const {
+        if (isEmpty()) {
+            cout << "List is empty" << endl;
+            return;
+        }
+        
+        cout << "Doubly Linked List (backward): ";
+        Node* current = tail;
+        while (current != nullptr) {
+            cout << current->data;
+            current = current->prev;
+            if (current != nullptr) {
+                cout << " <-> ";
+            }
+        }
+        cout << endl;
+    }
+    
+    // Display all nodes in the list (both ways)
+    void display() const {
+        displayForward();
+    }
+}; 
+)DSLORD"
+    , 6296, 0xb493e437f5d66ba4ULL,
+    ""},
+    {"circularlist",
+R"DSLORD(/**
+ * CircularLinkedList - A Circular Linked List implementation
+ * Operations:
+ * - insertAtBeginning: Insert a node at the beginning of the list
+ * - insertAtEnd: Insert a node at the end of the list
+ * - deleteNode: Delete a node with a specific value
+ * - search: Search for a node with a specific value
+ * - display: Display all nodes in the list
+ */
+class CircularLinkedList {
+public:
+    // Element type (dslord: -circularlist:T=<type>)
+    typedef int ValueType;
+private:
+    // Node structure for Circular Linked List
+    struct Node {
+        ValueType data;
+        Node* next;
+        
+        // Constructor
+        Node(const ValueType& value) : data(value), next(nullptr) {}
+    };
+    
+    Node* head;
+    int nodeCount;
+public:
+    // Constructor
+    CircularLinkedList() : head(nullptr), nodeCount(0) {}
+    
+    // Destructor to free memory
+    ~CircularLinkedList() {
+        if (head == nullptr) return;
+        
+        // Start at the head
+        Node* current = head;
+        Node* nextNode;
+        
+        // Free all nodes
+        do {
+            nextNode = current->next;
+            delete current;
+            current = nextNode;
+        } while (current != head);
+        
+        head = nullptr;
+    }
+    
+    // Insert a node at the beginning of the list
+    void insertAtBeginning(const ValueType& value) {
+        Node* newNode = new Node(value);
+        
+        // If list is empty
+        if (head == nullptr) {
+            head = newNode;
+            newNode->next = head; // Point to itself
+        } else {
+            // Find the last node
+            Node* last = head;
+            while (last->next != head) {
+                last = last->next;
+            }
+            
+            // Update connections
+            newNode->next = head;
+            last->next = newNode;
+            head = newNode;
+        }
+        
+        nodeCount++;
+    }
+    
+    // Insert a node at the end of the list
+    void insertAtEnd(const ValueType& value) {
+        Node* newNode = new Node(value);
+        
+        // If list is empty
+        if (head == nullptr) {
+            head = newNode;
+            newNode->next = head; // Point to itself
+        } else {
+            // Find the last node
+            Node* last = head;
+            while (last->next != head) {
+                last = last->next;
+            }
+            
+            // Update connections
+            last->next = newNode;
+            newNode->next = head;
+        }
+        
+        nodeCount++;
+    }
+    
+    // Delete a node with a specific value
+    bool deleteNode(const ValueType& value) {
+        // Check if list is empty
+        if (head == nullptr) {
+            return false;
+        }
+        
+        // If only one node and it has the value
+        if (head->next == head && head->data == value) {
+            delete head;
+            head = nullptr;
+            nodeCount--;
+            return true;
+        }
+        
+        // If head node has the value
+        if (head->data == value) {
+            // Find the last node
+            Node* last = head;
+            while (last->next != head) {
+                last = last->next;
+            }
+            
+            Node* temp = head;
+            head = head->next;
+            last->next = head;
+            delete temp;
+            nodeCount--;
+            return true;
+        }
+        
+        // Search for the node with the value
+        Node* current = head;
+        while (current->next != head && current->next->data != value) {
+            current = current->next;
+        }
+        
+        // If found, delete it
+        if (current->next != head) {
+            Node* temp = current->next;
+            current->next = temp->next;
+            delete temp;
+            nodeCount--;
+            return true;
+        }
+        
+        return false; // Not found
+    }
+    
+    // Search for a node with a specific value
+    bool search(const ValueType& value) const {
+        // Check if list is empty
+        if (head == nullptr) {
+            return false;
+        }
+        
+        // Check head
+        if (head->data == value) {
+            return true;
+        }
+        
+        // Search other nodes
+        Node* current = head->next;
+        while (current != head) {
+            if (current->data == value) {
+                return true;
+            }
+            current = current->next;
+        }
+        
+        return false;
+    }
+    
+    // Get the number of nodes in the list
+    int size() const {
+        return nodeCount;
+    }
+    
+    // Check if the list is empty
+    bool isEmpty() const {
+        return head == nullptr;
+    }
+    
+    // Display all nodes in the list
+    void display() const {
+        if (isEmpty()) {
+            cout << "List is empty" << endl;
+            return;
+        }
+        
+        cout << "Circular Linked List: ";
+        
+        Node* current = head;
+        do {
+            cout << current->data;
+            current = current->next;
+            if (current != head) {
+                cout << " -> ";
+            }
+        } while (current != head);
+        
+        cout << " -> (back to first node)" << endl;
+    }
+}; 
+)DSLORD"
+    , 5181, 0x47341808497b738dULL,
+    ""},
+    {"bst",
+R"DSLORD(/**
+ * BinarySearchTree - A Binary Search Tree implementation
+ * Operations:
+ * - insert: Insert a value
+ * - remove: Remove a value
+ * - search: Search for a value
+ * - inorderTraversal: Traverse the tree in-order
+ * - preorderTraversal: Traverse the tree pre-order
+ * - postorderTraversal: Traverse the tree post-order
+ * - getMin: Get the minimum value
+ * - getMax: Get the maximum value
+ * - getHeight: Get the height of the tree
+ * - getSize: Get the number of nodes in the tree
+ */
+class BinarySearchTree {
+public:
+    // Element type (dslord: -bst:T=<type>)
+    typedef int ValueType;
+private:
+    // Node structure for BST
+    struct Node {
+        ValueType data;
+        Node* left;
+        Node* right;
+        
+        // Constructor
+        Node(const ValueType& value) : data(value), left(nullptr), right(nullptr) {}
+    };
+    
+    Node* root;
+    int nodeCount;
+    
+    // Helper function to insert a value recursively
+    Node* insertRecursive(Node* node, const ValueType& value) {
+        // Base case: empty tree or reached leaf node
+        if (node == nullptr) {
+            nodeCount++;
+            return new Node(value);
+        }
+        
+        // Recursive case: traverse the tree
+        if (value < node->data) {
+            node->left = insertRecursive(node->left, value);
+        } else if (value > node->data) {
+            node->right = insertRecursive(node->right, value);
+        }
+        // If value already exists, don't insert
+        
+        return node;
+    }
+    
+    // Helper function to find the minimum value node
+    Node* findMin(Node* node) const {
+        // The leftmost node has the minimum value
+        while (node != nullptr && node->left != nullptr) {
+            node = node->left;
+        }
+        return node;
+    }
+    
+    // Helper function to remove a value recursively
+    Node* removeRecursive(Node* node, ValueType value) {
+        // Base case: empty tree
+        if (node == nullptr) {
+            return nullptr;
+        }
+        
+        // Recursive case: traverse the tree
+        if (value < node->data) {
+            node->left = removeRecursive(node->left, value);
+        } else if (value > node->data) {
+            node->right = removeRecursive(node->right, value);
+        } else {
+            // Found the node to remove
+            
+            // Case 1: Node has no children (leaf node)
+            if (node->left == nullptr && node->right == nullptr) {
+                delete node;
+                nodeCount--;
+                return nullptr;
+            }
+            // Case 2: Node has only one child
+            else if (node->left == nullptr) {
+                Node* temp = node->right;
+                delete node;
+                nodeCount--;
+                return temp;
+            } else if (node->right == nullptr) {
+                Node* temp = node->left;
+                delete node;
+                nodeCount--;
+                return temp;
+            }
+            // Case 3: Node has two children
+            else {
+                // Find the inorder successor (minimum in right subtree)
+                Node* successor = findMin(node->right);
+                
+                // Copy the successor's data to this node
+                node->data = successor->data;
+                
+                // Delete the successor
+                node->right = removeRecursive(node->right, successor->data);
+            }
+        }
+        
+        return node;
+    }
+    
+    // Helper function to search for a value recursively
+    bool searchRecursive(Node* node, const ValueType& value) const {
+        // Base case: empty tree or found the value
+        if (node == nullptr) {
+            return false;
+        }
+        
+        if (node->data == value) {
+            return true;
+        }
+        
+        // Recursive case: traverse the tree
+        if (value < node->data) {
+            return searchRecursive(node->left, value);
+        } else {
+            return searchRecursive(node->right, value);
+        }
+    }
+    
+    // Helper function for in-order traversal
+    void inorderRecursive(Node* node) const {
+        if (node != nullptr) {
+            inorderRecursive(node->left);
+            cout << node->data << " ";
+            inorderRecursive(node->right);
+        }
+    }
+    
+    // Helper function for pre-order traversal
+    void preorderRecursive(Node* node) const {
+        if (node != nullptr) {
+            cout << node->data << " ";
+            preorderRecursive(node->left);
+            preorderRecursive(node->right);
+        }
+    }
+    
+    // Helper function for post-order traversal
+    void postorderRecursive(Node* node) const {
+        if (node != nullptr) {
+            postorderRecursive(node->left);
+            postorderRecursive(node->right);
+            cout << node->data << " ";
+        }
+    }
+    
+    // Helper function to get the height of the tree
+    int getHeightRecursive(Node* node) const {
+        if (node == nullptr) {
+            return -1; // Height of empty tree is -1
+        }
+        
+        int leftHeight = getHeightRecursive(node->left);
+        int rightHeight = getHeightRecursive(node->right);
+        
+        return 1 + max(leftHeight, rightHeight);
+    }
+    
+    // Helper function to free all nodes
+    void destroyRecursive(Node* node) {
+        if (node != nullptr) {
+            destroyRecursive(node->left);
+            destroyRecursive(node->right);
+            delete node;
+        }
+    }
+public:
+    // Constructor
+    BinarySearchTree() : root(nullptr), nodeCount(0) {}
+    
+    // Destructor
+    ~BinarySearchTree() {
+        destroyRecursive(root);
+        root = nullptr;
+    }
+    
+    // Insert a value
+    void insert(const ValueType& value) {
+        root = insertRecursive(root, value);
+    }
+    
+    // Remove a value
+    bool remove(const ValueType& value) {
+        int prevCount = nodeCount;
+        root = removeRecursive(root, value);
+        return prevCount > nodeCount;
+    }
+    
+    // Search for a value
+    bool search(const ValueType& value) const {
+        return searchRecursive(root, value);
+    }
+    
+    // In-order traversal
+    void inorderTraversal() const {
+        if (isEmpty()) {
+            cout << "Tree is empty" << endl;
+            return;
+        }
+        
+        cout << "In-order traversal: ";
+        inorderRecursive(root);
+        cout << endl;
+    }
+    
+    // Pre-order traversal
+    void preorderTraversal() const {
+        if (isEmpty()) {
+            cout << "Tree is empty" << endl;
+            return;
+        }
+        
+        cout << "Pre-order traversal: ";
+        preorderRecursive(root);
+        cout << endl;
+    }
+    
+    // Post-order traversal
+    void postorderTraversal() const {
+        if (isEmpty()) {
+            cout << "Tree is empty" << endl;
+            return;
+        }
+        
+        cout << "Post-order traversal: ";
+        postorderRecursive(root);
+        cout << endl;
+    }
+    
+    // Get the minimum value
+    bool getMin(ValueType& value) const {
+        if (isEmpty()) {
+            return false;
+        }
+        
+        Node* minNode = findMin(root);
+        value = minNode->data;
+        return true;
+    }
+    
+    // Get the maximum value
+    bool getMax(ValueType& value) const {
+        if (isEmpty()) {
+            return false;
+        }
+        
+        // The rightmost node has the maximum value
+        Node* current = root;
+        while (current->right != nullptr) {
+            current = current->right;
+        }
+        
+        value = current->data;
+        return true;
+    }
+    
+    // Get the height of the tree
+    int getHeight() const {
+        return getHeightRecursive(root);
+    }
+    
+    // Get the number of nodes in the tree
+    int getSize() const {
+        return nodeCount;
+    }
+    
+    // Check if the tree is empty
+    bool isEmpty() const {
+        return root == nullptr;
+    }
+    
+    // Display the tree (in-order traversal)
+    void display() const {
+        inorderTraversal();
+    }
+}; 
+)DSLORD"
+    , 8021, 0x186725261c240133ULL,
+    ""},
+    {"heap",
+R"DSLORD(/**
+ * MinHeap - A Min Heap implementation
+ * Operations:
+ * - insert: Insert a value into the heap
+ * - extractMin: Extract the minimum value from the heap
+ * - getMin: Get the minimum value without removing it
+ * - size: Get the number of elements in the heap
+ * - isEmpty: Check if the heap is empty
+ */
+class MinHeap {
+public:
+    // Element type (dslord: -heap:T=<type>)
+    typedef int ValueType;
+private:
+    // Capacity (dslord: -heap:capacity=<n>). When GROWABLE is set it is only the
+    // initial capacity and the storage doubles when full (dslord: -heap:growable)
+    static const int MAX_SIZE = 1000;
+    static const bool GROWABLE = false;
+    
+    ValueType* heap;
+    int heapCapacity;
+    int heapSize;
+    
+    // Move the elements into storage twice as large; throws overflow_error
+    // when that many elements no longer fit in an int
+    void grow() {
+        if (heapCapacity > INT_MAX / 2) {
+            throw overflow_error("Heap Overflow");
+        }
+        ValueType* newHeap = new ValueType[heapCapacity * 2];
+        for (int i = 0; i < heapSize; i++) {
+            newHeap[i] = heap[i];
+        }
+        delete[] heap;
+        heap = newHeap;
+        heapCapacity *= 2;
+    }
+    
+    // Get parent index
+    int parent(int i) const {
+        return (i - 1) / 2;
+    }
+    
+    // Get left child index
+    int leftChild(int i) const {
+        return 2 * i + 1;
+    }
+    
+    // Get right child index
+    int rightChild(int i) const {
+        return 2 * i + 2;
+    }
+    
+    // Heapify up (bubble up)
+    void heapifyUp(int i) {
+        // While the node is not the root and smaller than its parent
+        while (i > 0 && heap[i] < heap[parent(i)]) {
+            // Swap with parent
+            swap(heap[i], heap[parent(i)]);
+            // Move up to parent
+            i = parent(i);
+        }
+    }
+    
+    // Heapify down (bubble down)
+    void heapifyDown(int i) {
+        int smallest = i;
+        int left = leftChild(i);
+        int right = rightChild(i);
+        
+        // If left child is smaller than current smallest
+        if (left < heapSize && heap[left] < heap[smallest]) {
+            smallest = left;
+        }
+        
+        // If right child is smaller than current smallest
+        if (right < heapSize && heap[right] < heap[smallest]) {
+            smallest = right;
+        }
+        
+        // If smallest is not the current node
+        if (smallest != i) {
+            // Swap with smallest child
+            swap(heap[i], heap[smallest]);
+            // Recursively heapify down the affected subtree
+            heapifyDown(smallest);
+        }
+    }
+public:
+    // Constructor
+    MinHeap() : heap(new ValueType[MAX_SIZE]), heapCapacity(MAX_SIZE), heapSize(0) {}
+    
+    // Destructor
+    ~MinHeap() {
+        delete[] heap;
+    }
+    
+    // Copy constructor
+    MinHeap(const MinHeap& other)
+        : heap(new ValueType[other.heapCapacity]), heapCapacity(other.heapCapacity), heapSize(other.heapSize) {
+        for (int i = 0; i < heapSize; i++) {
+            heap[i] = other.heap[i];
+        }
+    }
+    
+    // Assignment operator
+    MinHeap& operator=(const MinHeap& other) {
+        if (this != &other) {
+            MinHeap copy(other);
+            swap(heap, copy.heap);
+            swap(heapCapacity, copy.heapCapacity);
+            swap(heapSize, copy.heapSize);
+        }
+        return *this;
+    }
+    
+    // Insert a value into the heap
+    void insert(const ValueType& value) {
+        if (heapSize >= heapCapacity) {
+            if (!GROWABLE) {
+                throw overflow_error("Heap Overflow");
+            }
+            grow();
+        }
+        
+        // Add the value at the end of the heap
+        heap[heapSize] = value;
+        
+        // Restore the heap property by bubbling up
+        heapifyUp(heapSize);
+        
+        // Increment heap size
+        heapSize++;
+    }
+    
+    // Extract the minimum value from the heap
+    ValueType extractMin() {
+        if (isEmpty()) {
+            throw underflow_error("Heap Underflow");
+        }
+        
+        // Store the minimum value
+        ValueType minValue = heap[0];
+        
+        // Replace root with the last element
+        heap[0] = heap[heapSize - 1];
+        
+        // Decrement heap size
+        heapSize--;
+        
+        // Restore the heap property by bubbling down
+        heapifyDown(0);
+        
+        return minValue;
+    }
+    
+    // Get the minimum value without removing it
+    ValueType getMin() const {
+        if (isEmpty()) {
+            throw underflow_error("Heap is empty");
+        }
+        
+        return heap[0];
+    }
+    
+    // Get the number of elements in the heap
+    int size() const {
+        return heapSize;
+    }
+    
+    // Check if the heap is empty
+    bool isEmpty() const {
+        return heapSize == 0;
+    }
+    
+    // Display the heap (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Heap is empty" << endl;
+            return;
+        }
+        
+        cout << "Heap elements: ";
+        for (int i = 0; i < heapSize; i++) {
+            cout << heap[i] << " ";
+        }
+        cout << endl;
+    }
+}; 
+)DSLORD"
+    , 5169, 0xc949e8c51c3eb0d0ULL,
+    "#include <climits>\n"},
+    {"hashtable",
+R"DSLORD(/**
+ * HashTable - A Hash Table implementation using separate chaining
+ * Operations:
+ * - insert: Insert a key-value pair
+ * - remove: Remove a key
+ * - get: Get a value by key
+ * - containsKey: Check if a key exists
+ * - size: Get the number of key-value pairs
+ * - isEmpty: Check if the hash table is empty
+ */
+class HashTable {
+public:
+    // Key and value types (dslord: -hashtable:K=<type>,V=<type>)
+    typedef int KeyType;
+    typedef int ValueType;
+private:
+    // Node structure for each key-value pair
+    struct Node {
+        KeyType key;
+        ValueType value;
+        Node* next;
+        
+        // Constructor
+        Node(const KeyType& k, const ValueType& v) : key(k), value(v), next(nullptr) {}
+    };
+    
+    static const int INITIAL_CAPACITY = 16;
+    static const int MAX_LOAD_FACTOR = 75; // 75% load factor threshold
+    
+    Node** buckets;
+    int numBuckets;
+    int count;
+    
+    // Hash function
+    int hash(const KeyType& key) const {
+        return (int)(std::hash<KeyType>()(key) % (size_t)numBuckets);
+    }
+    
+    // Resize the hash table
+    void resize(int newCapacity) {
+        // Create new bucket array
+        Node** newBuckets = new Node*[newCapacity];
+        
+        // Initialize new buckets
+        for (int i = 0; i < newCapacity; i++) {
+            newBuckets[i] = nullptr;
+        }
+        
+        // Rehash existing key-value pairs
+        for (int i = 0; i < numBuckets; i++) {
+            Node* current = buckets[i];
+            while (current != nullptr) {
+                Node* next = current->next;
+                
+                // Compute new bucket index
+                int newIndex = (int)(std::hash<KeyType>()(current->key) % (size_t)newCapacity);
+                
+                // Insert at beginning of new chain
+                current->next = newBuckets[newIndex];
+                newBuckets[newIndex] = current;
+                
+                current = next;
+            }
+        }
+        
+        // Update hash table
+        delete[] buckets;
+        buckets = newBuckets;
+        numBuckets = newCapacity;
+    }
+public:
+    // Constructor
+    HashTable() : numBuckets(INITIAL_CAPACITY), count(0) {
+        buckets = new Node*[numBuckets];
+        for (int i = 0; i < numBuckets; i++) {
+            buckets[i] = nullptr;
+        }
+    }
+    
+    // Destructor
+    ~HashTable() {
+        // Free all nodes
+        for (int i = 0; i < numBuckets; i++) {
+            Node* current = buckets[i];
+            while (current != nullptr) {
+                Node* next = current->next;
+                delete current;
+                current = next;
+            }
+        }
+        
+        // Free bucket array
+        delete[] buckets;
+    }
+    
+    // Insert a key-value pair
+    void insert(const KeyType& key, const ValueType& value) {
+        // Check if resize is needed
+        if (count >= numBuckets * MAX_LOAD_FACTOR / 100) {
+            resize(numBuckets * 2);
+        }
+        
+        int index = hash(key);
+        
+        // Check if key already exists
+        Node* current = buckets[index];
+        while (current != nullptr) {
+            if (current->key == key) {
+                current->value = value; // Update value
+                return;
+            }
+            current = current->next;
+        }
+        
+        // Insert new node at beginning of chain
+        Node* newNode = new Node(key, value);
+        newNode->next = buckets[index];
+        buckets[index] = newNode;
+        count++;
+    }
+    
+    // Remove a key
+    bool remove(const KeyType& key) {
+        int index = hash(key);
+        
+        // Check if bucket is empty
+        if (buckets[index] == nullptr) {
+            return false;
+        }
+        
+        // If key is in first node
+        if (buckets[index]->key == key) {
+            Node* temp = buckets[index];
+            buckets[index] = buckets[index]->next;
+            delete temp;
+            count--;
+            return true;
+        }
+        
+        // Search for key in chain
+        Node* current = buckets[index];
+        while (current->next != nullptr && current->next->key != key) {
+            current = current->next;
+        }
+        
+        // If key found, remove it
+        if (current->next != nullptr) {
+            Node* temp = current->next;
+            current->next = temp->next;
+            delete temp;
+            count--;
+            return true;
+        }
+        
+        return false; // Key not found
+    }
+    
+    // Get a value by key
+    bool get(const KeyType& key, ValueType& value) const {
+        int index = hash(key);
+        
+        // Search for key in chain
+        Node* current = buckets[index];
+        while (current != nullptr) {
+            if (current->key == key) {
+                value = current->value;
+                return true;
+            }
+            current = current->next;
+        }
+        
+        return false; // Key not found
+    }
+    
+    // Check if a key exists
+    bool containsKey(const KeyType& key) const {
+        int index = hash(key);
+        
+        // Search for key in chain
+        Node* current = buckets[index];
+        while (current != nullptr) {
+            if (current->key == key) {
+                return true;
+            }
+            current = current->next;
+        }
+        
+        return false; // Key not found
+    }
+    
+    // Get the number of key-value pairs
+    int size() const {
+        return count;
+    }
+    
+    // Check if the hash table is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    // Display the hash table (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Hash table is empty" << endl;
+            return;
+        }
+        
+        cout << "Hash Table Contents:" << endl;
+        for (int i = 0; i < numBuckets; i++) {
+            cout << "Bucket " << i << ": ";
+            
+            Node* current = buckets[i];
+            if (current == nullptr) {
+                cout << "Empty";
+            }
+            
+            while (current != nullptr) {
+                cout << "[" << current->key << ":" << current->value << "]";
+                current = current->next;
+                if (current != nullptr) {
+                    cout << " -> ";
+                }
+            }
+            
+            cout << endl;
+        }
+    }
+}; 
+)DSLORD"
+    , 6382, 0xb2de81ef946be02fULL,
+    "#include <functional>\n"},
+};
+
+static const size_t EMBEDDED_SNIPPET_COUNT = sizeof(EMBEDDED_SNIPPETS) / sizeof(EMBEDDED_SNIPPETS[0]);
+
+#endif // DSLORD_EMBEDDED_SNIPPETS_H
@@ -1,93 +1,246 @@
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 /**
  * DynamicArray - A Dynamic Array implementation (similar to C++ vector)
+ *
+ * Trivially copyable elements are stored in malloc'd memory. Growing that
+ * memory with realloc usually extends it in place, and glibc moves large
+ * blocks with mremap instead of copying them. Those elements are also
+ * shifted and copied with memmove/memcpy. Other element types are moved one
+ * at a time.
+ * Scans over 4- and 8-byte arithmetic elements (sum, min, max, minMaxIndex,
+ * count, find) run on SSE2, AVX2 or AVX-512 vectors, picked at runtime from
+ * what the CPU supports; other element types and compilers use plain loops.
+ * The parallel algorithms split arrays larger than a grain (32768 elements by
+ * default, see setParallelGrain) across a work-stealing pool shared by all
+ * arrays; smaller arrays are processed sequentially.
  * Operations:
- * - pushBack: Add an element to the end of the array
+ * - pushBack, emplaceBack: Add an element to the end of the array
  * - popBack: Remove the last element
  * - insert: Insert an element at a specific position
+ * - insertRange: Insert a block of elements at a specific position
  * - removeAt: Remove an element at a specific position
+ * - eraseRange: Remove the elements in a range of positions
  * - get: Get the element at a specific position
  * - set: Set the element at a specific position
+ * - reserve: Make room for a number of elements up front
  * - size: Get the number of elements in the array
  * - capacity: Get the current capacity of the array
  * - isEmpty: Check if the array is empty
  * - clear: Remove all elements
+ * - sum, min, max, minMaxIndex: Reduce the elements in one pass
+ * - count, find: Count or locate the elements equal to a value
+ * - parallelSort, parallelTransform, parallelReduce, parallelPrefixSum:
+ *   Process large arrays on a shared work-stealing thread pool
  */
 class DynamicArray {
+public:
+    // Element type (dslord: -array:T=<type>)
+    typedef int ValueType;
+
 private:
-    int* data;
+    // Whether the storage comes from malloc and grows with realloc
+    static const bool REALLOCATABLE = is_trivially_copyable<ValueType>::value &&
+                                      alignof(ValueType) <= alignof(max_align_t);
+    
+    ValueType* data;
     int arraySize;
     int arrayCapacity;
+    int reservedCapacity;  // the largest reserve(); shrinking stops there
+    
+    static ValueType* allocate(int capacity) {
+        if (REALLOCATABLE) {
+            void* block = malloc((size_t)std::max(capacity, 1) * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            return static_cast<ValueType*>(block);
+        }
+        return new ValueType[capacity];
+    }
+    
+    static void release(ValueType* block) {
+        if (REALLOCATABLE) {
+            free(block);
+        } else {
+            delete[] block;
+        }
+    }
+    
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    
+    // Move n elements to a range that may overlap, as one memmove when the type allows
+    static void moveElements(ValueType* to, ValueType* from, int n) {
+        if (n <= 0 || to == from) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else if (to < from) {
+            for (int i = 0; i < n; i++) {
+                to[i] = move(from[i]);
+            }
+        } else {
+            for (int i = n - 1; i >= 0; i--) {
+                to[i] = move(from[i]);
+            }
+        }
+    }
     
     // Resize the array when needed
     void resize(int newCapacity) {
-        // Allocate new larger array
-        int* newData = new int[newCapacity];
-        
-        // Copy elements from old array to new array
-        for (int i = 0; i < arraySize; i++) {
-            newData[i] = data[i];
+        if (REALLOCATABLE) {
+            void* block = realloc(static_cast<void*>(data), (size_t)std::max(newCapacity, 1) * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            data = static_cast<ValueType*>(block);
+        } else {
+            ValueType* newData = new ValueType[newCapacity];
+            moveElements(newData, data, arraySize);
+            delete[] data;
+            data = newData;
         }
-        
-        // Free old array
-        delete[] data;
-        
-        // Update array data and capacity
-        data = newData;
         arrayCapacity = newCapacity;
     }
+    
+    // Double the capacity until `needed` elements fit, stopping at INT_MAX
+    void ensureCapacity(long long needed) {
+        if (needed > INT_MAX) {
+            throw length_error("Array cannot hold more than INT_MAX elements");
+        }
+        if (needed > arrayCapacity) {
+            long long newCapacity = std::max(arrayCapacity, 1);
+            while (newCapacity < needed) {
+                newCapacity *= 2;
+            }
+            resize((int)std::min(newCapacity, (long long)INT_MAX));
+        }
+    }
+    
+    // Halve the capacity while at most a quarter of it is used, but never below
+    // what reserve() asked for
+    void shrinkIfSparse() {
+        int newCapacity = arrayCapacity;
+        while (arraySize > 0 && arraySize <= newCapacity / 4 && newCapacity / 2 >= reservedCapacity) {
+            newCapacity /= 2;
+        }
+        if (newCapacity != arrayCapacity) {
+            resize(newCapacity);
+        }
+    }
+    
+    // Make room for n elements at a position, shifting the tail once
+    void openGap(int position, int n) {
+        ensureCapacity((long long)arraySize + n);
+        moveElements(data + position + n, data + position, arraySize - position);
+        arraySize += n;
+    }
 
 public:
     // Constructor
-    DynamicArray(int initialCapacity = 10) : arraySize(0), arrayCapacity(initialCapacity) {
+    DynamicArray(int initialCapacity = 10) : arraySize(0), reservedCapacity(0) {
         if (initialCapacity <= 0) {
             initialCapacity = 10;
         }
         
-        data = new int[initialCapacity];
+        data = allocate(initialCapacity);
+        arrayCapacity = initialCapacity;
     }
     
     // Destructor
     ~DynamicArray() {
-        delete[] data;
+        release(data);
     }
     
     // Copy constructor
-    DynamicArray(const DynamicArray& other) : arraySize(other.arraySize), arrayCapacity(other.arrayCapacity) {
-        data = new int[arrayCapacity];
-        
-        for (int i = 0; i < arraySize; i++) {
-            data[i] = other.data[i];
-        }
+    DynamicArray(const DynamicArray& other)
+        : arraySize(other.arraySize), arrayCapacity(other.arrayCapacity), reservedCapacity(other.reservedCapacity) {
+        data = allocate(arrayCapacity);
+        copyElements(data, other.data, arraySize);
+    }
+    
+    // Move constructor; `other` is left empty with no storage
+    DynamicArray(DynamicArray&& other) noexcept
+        : data(other.data), arraySize(other.arraySize), arrayCapacity(other.arrayCapacity), reservedCapacity(other.reservedCapacity) {
+        other.data = nullptr;
+        other.arraySize = 0;
+        other.arrayCapacity = 0;
+        other.reservedCapacity = 0;
     }
     
     // Assignment operator
     DynamicArray& operator=(const DynamicArray& other) {
         if (this != &other) {
-            // Free existing resources
-            delete[] data;
-            
-            // Copy from other
+            DynamicArray copy(other);
+            swap(data, copy.data);
+            swap(arraySize, copy.arraySize);
+            swap(arrayCapacity, copy.arrayCapacity);
+            swap(reservedCapacity, copy.reservedCapacity);
+        }
+        
+        return *this;
+    }
+    
+    // Move assignment operator; `other` is left empty with no storage
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            release(data);
+            data = other.data;
             arraySize = other.arraySize;
             arrayCapacity = other.arrayCapacity;
-            data = new int[arrayCapacity];
-            
-            for (int i = 0; i < arraySize; i++) {
-                data[i] = other.data[i];
-            }
+            reservedCapacity = other.reservedCapacity;
+            other.data = nullptr;
+            other.arraySize = 0;
+            other.arrayCapacity = 0;
+            other.reservedCapacity = 0;
         }
         
         return *this;
     }
     
     // Add an element to the end of the array
-    void pushBack(int value) {
-        // Check if resize is needed
+    void pushBack(const ValueType& value) {
+        emplaceBack(value);
+    }
+    
+    void pushBack(ValueType&& value) {
+        emplaceBack(move(value));
+    }
+    
+    // Construct an element at the end of the array from `args`
+    template <typename... Args>
+    ValueType& emplaceBack(Args&&... args) {
         if (arraySize >= arrayCapacity) {
-            resize(arrayCapacity * 2);
+            // Build the element before growing, as args may refer into the array
+            ValueType value(forward<Args>(args)...);
+            ensureCapacity((long long)arraySize + 1);
+            data[arraySize] = move(value);
+        } else if (REALLOCATABLE) {
+            new (data + arraySize) ValueType(forward<Args>(args)...);
+        } else {
+            data[arraySize] = ValueType(forward<Args>(args)...);
         }
         
-        // Add the element
-        data[arraySize++] = value;
+        return data[arraySize++];
     }
     
     // Remove the last element
@@ -99,31 +252,35 @@ public:
         arraySize--;
         
         // Optionally shrink the array if it gets too empty
-        if (arraySize > 0 && arraySize <= arrayCapacity / 4) {
-            resize(arrayCapacity / 2);
-        }
+        shrinkIfSparse();
     }
     
     // Insert an element at a specific position
-    void insert(int position, int value) {
+    void insert(int position, const ValueType& value) {
         // Check if position is valid
         if (position < 0 || position > arraySize) {
             throw out_of_range("Invalid position");
         }
         
-        // Check if resize is needed
-        if (arraySize >= arrayCapacity) {
-            resize(arrayCapacity * 2);
+        // Copy first, as value may be an element of this array
+        ValueType element(value);
+        openGap(position, 1);
+        data[position] = move(element);
+    }
+    
+    // Insert n elements at a specific position, shifting the elements after
+    // it once; `values` must not point into this array
+    void insertRange(int position, const ValueType* values, int n) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
         }
-        
-        // Shift elements to the right
-        for (int i = arraySize; i > position; i--) {
-            data[i] = data[i - 1];
+        if (n <= 0) {
+            return;
         }
         
-        // Insert the element
-        data[position] = value;
-        arraySize++;
+        openGap(position, n);
+        copyElements(data + position, values, n);
     }
     
     // Remove an element at a specific position
@@ -133,21 +290,26 @@ public:
             throw out_of_range("Invalid position");
         }
         
-        // Shift elements to the left
-        for (int i = position; i < arraySize - 1; i++) {
-            data[i] = data[i + 1];
+        eraseRange(position, position + 1);
+    }
+    
+    // Remove the elements at positions [first, last), shifting the elements
+    // after them once
+    void eraseRange(int first, int last) {
+        // Check if the range is valid
+        if (first < 0 || first > last || last > arraySize) {
+            throw out_of_range("Invalid range");
         }
         
-        arraySize--;
+        moveElements(data + first, data + last, arraySize - last);
+        arraySize -= last - first;
         
         // Optionally shrink the array if it gets too empty
-        if (arraySize > 0 && arraySize <= arrayCapacity / 4) {
-            resize(arrayCapacity / 2);
-        }
+        shrinkIfSparse();
     }
     
     // Get the element at a specific position
-    int get(int position) const {
+    ValueType get(int position) const {
         // Check if position is valid
         if (position < 0 || position >= arraySize) {
             throw out_of_range("Invalid position");
@@ -157,7 +319,7 @@ public:
     }
     
     // Set the element at a specific position
-    void set(int position, int value) {
+    void set(int position, const ValueType& value) {
         // Check if position is valid
         if (position < 0 || position >= arraySize) {
             throw out_of_range("Invalid position");
@@ -166,6 +328,15 @@ public:
         data[position] = value;
     }
     
+    // Make room for at least n elements, so filling up to n never reallocates;
+    // removing elements never shrinks the array below n either
+    void reserve(int n) {
+        reservedCapacity = std::max(reservedCapacity, n);
+        if (n > arrayCapacity) {
+            resize(n);
+        }
+    }
+    
     // Get the number of elements in the array
     int size() const {
         return arraySize;
@@ -185,12 +356,15 @@ public:
     void clear() {
         arraySize = 0;
         
-        // Optionally shrink the array
-        if (arrayCapacity > 10) {
-            resize(10);
+        // Optionally shrink the array, keeping any reserved capacity
+        int keep = std::max(10, reservedCapacity);
+        if (arrayCapacity > keep) {
+            resize(keep);
         }
     }
     
+    // dslord:splice array_algorithms
+    
     // Display the array (for debugging)
     void display() const {
         if (isEmpty()) {
@@ -204,4 +378,4 @@ public:
         }
         cout << endl;
     }
-}; 
\ No newline at end of file
+};
\ No newline at end of file
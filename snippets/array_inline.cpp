@@ -0,0 +1,406 @@
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * DynamicArray - A Dynamic Array that keeps its first elements inside the
+ * object (dslord: -array:inline=<n>).
+ *
+ * Up to INLINE_CAPACITY elements live in a buffer inside the object, so small
+ * arrays never allocate. Past that the elements move to the heap and grow as
+ * in the plain DynamicArray: trivially copyable elements in malloc'd storage
+ * that realloc extends, others with new[] and element moves. An array that
+ * shrinks back to the buffer's size moves back into it. Moving an array with
+ * inline elements moves them one by one; moving a heap array steals its storage.
+ * Scans (sum, min, max, minMaxIndex, count, find) use the same SSE2/AVX2/AVX-512
+ * kernels as the plain DynamicArray, and the parallel algorithms the same
+ * work-stealing pool.
+ * Operations:
+ * - pushBack, emplaceBack: Add an element to the end of the array
+ * - popBack: Remove the last element
+ * - insert: Insert an element at a specific position
+ * - insertRange: Insert a block of elements at a specific position
+ * - removeAt: Remove an element at a specific position
+ * - eraseRange: Remove the elements in a range of positions
+ * - get: Get the element at a specific position
+ * - set: Set the element at a specific position
+ * - reserve: Make room for a number of elements up front
+ * - size: Get the number of elements in the array
+ * - capacity: Get the current capacity of the array
+ * - isEmpty: Check if the array is empty
+ * - clear: Remove all elements
+ * - sum, min, max, minMaxIndex: Reduce the elements in one pass
+ * - count, find: Count or locate the elements equal to a value
+ * - parallelSort, parallelTransform, parallelReduce, parallelPrefixSum:
+ *   Process large arrays on a shared work-stealing thread pool
+ */
+class DynamicArray {
+public:
+    // Element type (dslord: -array:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Elements stored inside the object before the array allocates (dslord: -array:inline=<n>)
+    static const int INLINE_CAPACITY = 16;
+    
+    // Whether heap storage comes from malloc and grows with realloc
+    static const bool REALLOCATABLE = is_trivially_copyable<ValueType>::value &&
+                                      alignof(ValueType) <= alignof(max_align_t);
+    
+    ValueType* data;  // inlineData, or heap storage once the array outgrows it
+    int arraySize;
+    int arrayCapacity;
+    int reservedCapacity;  // the largest reserve(); shrinking stops there
+    ValueType inlineData[INLINE_CAPACITY];
+    
+    static ValueType* allocate(int capacity) {
+        if (REALLOCATABLE) {
+            void* block = malloc((size_t)capacity * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            return static_cast<ValueType*>(block);
+        }
+        return new ValueType[capacity];
+    }
+    
+    static void release(ValueType* block) {
+        if (REALLOCATABLE) {
+            free(block);
+        } else {
+            delete[] block;
+        }
+    }
+    
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    
+    // Move n elements to a range that may overlap, as one memmove when the type allows
+    static void moveElements(ValueType* to, ValueType* from, int n) {
+        if (n <= 0 || to == from) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else if (to < from) {
+            for (int i = 0; i < n; i++) {
+                to[i] = move(from[i]);
+            }
+        } else {
+            for (int i = n - 1; i >= 0; i--) {
+                to[i] = move(from[i]);
+            }
+        }
+    }
+    
+    bool isInline() const {
+        return data == inlineData;
+    }
+    
+    // Resize the array when needed; capacities up to INLINE_CAPACITY use the inline buffer
+    void resize(int newCapacity) {
+        if (newCapacity <= INLINE_CAPACITY) {
+            if (!isInline()) {
+                moveElements(inlineData, data, arraySize);
+                release(data);
+                data = inlineData;
+            }
+            arrayCapacity = INLINE_CAPACITY;
+            return;
+        }
+        
+        if (REALLOCATABLE && !isInline()) {
+            void* block = realloc(static_cast<void*>(data), (size_t)newCapacity * sizeof(ValueType));
+            if (!block) {
+                throw bad_alloc();
+            }
+            data = static_cast<ValueType*>(block);
+        } else {
+            ValueType* newData = allocate(newCapacity);
+            moveElements(newData, data, arraySize);
+            if (!isInline()) {
+                release(data);
+            }
+            data = newData;
+        }
+        arrayCapacity = newCapacity;
+    }
+    
+    // Double the capacity until `needed` elements fit, stopping at INT_MAX
+    void ensureCapacity(long long needed) {
+        if (needed > INT_MAX) {
+            throw length_error("Array cannot hold more than INT_MAX elements");
+        }
+        if (needed > arrayCapacity) {
+            long long newCapacity = arrayCapacity;
+            while (newCapacity < needed) {
+                newCapacity *= 2;
+            }
+            resize((int)std::min(newCapacity, (long long)INT_MAX));
+        }
+    }
+    
+    // Halve the capacity while at most a quarter of it is used, but never below
+    // what reserve() asked for
+    void shrinkIfSparse() {
+        int newCapacity = arrayCapacity;
+        while (arraySize > 0 && arraySize <= newCapacity / 4 && newCapacity > INLINE_CAPACITY &&
+               newCapacity / 2 >= reservedCapacity) {
+            newCapacity /= 2;
+        }
+        if (newCapacity != arrayCapacity) {
+            resize(newCapacity);
+        }
+    }
+    
+    // Make room for n elements at a position, shifting the tail once
+    void openGap(int position, int n) {
+        ensureCapacity((long long)arraySize + n);
+        moveElements(data + position + n, data + position, arraySize - position);
+        arraySize += n;
+    }
+    
+    // Take other's elements, leaving it empty with its inline buffer
+    void takeFrom(DynamicArray& other) {
+        if (other.isInline()) {
+            moveElements(inlineData, other.inlineData, other.arraySize);
+        } else {
+            data = other.data;
+            arrayCapacity = other.arrayCapacity;
+            other.data = other.inlineData;
+            other.arrayCapacity = INLINE_CAPACITY;
+        }
+        arraySize = other.arraySize;
+        reservedCapacity = other.reservedCapacity;
+        other.arraySize = 0;
+        other.reservedCapacity = 0;
+    }
+
+public:
+    // Constructor; capacities up to INLINE_CAPACITY do not allocate
+    DynamicArray(int initialCapacity = 10) : data(inlineData), arraySize(0), arrayCapacity(INLINE_CAPACITY), reservedCapacity(0) {
+        static_assert(INLINE_CAPACITY > 0, "DynamicArray inline capacity must be positive");
+        
+        if (initialCapacity > INLINE_CAPACITY) {
+            resize(initialCapacity);
+        }
+    }
+    
+    // Destructor
+    ~DynamicArray() {
+        if (!isInline()) {
+            release(data);
+        }
+    }
+    
+    // Copy constructor
+    DynamicArray(const DynamicArray& other) : DynamicArray(other.arrayCapacity) {
+        copyElements(data, other.data, other.arraySize);
+        arraySize = other.arraySize;
+        reservedCapacity = other.reservedCapacity;
+    }
+    
+    // Move constructor; `other` is left empty
+    DynamicArray(DynamicArray&& other) noexcept : data(inlineData), arraySize(0), arrayCapacity(INLINE_CAPACITY), reservedCapacity(0) {
+        takeFrom(other);
+    }
+    
+    // Assignment operator
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            DynamicArray copy(other);
+            *this = move(copy);
+        }
+        
+        return *this;
+    }
+    
+    // Move assignment operator; `other` is left empty
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            if (!isInline()) {
+                release(data);
+                data = inlineData;
+                arrayCapacity = INLINE_CAPACITY;
+            }
+            takeFrom(other);
+        }
+        
+        return *this;
+    }
+    
+    // Add an element to the end of the array
+    void pushBack(const ValueType& value) {
+        emplaceBack(value);
+    }
+    
+    void pushBack(ValueType&& value) {
+        emplaceBack(move(value));
+    }
+    
+    // Construct an element at the end of the array from `args`
+    template <typename... Args>
+    ValueType& emplaceBack(Args&&... args) {
+        if (arraySize >= arrayCapacity) {
+            // Build the element before growing, as args may refer into the array
+            ValueType value(forward<Args>(args)...);
+            ensureCapacity((long long)arraySize + 1);
+            data[arraySize] = move(value);
+        } else if (REALLOCATABLE) {
+            new (data + arraySize) ValueType(forward<Args>(args)...);
+        } else {
+            data[arraySize] = ValueType(forward<Args>(args)...);
+        }
+        
+        return data[arraySize++];
+    }
+    
+    // Remove the last element
+    void popBack() {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        arraySize--;
+        
+        // Optionally shrink the array if it gets too empty
+        shrinkIfSparse();
+    }
+    
+    // Insert an element at a specific position
+    void insert(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Copy first, as value may be an element of this array
+        ValueType element(value);
+        openGap(position, 1);
+        data[position] = move(element);
+    }
+    
+    // Insert n elements at a specific position, shifting the elements after
+    // it once; `values` must not point into this array
+    void insertRange(int position, const ValueType* values, int n) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        if (n <= 0) {
+            return;
+        }
+        
+        openGap(position, n);
+        copyElements(data + position, values, n);
+    }
+    
+    // Remove an element at a specific position
+    void removeAt(int position) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        eraseRange(position, position + 1);
+    }
+    
+    // Remove the elements at positions [first, last), shifting the elements
+    // after them once
+    void eraseRange(int first, int last) {
+        // Check if the range is valid
+        if (first < 0 || first > last || last > arraySize) {
+            throw out_of_range("Invalid range");
+        }
+        
+        moveElements(data + first, data + last, arraySize - last);
+        arraySize -= last - first;
+        
+        // Optionally shrink the array if it gets too empty
+        shrinkIfSparse();
+    }
+    
+    // Get the element at a specific position
+    ValueType get(int position) const {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return data[position];
+    }
+    
+    // Set the element at a specific position
+    void set(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        data[position] = value;
+    }
+    
+    // Make room for at least n elements, so filling up to n never reallocates;
+    // removing elements never shrinks the array below n either
+    void reserve(int n) {
+        reservedCapacity = std::max(reservedCapacity, n);
+        if (n > arrayCapacity) {
+            resize(n);
+        }
+    }
+    
+    // Get the number of elements in the array
+    int size() const {
+        return arraySize;
+    }
+    
+    // Get the current capacity of the array
+    int capacity() const {
+        return arrayCapacity;
+    }
+    
+    // Check if the array is empty
+    bool isEmpty() const {
+        return arraySize == 0;
+    }
+    
+    // Remove all elements, returning to the inline buffer unless more was reserved
+    void clear() {
+        arraySize = 0;
+        int keep = reservedCapacity > INLINE_CAPACITY ? reservedCapacity : INLINE_CAPACITY;
+        if (arrayCapacity != keep) {
+            resize(keep);
+        }
+    }
+    
+    // dslord:splice array_algorithms
+    
+    // Display the array (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Array is empty" << endl;
+            return;
+        }
+        
+        cout << "Array elements: ";
+        for (int i = 0; i < arraySize; i++) {
+            cout << data[i] << " ";
+        }
+        cout << endl;
+    }
+};
\ No newline at end of file
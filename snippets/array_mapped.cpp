@@ -0,0 +1,508 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * DynamicArray - A Dynamic Array stored in a memory-mapped file (dslord: -array:mapped)
+ *
+ * The file holds a 64-byte header (magic, element size, element count)
+ * followed by the elements exactly as they are in memory, so reopening an
+ * existing file maps it and checks the header without reading or parsing the
+ * elements. Pages are loaded on first access, and arrays can be larger than
+ * RAM. Growing extends the file with ftruncate and the mapping with mremap
+ * (munmap/mmap where mremap is missing), so the elements are never copied.
+ * madvise hints tune the kernel's read-ahead, and sync() flushes the
+ * elements and their count to the file. A default-constructed array uses an
+ * anonymous mapping instead of a file, as does a copy. Elements must be
+ * trivially copyable; they are moved with memmove. POSIX only.
+ * Scans over 4- and 8-byte arithmetic elements (sum, min, max, minMaxIndex,
+ * count, find) run on SSE2, AVX2 or AVX-512 vectors like the plain
+ * DynamicArray's, and the parallel algorithms use the same work-stealing pool.
+ * Operations:
+ * - pushBack, emplaceBack: Add an element to the end of the array
+ * - popBack: Remove the last element
+ * - insert: Insert an element at a specific position
+ * - insertRange: Insert a block of elements at a specific position
+ * - removeAt: Remove an element at a specific position
+ * - eraseRange: Remove the elements in a range of positions
+ * - get: Get the element at a specific position
+ * - set: Set the element at a specific position
+ * - reserve: Make room for a number of elements up front
+ * - size: Get the number of elements in the array
+ * - capacity: Get the current capacity of the array
+ * - isEmpty: Check if the array is empty
+ * - clear: Remove all elements
+ * - advise: Tell the kernel how the elements will be accessed
+ * - sync: Write the elements and their count to the file
+ * - sum, min, max, minMaxIndex: Reduce the elements in one pass
+ * - count, find: Count or locate the elements equal to a value
+ * - parallelSort, parallelTransform, parallelReduce, parallelPrefixSum:
+ *   Process large arrays on a shared work-stealing thread pool
+ */
+class DynamicArray {
+public:
+    // Element type (dslord: -array:T=<type>)
+    typedef int ValueType;
+    
+    // Access hints for the mapped pages, passed to madvise
+    enum AccessPattern {
+        ACCESS_NORMAL,      // default read-ahead
+        ACCESS_SEQUENTIAL,  // aggressive read-ahead; pages behind the reader can be dropped early
+        ACCESS_RANDOM,      // no read-ahead
+        ACCESS_WILLNEED     // read the whole array in now (once; keeps the current pattern)
+    };
+
+private:
+    // Bytes before the first element; keeps the elements 64-byte aligned
+    static const size_t HEADER_BYTES = 64;
+    
+    // Start of every array file
+    struct FileHeader {
+        char magic[8];
+        uint32_t elementSize;
+        uint32_t headerBytes;
+        int64_t count;  // elements in use, written by sync() and on close
+    };
+    
+    int fd;                 // the file, or -1 for an anonymous mapping
+    char* mapping;          // header followed by the elements; null once moved from
+    size_t mappedBytes;
+    ValueType* data;
+    int arraySize;
+    int arrayCapacity;
+    AccessPattern pattern;  // the last lasting hint, reapplied when the mapping moves
+    
+    static const char* fileMagic() {
+        return "DSLARRAY";
+    }
+    
+    [[noreturn]] static void fail(const string& what) {
+        throw system_error(errno, generic_category(), "DynamicArray: " + what);
+    }
+    
+    // Mapping size for a capacity: the header and elements, in whole pages
+    static size_t bytesFor(int capacity) {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t bytes = HEADER_BYTES + (size_t)capacity * sizeof(ValueType);
+        return (bytes + page - 1) / page * page;
+    }
+    
+    static int capacityOf(size_t bytes) {
+        size_t capacity = bytes > HEADER_BYTES ? (bytes - HEADER_BYTES) / sizeof(ValueType) : 0;
+        return (int)std::min(capacity, (size_t)INT_MAX);
+    }
+    
+    FileHeader* header() const {
+        return reinterpret_cast<FileHeader*>(mapping);
+    }
+    
+    void adopt(void* block, size_t bytes) {
+        mapping = static_cast<char*>(block);
+        mappedBytes = bytes;
+        data = reinterpret_cast<ValueType*>(mapping + HEADER_BYTES);
+        arrayCapacity = capacityOf(bytes);
+    }
+    
+    void mapNew(size_t bytes) {
+        void* block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                           fd >= 0 ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS, fd, 0);
+        if (block == MAP_FAILED) {
+            fail("mmap");
+        }
+        adopt(block, bytes);
+    }
+    
+    void writeHeader() {
+        memcpy(header()->magic, fileMagic(), sizeof header()->magic);
+        header()->elementSize = (uint32_t)sizeof(ValueType);
+        header()->headerBytes = (uint32_t)HEADER_BYTES;
+        header()->count = arraySize;
+    }
+    
+    void applyPattern() {
+        static const int advice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM};
+        if (mapping && pattern != ACCESS_NORMAL) {
+            madvise(mapping, mappedBytes, advice[pattern]);
+        }
+    }
+    
+    // Unmap and close, trimming the file to the elements in use
+    void release() {
+        if (!mapping) {
+            return;
+        }
+        header()->count = arraySize;
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        if (fd >= 0) {
+            if (ftruncate(fd, (off_t)(HEADER_BYTES + (size_t)arraySize * sizeof(ValueType))) != 0) {
+                // The file keeps its spare capacity; the header still has the right count
+            }
+            close(fd);
+            fd = -1;
+        }
+    }
+    
+    // Move n elements to a range that may overlap
+    static void moveElements(ValueType* to, const ValueType* from, int n) {
+        if (n > 0 && to != from) {
+            memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        }
+    }
+    
+    // Resize the mapping, and the file behind it, to hold newCapacity elements.
+    // The file grows before the mapping and shrinks after it, so no mapped page
+    // is ever past the end of the file.
+    void resize(int newCapacity) {
+        size_t newBytes = bytesFor(newCapacity);
+        if (!mapping) {
+            mapNew(newBytes);
+            writeHeader();
+            return;
+        }
+        if (fd >= 0 && newBytes > mappedBytes && ftruncate(fd, (off_t)newBytes) != 0) {
+            fail("ftruncate");
+        }
+#if defined(__linux__)
+        void* block = mremap(mapping, mappedBytes, newBytes, MREMAP_MAYMOVE);
+        if (block == MAP_FAILED) {
+            fail("mremap");
+        }
+        size_t oldBytes = mappedBytes;
+        adopt(block, newBytes);
+#else
+        char* old = mapping;
+        size_t oldBytes = mappedBytes;
+        mapNew(newBytes);
+        if (fd < 0) {
+            memcpy(mapping, old, std::min(oldBytes, newBytes));
+        }
+        munmap(old, oldBytes);
+#endif
+        if (fd >= 0 && newBytes < oldBytes && ftruncate(fd, (off_t)newBytes) != 0) {
+            fail("ftruncate");
+        }
+        applyPattern();
+    }
+    
+    // Double the capacity until `needed` elements fit, stopping at INT_MAX
+    void ensureCapacity(long long needed) {
+        if (needed > INT_MAX) {
+            throw length_error("Array cannot hold more than INT_MAX elements");
+        }
+        if (needed > arrayCapacity) {
+            long long newCapacity = std::max(arrayCapacity, 1);
+            while (newCapacity < needed) {
+                newCapacity *= 2;
+            }
+            resize((int)std::min(newCapacity, (long long)INT_MAX));
+        }
+    }
+    
+    // Make room for n elements at a position, shifting the tail once
+    void openGap(int position, int n) {
+        ensureCapacity((long long)arraySize + n);
+        moveElements(data + position + n, data + position, arraySize - position);
+        arraySize += n;
+    }
+
+public:
+    // Constructor; the elements live in anonymous memory, not in a file
+    DynamicArray(int initialCapacity = 10) : fd(-1), mapping(nullptr), mappedBytes(0), data(nullptr), arraySize(0),
+                                             arrayCapacity(0), pattern(ACCESS_NORMAL) {
+        static_assert(is_trivially_copyable<ValueType>::value, "DynamicArray:mapped needs a trivially copyable element type");
+        
+        resize(initialCapacity > 0 ? initialCapacity : 10);
+    }
+    
+    // Open the array stored in a file, creating the file if it does not exist.
+    // An existing file is mapped as it is; throws runtime_error if it is not an
+    // array of this element type, and system_error if it cannot be opened or mapped.
+    explicit DynamicArray(const string& path, int initialCapacity = 10)
+        : fd(-1), mapping(nullptr), mappedBytes(0), data(nullptr), arraySize(0), arrayCapacity(0), pattern(ACCESS_NORMAL) {
+        static_assert(is_trivially_copyable<ValueType>::value, "DynamicArray:mapped needs a trivially copyable element type");
+        
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            fail("cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            int error = errno;
+            close(fd);
+            errno = error;
+            fail("cannot stat " + path);
+        }
+        
+        try {
+            if (info.st_size == 0) {
+                size_t bytes = bytesFor(initialCapacity > 0 ? initialCapacity : 10);
+                if (ftruncate(fd, (off_t)bytes) != 0) {
+                    fail("cannot extend " + path);
+                }
+                mapNew(bytes);
+                writeHeader();
+                return;
+            }
+            
+            mapNew((size_t)info.st_size);
+            const FileHeader* existing = header();
+            if ((size_t)info.st_size < HEADER_BYTES || memcmp(existing->magic, fileMagic(), sizeof existing->magic) != 0 ||
+                existing->elementSize != sizeof(ValueType) || existing->headerBytes != HEADER_BYTES ||
+                existing->count < 0 || existing->count > arrayCapacity) {
+                throw runtime_error("DynamicArray: " + path + " is not an array of this element type");
+            }
+            arraySize = (int)existing->count;
+        } catch (...) {
+            if (mapping) {
+                munmap(mapping, mappedBytes);
+            }
+            close(fd);
+            throw;
+        }
+    }
+    
+    // Destructor; a file-backed array records its count and trims the file to it
+    ~DynamicArray() {
+        release();
+    }
+    
+    // Copy constructor; the copy is in anonymous memory even if other is file-backed
+    DynamicArray(const DynamicArray& other) : DynamicArray(other.arraySize) {
+        memcpy(static_cast<void*>(data), static_cast<const void*>(other.data), (size_t)other.arraySize * sizeof(ValueType));
+        arraySize = other.arraySize;
+    }
+    
+    // Move constructor; `other` is left empty with no storage
+    DynamicArray(DynamicArray&& other) noexcept
+        : fd(other.fd), mapping(other.mapping), mappedBytes(other.mappedBytes), data(other.data),
+          arraySize(other.arraySize), arrayCapacity(other.arrayCapacity), pattern(other.pattern) {
+        other.fd = -1;
+        other.mapping = nullptr;
+        other.data = nullptr;
+        other.mappedBytes = 0;
+        other.arraySize = 0;
+        other.arrayCapacity = 0;
+    }
+    
+    // Assignment operator; copies the elements into this array's storage
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            if (other.arraySize > arrayCapacity) {
+                resize(other.arraySize);
+            }
+            memcpy(static_cast<void*>(data), static_cast<const void*>(other.data), (size_t)other.arraySize * sizeof(ValueType));
+            arraySize = other.arraySize;
+        }
+        
+        return *this;
+    }
+    
+    // Move assignment operator; this array's file is closed first, and `other` is left empty with no storage
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd = other.fd;
+            mapping = other.mapping;
+            mappedBytes = other.mappedBytes;
+            data = other.data;
+            arraySize = other.arraySize;
+            arrayCapacity = other.arrayCapacity;
+            pattern = other.pattern;
+            other.fd = -1;
+            other.mapping = nullptr;
+            other.data = nullptr;
+            other.mappedBytes = 0;
+            other.arraySize = 0;
+            other.arrayCapacity = 0;
+        }
+        
+        return *this;
+    }
+    
+    // Add an element to the end of the array
+    void pushBack(const ValueType& value) {
+        emplaceBack(value);
+    }
+    
+    // Construct an element at the end of the array from `args`
+    template <typename... Args>
+    ValueType& emplaceBack(Args&&... args) {
+        // Build the element before growing, as args may refer into the array
+        ValueType value(forward<Args>(args)...);
+        if (arraySize >= arrayCapacity) {
+            ensureCapacity((long long)arraySize + 1);
+        }
+        data[arraySize] = value;
+        
+        return data[arraySize++];
+    }
+    
+    // Remove the last element; the file keeps its capacity
+    void popBack() {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        arraySize--;
+    }
+    
+    // Insert an element at a specific position
+    void insert(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        // Copy first, as value may be an element of this array
+        ValueType element(value);
+        openGap(position, 1);
+        data[position] = element;
+    }
+    
+    // Insert n elements at a specific position, shifting the elements after
+    // it once; `values` must not point into this array
+    void insertRange(int position, const ValueType* values, int n) {
+        // Check if position is valid
+        if (position < 0 || position > arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        if (n <= 0) {
+            return;
+        }
+        
+        openGap(position, n);
+        memcpy(static_cast<void*>(data + position), static_cast<const void*>(values), (size_t)n * sizeof(ValueType));
+    }
+    
+    // Remove an element at a specific position
+    void removeAt(int position) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        eraseRange(position, position + 1);
+    }
+    
+    // Remove the elements at positions [first, last), shifting the elements
+    // after them once
+    void eraseRange(int first, int last) {
+        // Check if the range is valid
+        if (first < 0 || first > last || last > arraySize) {
+            throw out_of_range("Invalid range");
+        }
+        
+        moveElements(data + first, data + last, arraySize - last);
+        arraySize -= last - first;
+    }
+    
+    // Get the element at a specific position
+    ValueType get(int position) const {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return data[position];
+    }
+    
+    // Set the element at a specific position
+    void set(int position, const ValueType& value) {
+        // Check if position is valid
+        if (position < 0 || position >= arraySize) {
+            throw out_of_range("Invalid position");
+        }
+        
+        data[position] = value;
+    }
+    
+    // Make room for at least n elements, so filling up to n never remaps
+    void reserve(int n) {
+        if (n > arrayCapacity) {
+            resize(n);
+        }
+    }
+    
+    // Get the number of elements in the array
+    int size() const {
+        return arraySize;
+    }
+    
+    // Get the current capacity of the array
+    int capacity() const {
+        return arrayCapacity;
+    }
+    
+    // Check if the array is empty
+    bool isEmpty() const {
+        return arraySize == 0;
+    }
+    
+    // Remove all elements, shrinking the mapping (and file) back to one page
+    void clear() {
+        arraySize = 0;
+        resize(0);
+    }
+    
+    // Whether the elements are stored in a file
+    bool isFileBacked() const {
+        return fd >= 0;
+    }
+    
+    // Hint how the elements will be read. SEQUENTIAL and RANDOM stay in effect
+    // (also after the array grows); WILLNEED starts reading every page now.
+    void advise(AccessPattern hint) {
+        if (!mapping) {
+            return;
+        }
+        if (hint == ACCESS_WILLNEED) {
+            madvise(mapping, mappedBytes, MADV_WILLNEED);
+            return;
+        }
+        pattern = hint;
+        if (hint == ACCESS_NORMAL) {
+            madvise(mapping, mappedBytes, MADV_NORMAL);
+        }
+        applyPattern();
+    }
+    
+    // Record the element count in the file and write every changed page to
+    // disk, returning once they are stored; does nothing to anonymous memory
+    void sync() {
+        if (!mapping) {
+            return;
+        }
+        header()->count = arraySize;
+        if (fd >= 0 && msync(mapping, mappedBytes, MS_SYNC) != 0) {
+            fail("msync");
+        }
+    }
+    
+    // dslord:splice array_algorithms
+    
+    // Display the array (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Array is empty" << endl;
+            return;
+        }
+        
+        cout << "Array elements: ";
+        for (int i = 0; i < arraySize; i++) {
+            cout << data[i] << " ";
+        }
+        cout << endl;
+    }
+};
\ No newline at end of file
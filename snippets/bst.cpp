@@ -13,22 +13,26 @@
  * - getSize: Get the number of nodes in the tree
  */
 class BinarySearchTree {
+public:
+    // Element type (dslord: -bst:T=<type>)
+    typedef int ValueType;
+
 private:
     // Node structure for BST
     struct Node {
-        int data;
+        ValueType data;
         Node* left;
         Node* right;
         
         // Constructor
-        Node(int value) : data(value), left(nullptr), right(nullptr) {}
+        Node(const ValueType& value) : data(value), left(nullptr), right(nullptr) {}
     };
     
     Node* root;
     int nodeCount;
     
     // Helper function to insert a value recursively
-    Node* insertRecursive(Node* node, int value) {
+    Node* insertRecursive(Node* node, const ValueType& value) {
         // Base case: empty tree or reached leaf node
         if (node == nullptr) {
             nodeCount++;
@@ -56,7 +60,7 @@ private:
     }
     
     // Helper function to remove a value recursively
-    Node* removeRecursive(Node* node, int value) {
+    Node* removeRecursive(Node* node, ValueType value) {
         // Base case: empty tree
         if (node == nullptr) {
             return nullptr;
@@ -105,7 +109,7 @@ private:
     }
     
     // Helper function to search for a value recursively
-    bool searchRecursive(Node* node, int value) const {
+    bool searchRecursive(Node* node, const ValueType& value) const {
         // Base case: empty tree or found the value
         if (node == nullptr) {
             return false;
@@ -182,19 +186,19 @@ public:
     }
     
     // Insert a value
-    void insert(int value) {
+    void insert(const ValueType& value) {
         root = insertRecursive(root, value);
     }
     
     // Remove a value
-    bool remove(int value) {
+    bool remove(const ValueType& value) {
         int prevCount = nodeCount;
         root = removeRecursive(root, value);
         return prevCount > nodeCount;
     }
     
     // Search for a value
-    bool search(int value) const {
+    bool search(const ValueType& value) const {
         return searchRecursive(root, value);
     }
     
@@ -235,7 +239,7 @@ public:
     }
     
     // Get the minimum value
-    bool getMin(int& value) const {
+    bool getMin(ValueType& value) const {
         if (isEmpty()) {
             return false;
         }
@@ -246,7 +250,7 @@ public:
     }
     
     // Get the maximum value
-    bool getMax(int& value) const {
+    bool getMax(ValueType& value) const {
         if (isEmpty()) {
             return false;
         }
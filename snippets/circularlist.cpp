@@ -8,14 +8,18 @@
  * - display: Display all nodes in the list
  */
 class CircularLinkedList {
+public:
+    // Element type (dslord: -circularlist:T=<type>)
+    typedef int ValueType;
+
 private:
     // Node structure for Circular Linked List
     struct Node {
-        int data;
+        ValueType data;
         Node* next;
         
         // Constructor
-        Node(int value) : data(value), next(nullptr) {}
+        Node(const ValueType& value) : data(value), next(nullptr) {}
     };
     
     Node* head;
@@ -44,7 +48,7 @@ public:
     }
     
     // Insert a node at the beginning of the list
-    void insertAtBeginning(int value) {
+    void insertAtBeginning(const ValueType& value) {
         Node* newNode = new Node(value);
         
         // If list is empty
@@ -68,7 +72,7 @@ public:
     }
     
     // Insert a node at the end of the list
-    void insertAtEnd(int value) {
+    void insertAtEnd(const ValueType& value) {
         Node* newNode = new Node(value);
         
         // If list is empty
@@ -91,7 +95,7 @@ public:
     }
     
     // Delete a node with a specific value
-    bool deleteNode(int value) {
+    bool deleteNode(const ValueType& value) {
         // Check if list is empty
         if (head == nullptr) {
             return false;
@@ -140,7 +144,7 @@ public:
     }
     
     // Search for a node with a specific value
-    bool search(int value) const {
+    bool search(const ValueType& value) const {
         // Check if list is empty
         if (head == nullptr) {
             return false;
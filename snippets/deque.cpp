@@ -1,3 +1,7 @@
+#include <climits>
+#include <cstring>
+#include <type_traits>
+
 /**
  * Deque - A Double-ended Queue implementation
  * Operations:
@@ -5,6 +9,8 @@
  * - insertRear: Insert an element at the rear
  * - deleteFront: Delete the front element
  * - deleteRear: Delete the rear element
+ * - insertFrontBulk, insertRearBulk: Insert a block of elements at either end
+ * - deleteFrontBulk, deleteRearBulk: Delete a block of elements from either end
  * - getFront: Get the front element
  * - getRear: Get the rear element
  * - isEmpty: Check if the deque is empty
@@ -12,24 +18,117 @@
  * - size: Get the number of elements in the deque
  */
 class Deque {
+public:
+    // Element type (dslord: -deque:T=<type>)
+    typedef int ValueType;
+
 private:
-    static const int MAX_SIZE = 1000;
-    int data[MAX_SIZE];
+    // Capacity, a power of two so indices wrap with a mask (dslord: -deque:capacity=<n>).
+    // When GROWABLE is set it is only the initial capacity and the storage doubles
+    // when full (dslord: -deque:growable)
+    static const int MAX_SIZE = 1024;
+    static const bool GROWABLE = false;
+    
+    ValueType* data;
+    int capacityMask;
     int front;
-    int rear;
     int count;
+    
+    // Index of the rear element
+    int rearIndex() const {
+        return (front + count - 1) & capacityMask;
+    }
+    
+    // Move the elements into storage twice as large, unwrapping them to index 0;
+    // throws overflow_error when that many elements no longer fit in an int
+    void grow() {
+        int capacity = capacityMask + 1;
+        if (capacity > INT_MAX / 2) {
+            throw overflow_error("Deque Overflow");
+        }
+        ValueType* newData = new ValueType[capacity * 2];
+        for (int i = 0; i < count; i++) {
+            newData[i] = data[(front + i) & capacityMask];
+        }
+        delete[] data;
+        data = newData;
+        capacityMask = capacity * 2 - 1;
+        front = 0;
+    }
+    
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+    
+    // Copy n elements into the ring starting at index start, wrapping at most once
+    void copyIn(int start, const ValueType* values, int n) {
+        int first = min(n, capacityMask + 1 - start);
+        copyElements(data + start, values, first);
+        copyElements(data, values + first, n - first);
+    }
+    
+    // Copy n elements out of the ring starting at index start, wrapping at most once
+    void copyOut(int start, ValueType* values, int n) const {
+        int first = min(n, capacityMask + 1 - start);
+        copyElements(values, data + start, first);
+        copyElements(values + first, data, n - first);
+    }
+    
+    // How many of n new elements fit, growing first when growable
+    int roomFor(int n) {
+        while (GROWABLE && n > capacityMask + 1 - count) {
+            grow();
+        }
+        return max(0, min(n, capacityMask + 1 - count));
+    }
 
 public:
     // Constructor
-    Deque() {
-        front = -1;
-        rear = 0;
+    Deque() : data(new ValueType[MAX_SIZE]), capacityMask(MAX_SIZE - 1) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Deque capacity must be a power of two");
+        front = 0;
         count = 0;
     }
     
-    // Check if the deque is full
+    // Destructor
+    ~Deque() {
+        delete[] data;
+    }
+    
+    // Copy constructor
+    Deque(const Deque& other) : data(new ValueType[other.capacityMask + 1]), capacityMask(other.capacityMask) {
+        front = 0;
+        count = other.count;
+        for (int i = 0; i < count; i++) {
+            data[i] = other.data[(other.front + i) & other.capacityMask];
+        }
+    }
+    
+    // Assignment operator
+    Deque& operator=(const Deque& other) {
+        if (this != &other) {
+            Deque copy(other);
+            swap(data, copy.data);
+            swap(capacityMask, copy.capacityMask);
+            swap(front, copy.front);
+            swap(count, copy.count);
+        }
+        return *this;
+    }
+    
+    // Check if the deque is full (never true for a growable deque)
     bool isFull() const {
-        return count == MAX_SIZE;
+        return !GROWABLE && count > capacityMask;
     }
     
     // Check if the deque is empty
@@ -38,85 +137,95 @@ public:
     }
     
     // Insert an element at the front
-    void insertFront(int value) {
+    void insertFront(const ValueType& value) {
         if (isFull()) {
             throw overflow_error("Deque Overflow");
         }
-        
-        // If deque is empty
-        if (isEmpty()) {
-            front = rear = 0;
-        } else {
-            // Update front
-            front = (front - 1 + MAX_SIZE) % MAX_SIZE;
+        if (count > capacityMask) {
+            grow();
         }
         
+        front = (front - 1) & capacityMask;
         data[front] = value;
         count++;
     }
     
     // Insert an element at the rear
-    void insertRear(int value) {
+    void insertRear(const ValueType& value) {
         if (isFull()) {
             throw overflow_error("Deque Overflow");
         }
-        
-        // If deque is empty
-        if (isEmpty()) {
-            front = rear = 0;
-        } else {
-            // Update rear
-            rear = (rear + 1) % MAX_SIZE;
+        if (count > capacityMask) {
+            grow();
         }
         
-        data[rear] = value;
+        data[(front + count) & capacityMask] = value;
         count++;
     }
     
     // Delete the front element
-    int deleteFront() {
+    ValueType deleteFront() {
         if (isEmpty()) {
             throw underflow_error("Deque Underflow");
         }
         
-        int value = data[front];
-        
-        // If deque has only one element
-        if (front == rear) {
-            front = -1;
-            rear = 0;
-        } else {
-            // Update front
-            front = (front + 1) % MAX_SIZE;
-        }
-        
+        ValueType value = data[front];
+        front = (front + 1) & capacityMask;
         count--;
         return value;
     }
     
     // Delete the rear element
-    int deleteRear() {
+    ValueType deleteRear() {
         if (isEmpty()) {
             throw underflow_error("Deque Underflow");
         }
         
-        int value = data[rear];
-        
-        // If deque has only one element
-        if (front == rear) {
-            front = -1;
-            rear = 0;
-        } else {
-            // Update rear
-            rear = (rear - 1 + MAX_SIZE) % MAX_SIZE;
-        }
-        
+        ValueType value = data[rearIndex()];
         count--;
         return value;
     }
     
+    // Insert up to n elements from `values` at the front, keeping their order
+    // (values[0] becomes the front); returns how many fit (all when growable)
+    int insertFrontBulk(const ValueType* values, int n) {
+        n = roomFor(n);
+        front = (front - n) & capacityMask;
+        copyIn(front, values, n);
+        count += n;
+        return n;
+    }
+    
+    // Insert up to n elements from `values` at the rear, in order; returns how
+    // many fit (all when growable)
+    int insertRearBulk(const ValueType* values, int n) {
+        n = roomFor(n);
+        copyIn((front + count) & capacityMask, values, n);
+        count += n;
+        return n;
+    }
+    
+    // Delete up to n elements from the front into `values`, front first;
+    // returns how many were deleted
+    int deleteFrontBulk(ValueType* values, int n) {
+        n = max(0, min(n, count));
+        copyOut(front, values, n);
+        front = (front + n) & capacityMask;
+        count -= n;
+        return n;
+    }
+    
+    // Delete up to n elements from the rear into `values`, in front-to-rear
+    // order; returns how many were deleted
+    int deleteRearBulk(ValueType* values, int n) {
+        n = max(0, min(n, count));
+        copyOut((front + count - n) & capacityMask, values, n);
+        count -= n;
+        return n;
+    }
+    
     // Get the front element
-    int getFront() const {
+    ValueType getFront() const {
         if (isEmpty()) {
             throw underflow_error("Deque is empty");
         }
@@ -125,12 +234,12 @@ public:
     }
     
     // Get the rear element
-    int getRear() const {
+    ValueType getRear() const {
         if (isEmpty()) {
             throw underflow_error("Deque is empty");
         }
         
-        return data[rear];
+        return data[rearIndex()];
     }
     
     // Get the number of elements in the deque
@@ -146,21 +255,11 @@ public:
         }
         
         cout << "Deque elements: ";
-        int i = front;
-        
-        // Special handling for a single element
-        if (count == 1) {
-            cout << data[front] << endl;
-            return;
-        }
         
         // Traverse from front to rear
-        while (i != rear) {
-            cout << data[i] << " ";
-            i = (i + 1) % MAX_SIZE;
+        for (int i = 0; i < count; i++) {
+            cout << data[(front + i) & capacityMask] << (i + 1 < count ? " " : "");
         }
-        
-        // Print the last element
-        cout << data[rear] << endl;
+        cout << endl;
     }
-}; 
\ No newline at end of file
+};
\ No newline at end of file
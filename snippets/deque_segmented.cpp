@@ -0,0 +1,340 @@
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+using namespace std;
+
+/**
+ * Deque - A Double-ended Queue implementation backed by fixed-size blocks and
+ * a map of block pointers, like std::deque (dslord: -deque:segmented).
+ *
+ * Growing at either end allocates one block and at most moves block pointers
+ * in the map, never elements, so inserting is O(1) without reallocation
+ * stalls and references to elements stay valid until those elements are
+ * deleted. Element i is found with one shift and one mask, so operator[] and
+ * the random-access iterators are O(1). One emptied block is kept as a spare
+ * so pushing and popping across a block boundary does not allocate every time.
+ * Operations:
+ * - insertFront: Insert an element at the front
+ * - insertRear: Insert an element at the rear
+ * - deleteFront: Delete the front element
+ * - deleteRear: Delete the rear element
+ * - getFront: Get the front element
+ * - getRear: Get the rear element
+ * - operator[], get: Access the element at a position from the front
+ * - begin, end: Random-access iterators from front to rear
+ * - isEmpty: Check if the deque is empty
+ * - isFull: Check if the deque is full (never true)
+ * - size: Get the number of elements in the deque
+ */
+class Deque {
+public:
+    // Element type (dslord: -deque:T=<type>)
+    typedef int ValueType;
+    
+private:
+    // Elements per block, a power of two so a position splits with a shift and a mask
+    static const int BLOCK_BITS = 10;
+    static const size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+    static const size_t BLOCK_MASK = BLOCK_SIZE - 1;
+    
+    // Smallest block map
+    static const size_t MIN_MAP_SIZE = 8;
+    
+    ValueType** map;      // block pointers; blocks in use are map[mapStart, mapStart + blockCount)
+    size_t mapSize;
+    size_t mapStart;
+    size_t blockCount;
+    size_t offset;        // position of the front element in map[mapStart]
+    size_t count;
+    ValueType* spareBlock;  // an emptied block kept for reuse, or nullptr
+    
+    ValueType* allocateBlock() {
+        ValueType* block = spareBlock;
+        if (block) {
+            spareBlock = nullptr;
+        } else {
+            block = new ValueType[BLOCK_SIZE];
+        }
+        return block;
+    }
+    
+    void releaseBlock(ValueType* block) {
+        if (spareBlock) {
+            delete[] block;
+        } else {
+            spareBlock = block;
+        }
+    }
+    
+    // Make room for one more block pointer at either end of the map. When the
+    // map is at most half used the blocks are recentered in place, otherwise
+    // they move to a map twice as large; either way only pointers move.
+    void remap() {
+        size_t newSize = (blockCount + 1) * 2 <= mapSize ? mapSize : mapSize * 2;
+        size_t newStart = (newSize - blockCount) / 2;
+        if (newSize == mapSize) {
+            memmove(map + newStart, map + mapStart, blockCount * sizeof(ValueType*));
+        } else {
+            ValueType** newMap = new ValueType*[newSize];
+            memcpy(newMap + newStart, map + mapStart, blockCount * sizeof(ValueType*));
+            delete[] map;
+            map = newMap;
+            mapSize = newSize;
+        }
+        mapStart = newStart;
+    }
+    
+    void addBlockFront() {
+        if (mapStart == 0) {
+            remap();
+        }
+        map[--mapStart] = allocateBlock();
+        blockCount++;
+        offset += BLOCK_SIZE;
+    }
+    
+    void addBlockRear() {
+        if (mapStart + blockCount == mapSize) {
+            remap();
+        }
+        map[mapStart + blockCount++] = allocateBlock();
+    }
+    
+    // Release the last block once the deque is empty, recentering the map
+    void resetIfEmpty() {
+        if (count == 0 && blockCount > 0) {
+            releaseBlock(map[mapStart]);
+            blockCount = 0;
+            offset = 0;
+            mapStart = mapSize / 2;
+        }
+    }
+    
+    // Element at a position counted from the start of the first block
+    ValueType& slot(size_t position) const {
+        return map[mapStart + (position >> BLOCK_BITS)][position & BLOCK_MASK];
+    }
+    
+    // Iterator over positions from the front; it stays valid while no element
+    // is inserted or deleted at the front
+    template <typename Reference, typename Pointer>
+    class Iterator {
+    public:
+        typedef random_access_iterator_tag iterator_category;
+        typedef ValueType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Pointer pointer;
+        typedef Reference reference;
+        
+        Iterator() : deque(nullptr), index(0) {}
+        
+        // An iterator converts to a const_iterator
+        operator Iterator<const ValueType&, const ValueType*>() const {
+            return Iterator<const ValueType&, const ValueType*>(deque, index);
+        }
+        
+        Reference operator*() const { return deque->slot(deque->offset + index); }
+        Pointer operator->() const { return &deque->slot(deque->offset + index); }
+        Reference operator[](difference_type n) const { return deque->slot(deque->offset + index + n); }
+        
+        Iterator& operator++() { index++; return *this; }
+        Iterator operator++(int) { Iterator old = *this; index++; return old; }
+        Iterator& operator--() { index--; return *this; }
+        Iterator operator--(int) { Iterator old = *this; index--; return old; }
+        Iterator& operator+=(difference_type n) { index += n; return *this; }
+        Iterator& operator-=(difference_type n) { index -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(deque, index + n); }
+        Iterator operator-(difference_type n) const { return Iterator(deque, index - n); }
+        friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+        
+        // Differences and comparisons also mix iterators with const_iterators
+        template <typename R, typename P>
+        difference_type operator-(const Iterator<R, P>& other) const { return (difference_type)(index - other.index); }
+        template <typename R, typename P>
+        bool operator==(const Iterator<R, P>& other) const { return index == other.index; }
+        template <typename R, typename P>
+        bool operator!=(const Iterator<R, P>& other) const { return index != other.index; }
+        template <typename R, typename P>
+        bool operator<(const Iterator<R, P>& other) const { return index < other.index; }
+        template <typename R, typename P>
+        bool operator>(const Iterator<R, P>& other) const { return index > other.index; }
+        template <typename R, typename P>
+        bool operator<=(const Iterator<R, P>& other) const { return index <= other.index; }
+        template <typename R, typename P>
+        bool operator>=(const Iterator<R, P>& other) const { return index >= other.index; }
+        
+    private:
+        friend class Deque;
+        template <typename R, typename P>
+        friend class Iterator;
+        Iterator(const Deque* deque, size_t index) : deque(deque), index(index) {}
+        const Deque* deque;
+        size_t index;
+    };
+    
+public:
+    typedef Iterator<ValueType&, ValueType*> iterator;
+    typedef Iterator<const ValueType&, const ValueType*> const_iterator;
+    
+    // Constructor
+    Deque() : map(new ValueType*[MIN_MAP_SIZE]), mapSize(MIN_MAP_SIZE), mapStart(MIN_MAP_SIZE / 2),
+              blockCount(0), offset(0), count(0), spareBlock(nullptr) {}
+    
+    // Destructor
+    ~Deque() {
+        for (size_t i = 0; i < blockCount; i++) {
+            delete[] map[mapStart + i];
+        }
+        delete[] map;
+        delete[] spareBlock;
+    }
+    
+    // Copy constructor
+    Deque(const Deque& other) : Deque() {
+        for (size_t i = 0; i < other.count; i++) {
+            insertRear(other[i]);
+        }
+    }
+    
+    // Assignment operator
+    Deque& operator=(const Deque& other) {
+        if (this != &other) {
+            Deque copy(other);
+            swap(map, copy.map);
+            swap(mapSize, copy.mapSize);
+            swap(mapStart, copy.mapStart);
+            swap(blockCount, copy.blockCount);
+            swap(offset, copy.offset);
+            swap(count, copy.count);
+            swap(spareBlock, copy.spareBlock);
+        }
+        return *this;
+    }
+    
+    // Check if the deque is full (never: it grows a block at a time)
+    bool isFull() const {
+        return false;
+    }
+    
+    // Check if the deque is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    // Insert an element at the front
+    void insertFront(const ValueType& value) {
+        if (offset == 0) {
+            addBlockFront();
+        }
+        
+        slot(offset - 1) = value;
+        offset--;
+        count++;
+    }
+    
+    // Insert an element at the rear
+    void insertRear(const ValueType& value) {
+        if (offset + count == blockCount * BLOCK_SIZE) {
+            addBlockRear();
+        }
+        
+        slot(offset + count) = value;
+        count++;
+    }
+    
+    // Delete the front element
+    ValueType deleteFront() {
+        if (isEmpty()) {
+            throw underflow_error("Deque Underflow");
+        }
+        
+        ValueType value = slot(offset);
+        offset++;
+        count--;
+        if (offset == BLOCK_SIZE && count > 0) {
+            releaseBlock(map[mapStart++]);
+            blockCount--;
+            offset = 0;
+        }
+        resetIfEmpty();
+        return value;
+    }
+    
+    // Delete the rear element
+    ValueType deleteRear() {
+        if (isEmpty()) {
+            throw underflow_error("Deque Underflow");
+        }
+        
+        count--;
+        ValueType value = slot(offset + count);
+        if (((offset + count) & BLOCK_MASK) == 0 && count > 0) {
+            releaseBlock(map[mapStart + --blockCount]);
+        }
+        resetIfEmpty();
+        return value;
+    }
+    
+    // Get the front element
+    ValueType getFront() const {
+        if (isEmpty()) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return slot(offset);
+    }
+    
+    // Get the rear element
+    ValueType getRear() const {
+        if (isEmpty()) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return slot(offset + count - 1);
+    }
+    
+    // Element at a position from the front (unchecked)
+    ValueType& operator[](size_t position) {
+        return slot(offset + position);
+    }
+    
+    const ValueType& operator[](size_t position) const {
+        return slot(offset + position);
+    }
+    
+    // Get the element at a position from the front
+    ValueType get(size_t position) const {
+        if (position >= count) {
+            throw out_of_range("Invalid position");
+        }
+        
+        return slot(offset + position);
+    }
+    
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+    
+    // Get the number of elements in the deque
+    size_t size() const {
+        return count;
+    }
+    
+    // Display all elements in the deque
+    void display() const {
+        if (isEmpty()) {
+            cout << "Deque is empty" << endl;
+            return;
+        }
+        
+        cout << "Deque elements: ";
+        
+        // Traverse from front to rear
+        for (size_t i = 0; i < count; i++) {
+            cout << slot(offset + i) << (i + 1 < count ? " " : "");
+        }
+        cout << endl;
+    }
+};
@@ -0,0 +1,216 @@
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+/**
+ * Deque - A lock-free work-stealing double-ended queue (Chase-Lev, with the
+ * C11 memory orderings of Le et al.) for task schedulers (dslord: -deque:workstealing).
+ *
+ * One owner thread inserts and deletes at the rear; any thread may steal from
+ * the front. The owner only touches its `bottom` index and issues a fence, so
+ * pushing and popping need no atomic read-modify-write unless a thief and the
+ * owner race for the last element. Thieves claim elements with one
+ * compare-and-swap on `top`. The circular buffer doubles when full; a thief
+ * may still be reading the old buffer, so retired buffers are only freed by
+ * the destructor (at most as much memory again as the final buffer).
+ * Elements are read by thieves before they are claimed, so ValueType must be
+ * trivially copyable (a task pointer or index, typically).
+ * Operations:
+ * - insertRear: Insert an element at the rear (owner only)
+ * - deleteRear, tryDeleteRear: Delete the rear element (owner only)
+ * - deleteFront, trySteal: Steal the front element (any thread)
+ * - getRear: Get the rear element (owner only)
+ * - isEmpty: Check if the deque is empty
+ * - isFull: Check if the deque is full (never true)
+ * - size: Get the number of elements in the deque
+ */
+class Deque {
+public:
+    // Element type (dslord: -deque:T=<type>)
+    typedef int ValueType;
+    
+private:
+    static_assert(is_trivially_copyable<ValueType>::value, "Work-stealing Deque elements must be trivially copyable");
+    
+    // Initial capacity, a power of two
+    static const int64_t INITIAL_CAPACITY = 64;
+    static const size_t CACHE_LINE = 64;
+    
+    // Circular storage indexed by the free-running top and bottom counters
+    struct Buffer {
+        int64_t mask;
+        atomic<ValueType>* slots;
+        
+        explicit Buffer(int64_t capacity) : mask(capacity - 1), slots(new atomic<ValueType>[capacity]) {}
+        ~Buffer() {
+            delete[] slots;
+        }
+        
+        ValueType get(int64_t index) const {
+            return slots[index & mask].load(memory_order_relaxed);
+        }
+        void put(int64_t index, ValueType value) {
+            slots[index & mask].store(value, memory_order_relaxed);
+        }
+    };
+    
+    alignas(CACHE_LINE) atomic<int64_t> top;     // next element to steal
+    alignas(CACHE_LINE) atomic<int64_t> bottom;  // next free slot at the rear (owner)
+    atomic<Buffer*> buffer;
+    vector<Buffer*> retired;                     // old buffers thieves may still read (owner)
+    
+    // Copy [top, bottom) into a buffer twice as large and publish it
+    Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+        Buffer* larger = new Buffer((old->mask + 1) * 2);
+        for (int64_t i = t; i < b; i++) {
+            larger->put(i, old->get(i));
+        }
+        retired.push_back(old);
+        buffer.store(larger, memory_order_release);
+        return larger;
+    }
+    
+    // One steal attempt: 1 stolen, 0 empty, -1 lost a race (worth retrying)
+    int stealOnce(ValueType& value) {
+        int64_t t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = bottom.load(memory_order_acquire);
+        if (t >= b) {
+            return 0;
+        }
+        
+        value = buffer.load(memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            return -1;
+        }
+        return 1;
+    }
+    
+public:
+    // Constructor
+    Deque() : top(0), bottom(0), buffer(new Buffer(INITIAL_CAPACITY)) {}
+    
+    // Destructor (no other thread may still be using the deque)
+    ~Deque() {
+        delete buffer.load(memory_order_relaxed);
+        for (Buffer* old : retired) {
+            delete old;
+        }
+    }
+    
+    // Thieves hold on to the deque, so it cannot be copied
+    Deque(const Deque&) = delete;
+    Deque& operator=(const Deque&) = delete;
+    
+    // Check if the deque is full (never: the buffer grows)
+    bool isFull() const {
+        return false;
+    }
+    
+    // Check if the deque is empty (a snapshot under concurrent use)
+    bool isEmpty() const {
+        return size() == 0;
+    }
+    
+    // Insert an element at the rear (owner only)
+    void insertRear(const ValueType& value) {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_acquire);
+        Buffer* current = buffer.load(memory_order_relaxed);
+        if (b - t > current->mask) {
+            current = grow(current, t, b);
+        }
+        
+        current->put(b, value);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
+    }
+    
+    // Delete the rear element into `value`; false when the deque is empty or
+    // a thief took the last element (owner only)
+    bool tryDeleteRear(ValueType& value) {
+        int64_t b = bottom.load(memory_order_relaxed) - 1;
+        Buffer* current = buffer.load(memory_order_relaxed);
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = top.load(memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);
+            return false;
+        }
+        
+        value = current->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+            bottom.store(b + 1, memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    
+    // Delete the rear element (owner only)
+    ValueType deleteRear() {
+        ValueType value;
+        if (!tryDeleteRear(value)) {
+            throw underflow_error("Deque Underflow");
+        }
+        return value;
+    }
+    
+    // Steal the front element into `value`; false when the deque is empty or
+    // another thread won the race for it (any thread)
+    bool trySteal(ValueType& value) {
+        return stealOnce(value) == 1;
+    }
+    
+    // Steal the front element, retrying lost races (any thread)
+    ValueType deleteFront() {
+        ValueType value;
+        int result;
+        while ((result = stealOnce(value)) < 0) {
+        }
+        if (result == 0) {
+            throw underflow_error("Deque Underflow");
+        }
+        return value;
+    }
+    
+    // Get the rear element (owner only; a thief may steal it meanwhile)
+    ValueType getRear() const {
+        int64_t b = bottom.load(memory_order_relaxed);
+        if (top.load(memory_order_acquire) >= b) {
+            throw underflow_error("Deque is empty");
+        }
+        
+        return buffer.load(memory_order_relaxed)->get(b - 1);
+    }
+    
+    // Get the number of elements in the deque (a snapshot under concurrent use)
+    int size() const {
+        int64_t b = bottom.load(memory_order_acquire);
+        int64_t t = top.load(memory_order_acquire);
+        return (int)max((int64_t)0, b - t);
+    }
+    
+    // Display all elements in the deque (for debugging, while no thread is using it)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Deque is empty" << endl;
+            return;
+        }
+        
+        cout << "Deque elements: ";
+        
+        // Traverse from front to rear
+        Buffer* current = buffer.load(memory_order_acquire);
+        int64_t b = bottom.load(memory_order_acquire);
+        for (int64_t i = top.load(memory_order_acquire); i < b; i++) {
+            cout << current->get(i) << (i + 1 < b ? " " : "");
+        }
+        cout << endl;
+    }
+};
@@ -9,15 +9,19 @@
  * - display: Display all nodes in the list (forward and backward)
  */
 class DoublyLinkedList {
+public:
+    // Element type (dslord: -doublylinkedlist:T=<type>)
+    typedef int ValueType;
+
 private:
     // Node structure for Doubly Linked List
     struct Node {
-        int data;
+        ValueType data;
         Node* next;
         Node* prev;
         
         // Constructor
-        Node(int value) : data(value), next(nullptr), prev(nullptr) {}
+        Node(const ValueType& value) : data(value), next(nullptr), prev(nullptr) {}
     };
     
     Node* head;
@@ -41,7 +45,7 @@ public:
     }
     
     // Insert a node at the beginning of the list
-    void insertAtBeginning(int value) {
+    void insertAtBeginning(const ValueType& value) {
         Node* newNode = new Node(value);
         
         // If list is empty
@@ -58,7 +62,7 @@ public:
     }
     
     // Insert a node at the end of the list
-    void insertAtEnd(int value) {
+    void insertAtEnd(const ValueType& value) {
         Node* newNode = new Node(value);
         
         // If list is empty
@@ -75,7 +79,7 @@ public:
     }
     
     // Insert a node at a specific position (0-based indexing)
-    void insertAt(int position, int value) {
+    void insertAt(int position, const ValueType& value) {
         // Check if position is valid
         if (position < 0 || position > nodeCount) {
             throw out_of_range("Invalid position");
@@ -112,7 +116,7 @@ public:
     }
     
     // Delete a node with a specific value
-    bool deleteNode(int value) {
+    bool deleteNode(const ValueType& value) {
         // Check if list is empty
         if (head == nullptr) {
             return false;
@@ -165,7 +169,7 @@ public:
     }
     
     // Search for a node with a specific value
-    bool search(int value) const {
+    bool search(const ValueType& value) const {
         Node* current = head;
         while (current != nullptr) {
             if (current->data == value) {
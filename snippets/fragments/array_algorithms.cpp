@@ -0,0 +1,809 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+    // Vector scans and parallel algorithms, shared by every DynamicArray variant
+    // (dslord splices them in from snippets/fragments/array_algorithms.cpp). They
+    // use the variant's ValueType, data, arraySize, isEmpty() and moveElements(),
+    // and need the elements to be contiguous in data.
+public:
+    // Type sum() adds in: 64-bit for integers, ValueType otherwise
+    typedef conditional<is_integral<ValueType>::value,
+                        conditional<is_signed<ValueType>::value, long long, unsigned long long>::type,
+                        ValueType>::type SumType;
+    
+    // Vector instruction sets the scans can use, narrowest first
+    enum SimdLevel {
+        SIMD_SCALAR,  // plain loops
+        SIMD_SSE2,    // 16-byte vectors (SSE2, or NEON and the like off x86)
+        SIMD_AVX2,    // 32-byte vectors
+        SIMD_AVX512   // 64-byte vectors (AVX-512F)
+    };
+
+private:
+    // Element types the vector kernels handle: 4- and 8-byte arithmetic types
+    template <typename E>
+    struct VectorScanSupported {
+#if defined(__GNUC__)
+        static const bool value = is_arithmetic<E>::value && !is_same<E, bool>::value && (sizeof(E) == 4 || sizeof(E) == 8);
+#else
+        static const bool value = false;
+#endif
+    };
+    
+    // A scan over [data, data + n) and its results; the vector and scalar paths fill the same fields
+    template <typename E>
+    struct ScanJob {
+        enum Kind { SUM, MIN_MAX, MIN_MAX_INDEX, COUNT, FIND } kind;
+        const E* data;
+        int n;
+        const E* value;  // COUNT, FIND
+        SumType sum;     // SUM
+        E min, max;      // MIN_MAX
+        int minIndex, maxIndex;  // MIN_MAX_INDEX
+        int result;      // COUNT, FIND (-1 when not found)
+    };
+    
+    static SimdLevel detectSimdLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SIMD_AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SIMD_AVX2;
+        }
+        return __builtin_cpu_supports("sse2") ? SIMD_SSE2 : SIMD_SCALAR;
+#elif defined(__GNUC__)
+        return SIMD_SSE2;  // 16-byte vectors, e.g. NEON
+#else
+        return SIMD_SCALAR;
+#endif
+    }
+    
+    static SimdLevel& simdSetting() {
+        static SimdLevel level = detectSimdLevel();
+        return level;
+    }
+    
+    // The plain loops, for every element type and as the reference for the kernels
+    template <typename E>
+    static void scalarScan(ScanJob<E>& job) {
+        const E* p = job.data;
+        switch (job.kind) {
+        case ScanJob<E>::SUM:
+            job.sum = SumType();
+            for (int i = 0; i < job.n; i++) {
+                job.sum += p[i];
+            }
+            break;
+        case ScanJob<E>::MIN_MAX:
+        case ScanJob<E>::MIN_MAX_INDEX:
+            job.minIndex = job.maxIndex = 0;
+            for (int i = 1; i < job.n; i++) {
+                if (p[i] < p[job.minIndex]) {
+                    job.minIndex = i;
+                }
+                if (p[job.maxIndex] < p[i]) {
+                    job.maxIndex = i;
+                }
+            }
+            job.min = p[job.minIndex];
+            job.max = p[job.maxIndex];
+            break;
+        case ScanJob<E>::COUNT:
+            job.result = 0;
+            for (int i = 0; i < job.n; i++) {
+                job.result += p[i] == *job.value;
+            }
+            break;
+        case ScanJob<E>::FIND:
+            job.result = -1;
+            for (int i = 0; i < job.n; i++) {
+                if (p[i] == *job.value) {
+                    job.result = i;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    
+#if defined(__GNUC__)
+    // Kernels over BYTES-wide vectors of E, written with GCC/Clang vector
+    // extensions. They are inlined into the scan128/256/512 entry points, whose
+    // target attribute makes the compiler emit SSE2, AVX2 or AVX-512 code.
+    template <typename E, int BYTES>
+    struct VectorScan {
+        static const int LANES = BYTES / sizeof(E);
+        typedef E Vector __attribute__((vector_size(BYTES)));
+        typedef typename conditional<sizeof(E) == 4, int32_t, int64_t>::type MaskLane;
+        typedef MaskLane Mask __attribute__((vector_size(BYTES)));
+        // Sums widen E to SumType, so a load of NARROW bytes fills one accumulator
+        static const int SUM_LANES = BYTES / sizeof(SumType);
+        typedef E Narrow __attribute__((vector_size(SUM_LANES * sizeof(E))));
+        typedef typename conditional<true, SumType, E>::type SumLane;  // dependent, so vector_size applies
+        typedef SumLane Sums __attribute__((vector_size(BYTES)));
+        
+        static inline __attribute__((always_inline)) SumType sum(const E* p, int n) {
+            Sums acc = {};
+            int i = 0;
+            // 16-byte vectors have no widening load before SSE4.1; the compiler
+            // vectorizes the plain loop below better than convertvector then
+            const bool WIDENS = sizeof(E) < sizeof(SumType);
+            for (; !(BYTES == 16 && WIDENS) && i + SUM_LANES <= n; i += SUM_LANES) {
+                Narrow v;
+                memcpy(&v, p + i, sizeof v);
+                acc += __builtin_convertvector(v, Sums);
+            }
+            SumType total = SumType();
+            for (int l = 0; l < SUM_LANES; l++) {
+                total += acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i];
+            }
+            return total;
+        }
+        
+        // Smallest and largest element of a non-empty range. Every lane starts
+        // at p[0], so as in the plain loops a NaN is never taken unless it is p[0].
+        static inline __attribute__((always_inline)) void minMax(const E* p, int n, E& lo, E& hi) {
+            int i = 0;
+            lo = hi = p[0];
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    vlo = v < vlo ? v : vlo;
+                    vhi = vhi < v ? v : vhi;
+                }
+                lo = vlo[0];
+                hi = vhi[0];
+                for (int l = 1; l < LANES; l++) {
+                    lo = vlo[l] < lo ? vlo[l] : lo;
+                    hi = hi < vhi[l] ? vhi[l] : hi;
+                }
+            }
+            for (; i < n; i++) {
+                lo = p[i] < lo ? p[i] : lo;
+                hi = hi < p[i] ? p[i] : hi;
+            }
+        }
+        
+        // Positions of the first smallest and the first largest element of a
+        // non-empty range, in one pass: each lane keeps its best values and where
+        // it saw them, starting at p[0] like minMax, and ties between lanes go to
+        // the earlier position
+        static inline __attribute__((always_inline)) void minMaxIndex(const E* p, int n, int& lo, int& hi) {
+            int i = 0;
+            lo = hi = 0;
+            if (n >= LANES) {
+                Vector vlo, vhi;
+                Mask ilo = {}, ihi = {}, index;
+                for (int l = 0; l < LANES; l++) {
+                    vlo[l] = p[0];
+                    index[l] = l;
+                }
+                vhi = vlo;
+                for (; i + LANES <= n; i += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i, sizeof v);
+                    Mask less = (Mask)(v < vlo);
+                    Mask more = (Mask)(vhi < v);
+                    vlo = less ? v : vlo;
+                    ilo = less ? index : ilo;
+                    vhi = more ? v : vhi;
+                    ihi = more ? index : ihi;
+                    index += LANES;
+                }
+                for (int l = 0; l < LANES; l++) {
+                    if (vlo[l] < p[lo] || (!(p[lo] < vlo[l]) && ilo[l] < lo)) {
+                        lo = (int)ilo[l];
+                    }
+                    if (p[hi] < vhi[l] || (!(vhi[l] < p[hi]) && ihi[l] < hi)) {
+                        hi = (int)ihi[l];
+                    }
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] < p[lo]) {
+                    lo = i;
+                }
+                if (p[hi] < p[i]) {
+                    hi = i;
+                }
+            }
+        }
+        
+        static inline __attribute__((always_inline)) int count(const E* p, int n, E x) {
+            // Matching lanes are -1, so subtracting counts them; a lane sees at most n / LANES matches
+            Mask acc = {};
+            int i = 0;
+            for (; i + LANES <= n; i += LANES) {
+                Vector v;
+                memcpy(&v, p + i, sizeof v);
+                acc -= (Mask)(v == x);
+            }
+            int total = 0;
+            for (int l = 0; l < LANES; l++) {
+                total += (int)acc[l];
+            }
+            for (; i < n; i++) {
+                total += p[i] == x;
+            }
+            return total;
+        }
+        
+        static inline __attribute__((always_inline)) int find(const E* p, int n, E x) {
+            // Compare a block of vectors, reduce the match mask once, and only
+            // search the block element by element when it holds a match
+            const int BLOCK = 16 * LANES;
+            int i = 0;
+            for (; i + BLOCK <= n; i += BLOCK) {
+                Mask matches = {};
+                for (int j = 0; j < BLOCK; j += LANES) {
+                    Vector v;
+                    memcpy(&v, p + i + j, sizeof v);
+                    matches |= (Mask)(v == x);
+                }
+                MaskLane any = 0;
+                for (int l = 0; l < LANES; l++) {
+                    any |= matches[l];
+                }
+                if (any) {
+                    break;
+                }
+            }
+            for (; i < n; i++) {
+                if (p[i] == x) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        
+        static inline __attribute__((always_inline)) void run(ScanJob<E>& job) {
+            switch (job.kind) {
+            case ScanJob<E>::SUM:
+                job.sum = sum(job.data, job.n);
+                break;
+            case ScanJob<E>::MIN_MAX:
+                minMax(job.data, job.n, job.min, job.max);
+                break;
+            case ScanJob<E>::MIN_MAX_INDEX:
+                minMaxIndex(job.data, job.n, job.minIndex, job.maxIndex);
+                job.min = job.data[job.minIndex];
+                job.max = job.data[job.maxIndex];
+                break;
+            case ScanJob<E>::COUNT:
+                job.result = count(job.data, job.n, *job.value);
+                break;
+            case ScanJob<E>::FIND:
+                job.result = find(job.data, job.n, *job.value);
+                break;
+            }
+        }
+    };
+    
+#if defined(__x86_64__) || defined(__i386__)
+    template <typename E>
+    __attribute__((target("avx512f"))) static void scan512(ScanJob<E>& job) {
+        VectorScan<E, 64>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("avx2"))) static void scan256(ScanJob<E>& job) {
+        VectorScan<E, 32>::run(job);
+    }
+    
+    template <typename E>
+    __attribute__((target("sse2"))) static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#else
+    template <typename E>
+    static void scan128(ScanJob<E>& job) {
+        VectorScan<E, 16>::run(job);
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>& job, true_type) {
+        switch (simdLevel()) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SIMD_AVX512:
+            scan512(job);
+            return true;
+        case SIMD_AVX2:
+            scan256(job);
+            return true;
+#endif
+        case SIMD_SCALAR:
+            return false;
+        default:
+            scan128(job);
+            return true;
+        }
+    }
+#endif
+    
+    template <typename E>
+    static bool vectorScan(ScanJob<E>&, false_type) {
+        return false;
+    }
+    
+    // Run a scan with the kernels for simdLevel(), or the plain loops
+    template <typename E>
+    static void runScan(ScanJob<E>& job) {
+        if (!vectorScan(job, integral_constant<bool, VectorScanSupported<E>::value>())) {
+            scalarScan(job);
+        }
+    }
+    
+    template <typename E>
+    ScanJob<E> scanJob(typename ScanJob<E>::Kind kind, const E* value = nullptr) const {
+        ScanJob<E> job = ScanJob<E>();
+        job.kind = kind;
+        job.data = data;
+        job.n = arraySize;
+        job.value = value;
+        return job;
+    }
+    
+    // Tasks spawned by one parallel call; wait() returns once all have run
+    struct TaskGroup {
+        atomic<int> pending;
+        mutex errorLock;
+        exception_ptr error;  // the first exception a task threw
+        
+        TaskGroup() : pending(0) {}
+        
+        void fail(exception_ptr exception) {
+            lock_guard<mutex> lock(errorLock);
+            if (!error) {
+                error = exception;
+            }
+        }
+    };
+    
+    // Fork-join pool shared by the parallel algorithms of every array: a worker
+    // per hardware thread but one, as the calling thread runs tasks while it
+    // waits. Each worker has its own task deque. Owners push and pop at the
+    // back, and idle threads steal from the front, where the largest pieces of
+    // a halved range are. Tasks are at least a grain of elements, so a mutex per
+    // deque costs little next to the work it hands out.
+    class WorkPool {
+    public:
+        static WorkPool& instance() {
+            static WorkPool pool;
+            return pool;
+        }
+        
+        int workerCount() const {
+            return (int)workers.size();
+        }
+        
+        // Queue a task on the calling thread's deque
+        void spawn(TaskGroup& group, function<void()> task) {
+            group.pending.fetch_add(1, memory_order_relaxed);
+            TaskQueue& queue = queues[queueIndex()];
+            {
+                lock_guard<mutex> lock(queue.lock);
+                queue.tasks.push_back(Task{move(task), &group});
+            }
+            queued.fetch_add(1, memory_order_release);
+            {
+                lock_guard<mutex> lock(sleepLock);
+            }
+            wakeUp.notify_one();
+        }
+        
+        // Run tasks, the group's or others', until the group has finished;
+        // rethrows the first exception one of its tasks threw
+        void wait(TaskGroup& group) {
+            while (group.pending.load(memory_order_acquire) > 0) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                } else {
+                    this_thread::yield();
+                }
+            }
+            if (group.error) {
+                rethrow_exception(group.error);
+            }
+        }
+
+    private:
+        struct Task {
+            function<void()> body;
+            TaskGroup* group;
+        };
+        
+        struct TaskQueue {
+            mutex lock;
+            deque<Task> tasks;
+        };
+        
+        vector<thread> workers;
+        unique_ptr<TaskQueue[]> queues;  // queues[0] for threads outside the pool, then one per worker
+        int queueCount;
+        atomic<int> queued;  // tasks in all queues, so idle threads skip the locks
+        mutex sleepLock;
+        condition_variable wakeUp;
+        bool stopping;
+        
+        WorkPool() : queued(0), stopping(false) {
+            int threads = std::max((int)thread::hardware_concurrency(), 1) - 1;
+            queueCount = threads + 1;
+            queues.reset(new TaskQueue[queueCount]);
+            for (int i = 1; i <= threads; i++) {
+                workers.emplace_back([this, i] {
+                    queueIndex() = i;
+                    workerLoop();
+                });
+            }
+        }
+        
+        ~WorkPool() {
+            {
+                lock_guard<mutex> lock(sleepLock);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+        
+        // The deque of the calling thread: 0 unless it is a worker
+        static int& queueIndex() {
+            static thread_local int index = 0;
+            return index;
+        }
+        
+        void workerLoop() {
+            while (true) {
+                Task task;
+                if (take(task)) {
+                    run(task);
+                    continue;
+                }
+                unique_lock<mutex> lock(sleepLock);
+                wakeUp.wait(lock, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+                if (stopping) {
+                    return;
+                }
+            }
+        }
+        
+        // Pop the newest task of our own deque, or steal the oldest of another
+        bool take(Task& task) {
+            if (queued.load(memory_order_acquire) == 0) {
+                return false;
+            }
+            int own = queueIndex();
+            for (int i = 0; i < queueCount; i++) {
+                TaskQueue& queue = queues[(own + i) % queueCount];
+                lock_guard<mutex> lock(queue.lock);
+                if (!queue.tasks.empty()) {
+                    if (i == 0) {
+                        task = move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                    } else {
+                        task = move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                    }
+                    queued.fetch_sub(1, memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+        static void run(Task& task) {
+            try {
+                task.body();
+            } catch (...) {
+                task.group->fail(current_exception());
+            }
+            task.group->pending.fetch_sub(1, memory_order_release);
+        }
+    };
+    
+    static int& parallelGrainSetting() {
+        static int grain = 1 << 15;
+        return grain;
+    }
+    
+    // Whether n elements are worth splitting across the pool
+    static bool runsInParallel(int n) {
+        return n > parallelGrain() && WorkPool::instance().workerCount() > 0;
+    }
+    
+    // Run body(begin, end) on pieces of [begin, end) of at most grain
+    // elements, halving the range so that thieves take the largest pieces
+    template <typename Body>
+    static void parallelFor(int begin, int end, int grain, const Body& body) {
+        WorkPool& pool = WorkPool::instance();
+        TaskGroup group;
+        try {
+            splitRange(pool, group, begin, end, grain, body);
+        } catch (...) {
+            group.fail(current_exception());
+        }
+        pool.wait(group);
+    }
+    
+    template <typename Body>
+    static void splitRange(WorkPool& pool, TaskGroup& group, int begin, int end, int grain, const Body& body) {
+        while (end - begin > grain) {
+            int middle = begin + (end - begin) / 2;
+            pool.spawn(group, [&pool, &group, middle, end, grain, &body] {
+                splitRange(pool, group, middle, end, grain, body);
+            });
+            end = middle;
+        }
+        body(begin, end);
+    }
+    
+    // Merge the sorted runs [a, aEnd) and [b, bEnd) into out. Large merges are
+    // split at the middle element of the longer run and its position in the
+    // other run, which divides the output into two independent merges.
+    template <typename Compare>
+    static void mergeRuns(WorkPool& pool, TaskGroup& group, ValueType* a, ValueType* aEnd, ValueType* b, ValueType* bEnd,
+                          ValueType* out, int grain, const Compare& compare) {
+        while ((aEnd - a) + (bEnd - b) > grain && std::max(aEnd - a, bEnd - b) > 1) {
+            ValueType* aMiddle;
+            ValueType* bMiddle;
+            if (aEnd - a >= bEnd - b) {
+                aMiddle = a + (aEnd - a) / 2;
+                bMiddle = lower_bound(b, bEnd, *aMiddle, compare);
+            } else {
+                bMiddle = b + (bEnd - b) / 2;
+                aMiddle = upper_bound(a, aEnd, *bMiddle, compare);
+            }
+            ValueType* outMiddle = out + (aMiddle - a) + (bMiddle - b);
+            pool.spawn(group, [&pool, &group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, &compare] {
+                mergeRuns(pool, group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, compare);
+            });
+            aEnd = aMiddle;
+            bEnd = bMiddle;
+        }
+        merge(make_move_iterator(a), make_move_iterator(aEnd), make_move_iterator(b), make_move_iterator(bEnd), out, compare);
+    }
+
+public:
+    // Get the vector instruction set the scans use: the widest the CPU
+    // supports, unless lowered with setSimdLevel
+    static SimdLevel simdLevel() {
+        return simdSetting();
+    }
+    
+    // Limit the scans to a level, e.g. SIMD_SCALAR to compare against the
+    // plain loops; levels above what the CPU supports are lowered to it.
+    // Not safe while other threads scan.
+    static void setSimdLevel(SimdLevel level) {
+        simdSetting() = std::min(level, detectSimdLevel());
+    }
+    
+    // Sum of the elements in SumType (0 when empty)
+    template <typename T = ValueType>
+    SumType sum() const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::SUM);
+        runScan(job);
+        return job.sum;
+    }
+    
+    // Get the smallest element
+    template <typename T = ValueType>
+    ValueType min() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.min;
+    }
+    
+    // Get the largest element
+    template <typename T = ValueType>
+    ValueType max() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX);
+        runScan(job);
+        return job.max;
+    }
+    
+    // Get the positions of the first smallest and the first largest element
+    template <typename T = ValueType>
+    pair<int, int> minMaxIndex() const {
+        if (isEmpty()) {
+            throw underflow_error("Array is empty");
+        }
+        
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::MIN_MAX_INDEX);
+        runScan(job);
+        return make_pair(job.minIndex, job.maxIndex);
+    }
+    
+    // Count the elements equal to value
+    template <typename T = ValueType>
+    int count(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::COUNT, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the position of the first element equal to value, or -1
+    template <typename T = ValueType>
+    int find(const ValueType& value) const {
+        ScanJob<T> job = scanJob<T>(ScanJob<T>::FIND, &value);
+        runScan(job);
+        return job.result;
+    }
+    
+    // Get the number of elements below which the parallel algorithms run
+    // sequentially, and the size of the pieces they split the array into
+    static int parallelGrain() {
+        return parallelGrainSetting();
+    }
+    
+    // Set the grain (at least 1). Not safe while other threads run parallel algorithms.
+    static void setParallelGrain(int elements) {
+        parallelGrainSetting() = std::max(elements, 1);
+    }
+    
+    // Sort the elements with compare (ascending by default): runs are sorted
+    // in parallel, then merged pairwise, each merge itself split across threads.
+    // Not stable.
+    template <typename Compare = less<ValueType>>
+    void parallelSort(Compare compare = Compare()) {
+        if (!runsInParallel(arraySize)) {
+            sort(data, data + arraySize, compare);
+            return;
+        }
+        
+        // A few runs per thread, so the threads stay busy and few merge passes remain
+        int grain = parallelGrain();
+        int threads = WorkPool::instance().workerCount() + 1;
+        int run = std::max(grain, (arraySize + threads * 4 - 1) / (threads * 4));
+        int runs = (arraySize + run - 1) / run;
+        parallelFor(0, runs, 1, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                sort(data + r * run, data + (r == runs - 1 ? arraySize : (r + 1) * run), compare);
+            }
+        });
+        
+        unique_ptr<ValueType[]> buffer(new ValueType[arraySize]);
+        ValueType* from = data;
+        ValueType* to = buffer.get();
+        for (int width = run; width < arraySize; width = width > arraySize / 2 ? arraySize : width * 2) {
+            int pairs = (int)(((long long)arraySize + 2LL * width - 1) / (2LL * width));
+            parallelFor(0, pairs, 1, [&](int first, int last) {
+                WorkPool& pool = WorkPool::instance();
+                TaskGroup group;
+                try {
+                    for (int p = first; p < last; p++) {
+                        int low = (int)std::min<long long>(arraySize, 2LL * width * p);
+                        int middle = (int)std::min<long long>(arraySize, (long long)low + width);
+                        int high = (int)std::min<long long>(arraySize, (long long)middle + width);
+                        mergeRuns(pool, group, from + low, from + middle, from + middle, from + high, to + low, grain, compare);
+                    }
+                } catch (...) {
+                    group.fail(current_exception());
+                }
+                pool.wait(group);
+            });
+            swap(from, to);
+        }
+        if (from != data) {
+            parallelFor(0, arraySize, grain, [&](int begin, int end) {
+                moveElements(data + begin, from + begin, end - begin);
+            });
+        }
+    }
+    
+    // Replace every element with f(element); f runs on several threads at once
+    template <typename F>
+    void parallelTransform(F f) {
+        auto transform = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                data[i] = f(data[i]);
+            }
+        };
+        if (runsInParallel(arraySize)) {
+            parallelFor(0, arraySize, parallelGrain(), transform);
+        } else {
+            transform(0, arraySize);
+        }
+    }
+    
+    // Fold the elements into init with op, which must be associative: each
+    // thread reduces whole grains, and their results are combined in order
+    template <typename Op>
+    ValueType parallelReduce(ValueType init, Op op) const {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 0; i < arraySize; i++) {
+                init = op(move(init), data[i]);
+            }
+            return init;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<ValueType[]> partials(new ValueType[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                ValueType partial = data[c * grain];
+                for (int i = c * grain + 1; i < end; i++) {
+                    partial = op(move(partial), data[i]);
+                }
+                partials[c] = move(partial);
+            }
+        });
+        for (int c = 0; c < chunks; c++) {
+            init = op(move(init), partials[c]);
+        }
+        return init;
+    }
+    
+    // Replace every element with the sum of itself and all elements before it.
+    // Each grain is summed in parallel, the grain totals are added up in order,
+    // and a second parallel pass adds each grain's offset.
+    template <typename T = ValueType>
+    void parallelPrefixSum() {
+        if (!runsInParallel(arraySize)) {
+            for (int i = 1; i < arraySize; i++) {
+                data[i] = data[i - 1] + data[i];
+            }
+            return;
+        }
+        
+        int grain = parallelGrain();
+        int chunks = (arraySize + grain - 1) / grain;
+        unique_ptr<T[]> totals(new T[chunks]);
+        parallelFor(0, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain + 1; i < end; i++) {
+                    data[i] = data[i - 1] + data[i];
+                }
+                totals[c] = data[end - 1];
+            }
+        });
+        for (int c = 1; c < chunks; c++) {
+            totals[c] = totals[c - 1] + totals[c];
+        }
+        parallelFor(1, chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; c++) {
+                int end = c == chunks - 1 ? arraySize : (c + 1) * grain;
+                for (int i = c * grain; i < end; i++) {
+                    data[i] = totals[c - 1] + data[i];
+                }
+            }
+        });
+    }
@@ -1,3 +1,5 @@
+#include <functional>
+
 /**
  * HashTable - A Hash Table implementation using separate chaining
  * Operations:
@@ -9,15 +11,20 @@
  * - isEmpty: Check if the hash table is empty
  */
 class HashTable {
+public:
+    // Key and value types (dslord: -hashtable:K=<type>,V=<type>)
+    typedef int KeyType;
+    typedef int ValueType;
+
 private:
     // Node structure for each key-value pair
     struct Node {
-        int key;
-        int value;
+        KeyType key;
+        ValueType value;
         Node* next;
         
         // Constructor
-        Node(int k, int v) : key(k), value(v), next(nullptr) {}
+        Node(const KeyType& k, const ValueType& v) : key(k), value(v), next(nullptr) {}
     };
     
     static const int INITIAL_CAPACITY = 16;
@@ -28,8 +35,8 @@ private:
     int count;
     
     // Hash function
-    int hash(int key) const {
-        return abs(key) % numBuckets;
+    int hash(const KeyType& key) const {
+        return (int)(std::hash<KeyType>()(key) % (size_t)numBuckets);
     }
     
     // Resize the hash table
@@ -49,7 +56,7 @@ private:
                 Node* next = current->next;
                 
                 // Compute new bucket index
-                int newIndex = abs(current->key) % newCapacity;
+                int newIndex = (int)(std::hash<KeyType>()(current->key) % (size_t)newCapacity);
                 
                 // Insert at beginning of new chain
                 current->next = newBuckets[newIndex];
@@ -91,7 +98,7 @@ public:
     }
     
     // Insert a key-value pair
-    void insert(int key, int value) {
+    void insert(const KeyType& key, const ValueType& value) {
         // Check if resize is needed
         if (count >= numBuckets * MAX_LOAD_FACTOR / 100) {
             resize(numBuckets * 2);
@@ -117,7 +124,7 @@ public:
     }
     
     // Remove a key
-    bool remove(int key) {
+    bool remove(const KeyType& key) {
         int index = hash(key);
         
         // Check if bucket is empty
@@ -153,7 +160,7 @@ public:
     }
     
     // Get a value by key
-    bool get(int key, int& value) const {
+    bool get(const KeyType& key, ValueType& value) const {
         int index = hash(key);
         
         // Search for key in chain
@@ -170,7 +177,7 @@ public:
     }
     
     // Check if a key exists
-    bool containsKey(int key) const {
+    bool containsKey(const KeyType& key) const {
         int index = hash(key);
         
         // Search for key in chain
@@ -1,3 +1,5 @@
+#include <climits>
+
 /**
  * MinHeap - A Min Heap implementation
  * Operations:
@@ -8,11 +10,35 @@
  * - isEmpty: Check if the heap is empty
  */
 class MinHeap {
+public:
+    // Element type (dslord: -heap:T=<type>)
+    typedef int ValueType;
+
 private:
+    // Capacity (dslord: -heap:capacity=<n>). When GROWABLE is set it is only the
+    // initial capacity and the storage doubles when full (dslord: -heap:growable)
     static const int MAX_SIZE = 1000;
-    int heap[MAX_SIZE];
+    static const bool GROWABLE = false;
+    
+    ValueType* heap;
+    int heapCapacity;
     int heapSize;
     
+    // Move the elements into storage twice as large; throws overflow_error
+    // when that many elements no longer fit in an int
+    void grow() {
+        if (heapCapacity > INT_MAX / 2) {
+            throw overflow_error("Heap Overflow");
+        }
+        ValueType* newHeap = new ValueType[heapCapacity * 2];
+        for (int i = 0; i < heapSize; i++) {
+            newHeap[i] = heap[i];
+        }
+        delete[] heap;
+        heap = newHeap;
+        heapCapacity *= 2;
+    }
+    
     // Get parent index
     int parent(int i) const {
         return (i - 1) / 2;
@@ -66,12 +92,39 @@ private:
 
 public:
     // Constructor
-    MinHeap() : heapSize(0) {}
+    MinHeap() : heap(new ValueType[MAX_SIZE]), heapCapacity(MAX_SIZE), heapSize(0) {}
+    
+    // Destructor
+    ~MinHeap() {
+        delete[] heap;
+    }
+    
+    // Copy constructor
+    MinHeap(const MinHeap& other)
+        : heap(new ValueType[other.heapCapacity]), heapCapacity(other.heapCapacity), heapSize(other.heapSize) {
+        for (int i = 0; i < heapSize; i++) {
+            heap[i] = other.heap[i];
+        }
+    }
+    
+    // Assignment operator
+    MinHeap& operator=(const MinHeap& other) {
+        if (this != &other) {
+            MinHeap copy(other);
+            swap(heap, copy.heap);
+            swap(heapCapacity, copy.heapCapacity);
+            swap(heapSize, copy.heapSize);
+        }
+        return *this;
+    }
     
     // Insert a value into the heap
-    void insert(int value) {
-        if (heapSize >= MAX_SIZE) {
-            throw overflow_error("Heap Overflow");
+    void insert(const ValueType& value) {
+        if (heapSize >= heapCapacity) {
+            if (!GROWABLE) {
+                throw overflow_error("Heap Overflow");
+            }
+            grow();
         }
         
         // Add the value at the end of the heap
@@ -85,13 +138,13 @@ public:
     }
     
     // Extract the minimum value from the heap
-    int extractMin() {
+    ValueType extractMin() {
         if (isEmpty()) {
             throw underflow_error("Heap Underflow");
         }
         
         // Store the minimum value
-        int minValue = heap[0];
+        ValueType minValue = heap[0];
         
         // Replace root with the last element
         heap[0] = heap[heapSize - 1];
@@ -106,7 +159,7 @@ public:
     }
     
     // Get the minimum value without removing it
-    int getMin() const {
+    ValueType getMin() const {
         if (isEmpty()) {
             throw underflow_error("Heap is empty");
         }
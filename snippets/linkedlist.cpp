@@ -9,14 +9,18 @@
  * - display: Display all nodes in the list
  */
 class LinkedList {
+public:
+    // Element type (dslord: -linkedlist:T=<type>)
+    typedef int ValueType;
+
 private:
     // Node structure for Linked List
     struct Node {
-        int data;
+        ValueType data;
         Node* next;
         
         // Constructor
-        Node(int value) : data(value), next(nullptr) {}
+        Node(const ValueType& value) : data(value), next(nullptr) {}
     };
     
     Node* head;
@@ -38,7 +42,7 @@ public:
     }
     
     // Insert a node at the beginning of the list
-    void insertAtBeginning(int value) {
+    void insertAtBeginning(const ValueType& value) {
         Node* newNode = new Node(value);
         newNode->next = head;
         head = newNode;
@@ -46,7 +50,7 @@ public:
     }
     
     // Insert a node at the end of the list
-    void insertAtEnd(int value) {
+    void insertAtEnd(const ValueType& value) {
         Node* newNode = new Node(value);
         
         // If list is empty, make the new node the head
@@ -68,7 +72,7 @@ public:
     }
     
     // Insert a node at a specific position (0-based indexing)
-    void insertAt(int position, int value) {
+    void insertAt(int position, const ValueType& value) {
         // Check if position is valid
         if (position < 0 || position > nodeCount) {
             throw out_of_range("Invalid position");
@@ -96,7 +100,7 @@ public:
     }
     
     // Delete a node with a specific value
-    bool deleteNode(int value) {
+    bool deleteNode(const ValueType& value) {
         // Check if list is empty
         if (head == nullptr) {
             return false;
@@ -130,7 +134,7 @@ public:
     }
     
     // Search for a node with a specific value
-    bool search(int value) const {
+    bool search(const ValueType& value) const {
         Node* current = head;
         while (current != nullptr) {
             if (current->data == value) {
@@ -1,4 +1,7 @@
+#include <climits>
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 using namespace std;
 
 /**
@@ -6,49 +9,146 @@ using namespace std;
  * Operations:
  * - enqueue: Add an element to the end of the queue
  * - dequeue: Remove the first element from the queue
+ * - enqueueBulk: Add a block of elements to the end of the queue
+ * - dequeueBulk: Remove a block of elements from the front of the queue
  * - front: Get the first element without removing it
  * - isEmpty: Check if the queue is empty
  * - size: Get the number of elements in the queue
  */
 class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+
 private:
-    static const int MAX_SIZE = 1000;
-    int data[MAX_SIZE];
+    // Capacity, a power of two so indices wrap with a mask (dslord: -queue:capacity=<n>).
+    // When GROWABLE is set it is only the initial capacity and the storage doubles
+    // when full (dslord: -queue:growable)
+    static const int MAX_SIZE = 1024;
+    static const bool GROWABLE = false;
+
+    ValueType* data;
+    int capacityMask;
     int frontIdx;
-    int rearIdx;
     int count;
 
+    // Move the elements into storage twice as large, unwrapping them to index 0;
+    // throws overflow_error when that many elements no longer fit in an int
+    void grow() {
+        int capacity = capacityMask + 1;
+        if (capacity > INT_MAX / 2) {
+            throw overflow_error("Queue Overflow");
+        }
+        ValueType* newData = new ValueType[capacity * 2];
+        for (int i = 0; i < count; i++) {
+            newData[i] = data[(frontIdx + i) & capacityMask];
+        }
+        delete[] data;
+        data = newData;
+        capacityMask = capacity * 2 - 1;
+        frontIdx = 0;
+    }
+
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+
 public:
     // Constructor
-    Queue() {
+    Queue() : data(new ValueType[MAX_SIZE]), capacityMask(MAX_SIZE - 1) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
         frontIdx = 0;
-        rearIdx = -1;
         count = 0;
     }
 
+    // Destructor
+    ~Queue() {
+        delete[] data;
+    }
+
+    // Copy constructor
+    Queue(const Queue& other) : data(new ValueType[other.capacityMask + 1]), capacityMask(other.capacityMask) {
+        frontIdx = 0;
+        count = other.count;
+        for (int i = 0; i < count; i++) {
+            data[i] = other.data[(other.frontIdx + i) & other.capacityMask];
+        }
+    }
+
+    // Assignment operator
+    Queue& operator=(const Queue& other) {
+        if (this != &other) {
+            Queue copy(other);
+            swap(data, copy.data);
+            swap(capacityMask, copy.capacityMask);
+            swap(frontIdx, copy.frontIdx);
+            swap(count, copy.count);
+        }
+        return *this;
+    }
+
     // Add an element to the end of the queue
-    void enqueue(int value) {
-        if (count >= MAX_SIZE) {
-            throw overflow_error("Queue Overflow");
+    void enqueue(const ValueType& value) {
+        if (count > capacityMask) {
+            if (!GROWABLE) {
+                throw overflow_error("Queue Overflow");
+            }
+            grow();
         }
-        rearIdx = (rearIdx + 1) % MAX_SIZE;
-        data[rearIdx] = value;
+        data[(frontIdx + count) & capacityMask] = value;
         count++;
     }
 
     // Remove and return the first element from the queue
-    int dequeue() {
+    ValueType dequeue() {
         if (isEmpty()) {
             throw underflow_error("Queue Underflow");
         }
-        int value = data[frontIdx];
-        frontIdx = (frontIdx + 1) % MAX_SIZE;
+        ValueType value = data[frontIdx];
+        frontIdx = (frontIdx + 1) & capacityMask;
         count--;
         return value;
     }
 
+    // Add up to n elements from `values` to the end of the queue, with at most
+    // two block copies; returns how many fit (all of them when growable)
+    int enqueueBulk(const ValueType* values, int n) {
+        while (GROWABLE && n > capacityMask + 1 - count) {
+            grow();
+        }
+        n = max(0, min(n, capacityMask + 1 - count));
+        int rear = (frontIdx + count) & capacityMask;
+        int first = min(n, capacityMask + 1 - rear);
+        copyElements(data + rear, values, first);
+        copyElements(data, values + first, n - first);
+        count += n;
+        return n;
+    }
+
+    // Remove up to n elements from the front of the queue into `values`, with at
+    // most two block copies; returns how many were removed
+    int dequeueBulk(ValueType* values, int n) {
+        n = max(0, min(n, count));
+        int first = min(n, capacityMask + 1 - frontIdx);
+        copyElements(values, data + frontIdx, first);
+        copyElements(values + first, data, n - first);
+        frontIdx = (frontIdx + n) & capacityMask;
+        count -= n;
+        return n;
+    }
+
     // Get the first element without removing it
-    int front() const {
+    ValueType front() const {
         if (isEmpty()) {
             throw underflow_error("Queue is empty");
         }
@@ -76,7 +176,7 @@ public:
         int index = frontIdx;
         for (int i = 0; i < count; i++) {
             cout << data[index] << " ";
-            index = (index + 1) % MAX_SIZE;
+            index = (index + 1) & capacityMask;
         }
         cout << endl;
     }
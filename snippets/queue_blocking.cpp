@@ -0,0 +1,351 @@
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+using namespace std;
+
+/**
+ * Queue - A blocking First-In-First-Out (FIFO) queue for producer and consumer
+ * threads (dslord: -queue:blocking). Consumers wait for elements instead of
+ * getting underflow_error, and producers wait for room when the queue is full.
+ *
+ * A waiting thread first spins briefly on a lock-free element count and only
+ * parks on a condition variable when nothing arrives, and producers only
+ * notify when a consumer is actually parked (once per batch for bulk calls),
+ * so a busy queue does not make a futex call per element.
+ * Operations:
+ * - enqueue: Add an element, waiting while the queue is full
+ * - tryEnqueue: Add an element if there is room
+ * - enqueueBulk: Add as many elements of a block as there is room for
+ * - dequeue: Remove the first element, waiting until there is one
+ * - tryDequeue: Remove the first element if there is one
+ * - dequeueFor: Remove the first element, waiting at most a timeout
+ * - dequeueUpTo: Remove up to n elements, waiting at most a timeout for the first
+ * - close: Refuse new elements and wake every waiting thread
+ * - front: Get the first element without removing it
+ * - isEmpty, isClosed, size: Query the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Capacity, a power of two so indices wrap with a mask (dslord: -queue:blocking,capacity=<n>).
+    // When GROWABLE is set it is only the initial capacity, the storage doubles
+    // when full and producers never wait (dslord: -queue:blocking,growable)
+    static const int MAX_SIZE = 1024;
+    static const bool GROWABLE = false;
+
+    // Polls of the element count before a waiting thread parks
+    static const int SPIN_LIMIT = 256;
+
+    typedef chrono::steady_clock Clock;
+
+    mutable mutex lock;
+    condition_variable notEmpty;
+    condition_variable notFull;
+    ValueType* data;
+    int capacityMask;
+    int frontIdx;
+    atomic<int> count;  // written under the lock, read without it while spinning
+    atomic<bool> closed;
+    int waitingConsumers;
+    int waitingProducers;
+
+    // Move the elements into storage twice as large, unwrapping them to index 0;
+    // throws overflow_error when that many elements no longer fit in an int
+    void grow() {
+        int capacity = capacityMask + 1;
+        if (capacity > INT_MAX / 2) {
+            throw overflow_error("Queue Overflow");
+        }
+        ValueType* newData = new ValueType[capacity * 2];
+        int first = min((int)count, capacity - frontIdx);
+        copyElements(newData, data + frontIdx, first);
+        copyElements(newData + first, data, count - first);
+        delete[] data;
+        data = newData;
+        capacityMask = capacity * 2 - 1;
+        frontIdx = 0;
+    }
+
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, int n) {
+        if (n <= 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (int i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+
+    // Poll the lock-free state until `ready` holds or the spin budget is spent,
+    // yielding the core for the second half
+    void spinFor(bool (Queue::*ready)() const) const {
+        for (int i = 0; i < SPIN_LIMIT && !(this->*ready)(); i++) {
+            if (i >= SPIN_LIMIT / 2) {
+                this_thread::yield();
+            }
+        }
+    }
+
+    bool hasElementsOrClosed() const {
+        return count.load(memory_order_acquire) > 0 || closed.load(memory_order_acquire);
+    }
+
+    bool hasRoomOrClosed() const {
+        return GROWABLE || count.load(memory_order_acquire) <= capacityMask || closed.load(memory_order_acquire);
+    }
+
+    // Wait (spin, then park) until there is an element or the queue is closed,
+    // giving up at `deadline` when one is given; returns with the lock held
+    bool waitForElements(unique_lock<mutex>& guard, const Clock::time_point* deadline) {
+        if (count == 0 && !closed) {
+            guard.unlock();
+            spinFor(&Queue::hasElementsOrClosed);
+            guard.lock();
+        }
+        while (count == 0 && !closed) {
+            bool timedOut = false;
+            waitingConsumers++;
+            if (deadline) {
+                timedOut = notEmpty.wait_until(guard, *deadline) == cv_status::timeout;
+            } else {
+                notEmpty.wait(guard);
+            }
+            waitingConsumers--;
+            if (timedOut) {
+                break;
+            }
+        }
+        return count > 0;
+    }
+
+    // Wait (spin, then park) until there is room or the queue is closed
+    void waitForRoom(unique_lock<mutex>& guard) {
+        if (!GROWABLE && count > capacityMask && !closed) {
+            guard.unlock();
+            spinFor(&Queue::hasRoomOrClosed);
+            guard.lock();
+        }
+        while (!GROWABLE && count > capacityMask && !closed) {
+            waitingProducers++;
+            notFull.wait(guard);
+            waitingProducers--;
+        }
+    }
+
+    // Append under the lock; the caller has made room
+    void push(const ValueType& value) {
+        if (count > capacityMask) {
+            grow();
+        }
+        data[(frontIdx + count) & capacityMask] = value;
+        count.fetch_add(1, memory_order_release);
+    }
+
+    // Remove up to n elements under the lock with at most two block copies
+    int take(ValueType* values, int n) {
+        n = max(0, min(n, (int)count));
+        int first = min(n, capacityMask + 1 - frontIdx);
+        copyElements(values, data + frontIdx, first);
+        copyElements(values + first, data, n - first);
+        frontIdx = (frontIdx + n) & capacityMask;
+        count.fetch_sub(n, memory_order_release);
+        return n;
+    }
+
+    // Wake consumers after adding elements; called without the lock
+    void wakeConsumers(bool wake, int added) {
+        if (wake) {
+            if (added > 1) {
+                notEmpty.notify_all();
+            } else {
+                notEmpty.notify_one();
+            }
+        }
+    }
+
+    // Remove up to n elements once the lock is held and waiting is done
+    int takeAndWake(unique_lock<mutex>& guard, ValueType* values, int n) {
+        n = take(values, n);
+        bool wake = waitingProducers > 0 && n > 0;
+        guard.unlock();
+        if (wake) {
+            if (n > 1) {
+                notFull.notify_all();
+            } else {
+                notFull.notify_one();
+            }
+        }
+        return n;
+    }
+
+public:
+    // Constructor
+    Queue() : data(new ValueType[MAX_SIZE]), capacityMask(MAX_SIZE - 1), frontIdx(0), count(0),
+              closed(false), waitingConsumers(0), waitingProducers(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+    }
+
+    // Destructor (no thread may still be waiting on the queue)
+    ~Queue() {
+        delete[] data;
+    }
+
+    // Threads share one queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    // Add an element to the end of the queue, waiting while it is full;
+    // throws logic_error once the queue is closed
+    void enqueue(const ValueType& value) {
+        unique_lock<mutex> guard(lock);
+        waitForRoom(guard);
+        if (closed) {
+            throw logic_error("Queue Closed");
+        }
+        push(value);
+        bool wake = waitingConsumers > 0;
+        guard.unlock();
+        wakeConsumers(wake, 1);
+    }
+
+    // Add an element if there is room; false when full or closed
+    bool tryEnqueue(const ValueType& value) {
+        unique_lock<mutex> guard(lock);
+        if (closed || (!GROWABLE && count > capacityMask)) {
+            return false;
+        }
+        push(value);
+        bool wake = waitingConsumers > 0;
+        guard.unlock();
+        wakeConsumers(wake, 1);
+        return true;
+    }
+
+    // Add up to n elements from `values` without waiting, with one wakeup for
+    // the whole batch; returns how many were added (0 once closed)
+    int enqueueBulk(const ValueType* values, int n) {
+        unique_lock<mutex> guard(lock);
+        if (closed) {
+            return 0;
+        }
+        while (GROWABLE && n > capacityMask + 1 - count) {
+            grow();
+        }
+        n = max(0, min(n, capacityMask + 1 - (int)count));
+        int rear = (frontIdx + count) & capacityMask;
+        int first = min(n, capacityMask + 1 - rear);
+        copyElements(data + rear, values, first);
+        copyElements(data, values + first, n - first);
+        count.fetch_add(n, memory_order_release);
+        bool wake = waitingConsumers > 0 && n > 0;
+        guard.unlock();
+        wakeConsumers(wake, n);
+        return n;
+    }
+
+    // Remove and return the first element, waiting until there is one;
+    // throws underflow_error once the queue is closed and empty
+    ValueType dequeue() {
+        unique_lock<mutex> guard(lock);
+        if (!waitForElements(guard, nullptr)) {
+            throw underflow_error("Queue Closed");
+        }
+        ValueType value;
+        takeAndWake(guard, &value, 1);
+        return value;
+    }
+
+    // Remove the first element into `value` if there is one, without waiting
+    bool tryDequeue(ValueType& value) {
+        unique_lock<mutex> guard(lock);
+        return takeAndWake(guard, &value, 1) == 1;
+    }
+
+    // Remove the first element into `value`, waiting at most `timeout`;
+    // false on timeout or when the queue is closed and empty
+    template <typename Rep, typename Period>
+    bool dequeueFor(ValueType& value, const chrono::duration<Rep, Period>& timeout) {
+        Clock::time_point deadline = Clock::now() + chrono::duration_cast<Clock::duration>(timeout);
+        unique_lock<mutex> guard(lock);
+        if (!waitForElements(guard, &deadline)) {
+            return false;
+        }
+        return takeAndWake(guard, &value, 1) == 1;
+    }
+
+    // Remove up to n elements into `values`, waiting at most `timeout` for the
+    // first one; returns how many were removed (0 on timeout, or when the
+    // queue is closed and empty)
+    template <typename Rep, typename Period>
+    int dequeueUpTo(ValueType* values, int n, const chrono::duration<Rep, Period>& timeout) {
+        Clock::time_point deadline = Clock::now() + chrono::duration_cast<Clock::duration>(timeout);
+        unique_lock<mutex> guard(lock);
+        if (!waitForElements(guard, &deadline)) {
+            return 0;
+        }
+        return takeAndWake(guard, values, n);
+    }
+
+    // Refuse new elements and wake every waiting thread; consumers still drain
+    // what is left
+    void close() {
+        {
+            lock_guard<mutex> guard(lock);
+            closed = true;
+        }
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    // Check if close() was called
+    bool isClosed() const {
+        return closed.load(memory_order_acquire);
+    }
+
+    // Get the first element without removing it
+    ValueType front() const {
+        lock_guard<mutex> guard(lock);
+        if (count == 0) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return count.load(memory_order_acquire) == 0;
+    }
+
+    // Get the number of elements in the queue
+    int size() const {
+        return count.load(memory_order_acquire);
+    }
+
+    // Display all elements in the queue (for debugging)
+    void display() const {
+        lock_guard<mutex> guard(lock);
+        if (count == 0) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+
+        cout << "Queue elements: ";
+        for (int i = 0; i < count; i++) {
+            cout << data[(frontIdx + i) & capacityMask] << " ";
+        }
+        cout << endl;
+    }
+};
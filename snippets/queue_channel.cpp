@@ -0,0 +1,352 @@
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <utility>
+using namespace std;
+
+/**
+ * Queue - A First-In-First-Out (FIFO) channel between C++20 coroutines
+ * (dslord: -queue:channel). `co_await queue.pop()` suspends a coroutine while
+ * the queue is empty and `co_await queue.push(value)` while it is full; a
+ * single-threaded Queue::Scheduler resumes them once they can go on, so any
+ * number of producers and consumers share one thread.
+ *
+ * Elements live in the same power-of-two ring buffer as the plain Queue. A
+ * value pushed while consumers wait is handed straight to the first of them,
+ * and popping from a full queue moves the first waiting producer's value in,
+ * so waiters are served in the order they arrived. Needs -std=c++20.
+ * Operations:
+ * - push: Awaitable enqueue, suspends while the queue is full
+ * - pop: Awaitable dequeue, suspends while the queue is empty
+ * - enqueue: Add an element to the end of the queue (throws when full)
+ * - dequeue: Remove the first element from the queue (throws when empty)
+ * - tryEnqueue, tryDequeue: Non-throwing enqueue and dequeue
+ * - front: Get the first element without removing it
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Capacity, a power of two so indices wrap with a mask (dslord: -queue:channel,capacity=<n>)
+    static const int MAX_SIZE = 1024;
+
+    // Links a spawned coroutine into its scheduler's list of live tasks
+    struct TaskLink {
+        TaskLink* prev = nullptr;
+        TaskLink* next = nullptr;
+    };
+
+public:
+    class Scheduler;
+
+    // Return type of producer and consumer coroutines. A Task starts suspended
+    // and runs once it is passed to Scheduler::spawn(); its frame frees itself
+    // when the coroutine returns.
+    class Task {
+    public:
+        struct promise_type : TaskLink {
+            exception_ptr* failure = nullptr;  // where the scheduler collects exceptions
+
+            Task get_return_object() {
+                return Task(coroutine_handle<promise_type>::from_promise(*this));
+            }
+            suspend_always initial_suspend() noexcept {
+                return {};
+            }
+            suspend_never final_suspend() noexcept {
+                return {};
+            }
+            void return_void() {}
+            void unhandled_exception() {
+                *failure = current_exception();
+            }
+            ~promise_type() {
+                if (prev) {
+                    prev->next = next;
+                    next->prev = prev;
+                }
+            }
+        };
+
+        Task(Task&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        // A Task that was never spawned destroys its coroutine
+        ~Task() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+    private:
+        friend class Scheduler;
+        explicit Task(coroutine_handle<promise_type> handle) : handle(handle) {}
+        coroutine_handle<promise_type> handle;
+    };
+
+    // Runs coroutines on the calling thread: spawned tasks and waiters a queue
+    // has released are resumed in FIFO order
+    class Scheduler {
+    public:
+        Scheduler() {
+            live.prev = live.next = &live;
+        }
+
+        // Destroys the coroutines that have not finished; queues they were
+        // waiting on must not be used afterwards
+        ~Scheduler() {
+            ready.clear();
+            while (live.next != &live) {
+                coroutine_handle<Task::promise_type>::from_promise(static_cast<Task::promise_type&>(*live.next)).destroy();
+            }
+        }
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // The scheduler used by queues constructed without one (one per thread)
+        static Scheduler& local() {
+            static thread_local Scheduler scheduler;
+            return scheduler;
+        }
+
+        // Take ownership of a coroutine and queue it to start on the next run()
+        void spawn(Task task) {
+            Task::promise_type& promise = task.handle.promise();
+            promise.failure = &failure;
+            promise.prev = live.prev;
+            promise.next = &live;
+            live.prev->next = &promise;
+            live.prev = &promise;
+            ready.push_back(exchange(task.handle, nullptr));
+        }
+
+        // Queue a suspended coroutine to be resumed
+        void schedule(coroutine_handle<> handle) {
+            ready.push_back(handle);
+        }
+
+        // Resume coroutines until every one has finished or waits on a queue.
+        // An exception escaping a coroutine ends that coroutine and is rethrown here.
+        void run() {
+            while (!ready.empty()) {
+                coroutine_handle<> next = ready.front();
+                ready.pop_front();
+                next.resume();
+                if (failure) {
+                    rethrow_exception(exchange(failure, nullptr));
+                }
+            }
+        }
+
+        // Get the number of spawned coroutines that have not finished
+        size_t liveTasks() const {
+            size_t count = 0;
+            for (const TaskLink* link = live.next; link != &live; link = link->next) {
+                count++;
+            }
+            return count;
+        }
+
+    private:
+        TaskLink live;  // sentinel of the circular list of unfinished tasks
+        deque<coroutine_handle<>> ready;
+        exception_ptr failure;
+    };
+
+    // Awaiter returned by pop(); a suspended consumer waits in the queue's
+    // list until a producer hands it a value
+    class PopAwaiter {
+    public:
+        bool await_ready() {
+            return queue.tryDequeue(value);
+        }
+        void await_suspend(coroutine_handle<> handle) {
+            waiter = handle;
+            queue.addWaiter(queue.consumers, this);
+        }
+        ValueType await_resume() {
+            return value;
+        }
+
+    private:
+        friend class Queue;
+        explicit PopAwaiter(Queue& queue) : queue(queue) {}
+        Queue& queue;
+        ValueType value;
+        coroutine_handle<> waiter;
+        PopAwaiter* next = nullptr;
+    };
+
+    // Awaiter returned by push(); a suspended producer keeps its value until
+    // a consumer makes room for it
+    class PushAwaiter {
+    public:
+        bool await_ready() {
+            return queue.tryEnqueue(value);
+        }
+        void await_suspend(coroutine_handle<> handle) {
+            waiter = handle;
+            queue.addWaiter(queue.producers, this);
+        }
+        void await_resume() {}
+
+    private:
+        friend class Queue;
+        PushAwaiter(Queue& queue, const ValueType& value) : queue(queue), value(value) {}
+        Queue& queue;
+        ValueType value;
+        coroutine_handle<> waiter;
+        PushAwaiter* next = nullptr;
+    };
+
+private:
+    // FIFO of suspended awaiters, linked through their `next`
+    template <typename Awaiter>
+    struct WaitList {
+        Awaiter* head = nullptr;
+        Awaiter* tail = nullptr;
+    };
+
+    Scheduler& scheduler;
+    ValueType* data;
+    int frontIdx;
+    int count;
+    WaitList<PopAwaiter> consumers;   // only non-empty while the queue is empty
+    WaitList<PushAwaiter> producers;  // only non-empty while the queue is full
+
+    template <typename Awaiter>
+    static void addWaiter(WaitList<Awaiter>& list, Awaiter* awaiter) {
+        if (list.tail) {
+            list.tail->next = awaiter;
+        } else {
+            list.head = awaiter;
+        }
+        list.tail = awaiter;
+    }
+
+    template <typename Awaiter>
+    static Awaiter* takeWaiter(WaitList<Awaiter>& list) {
+        Awaiter* awaiter = list.head;
+        list.head = awaiter->next;
+        if (!list.head) {
+            list.tail = nullptr;
+        }
+        return awaiter;
+    }
+
+public:
+    // Constructor; the queue resumes waiters on `scheduler`
+    explicit Queue(Scheduler& scheduler) : scheduler(scheduler), data(new ValueType[MAX_SIZE]), frontIdx(0), count(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+    }
+
+    // Constructor using this thread's Scheduler::local()
+    Queue() : Queue(Scheduler::local()) {}
+
+    // Destructor (coroutines still waiting on the queue are left suspended)
+    ~Queue() {
+        delete[] data;
+    }
+
+    // Waiting coroutines point at the queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    // co_await push(value): add an element, suspending while the queue is full
+    PushAwaiter push(const ValueType& value) {
+        return PushAwaiter(*this, value);
+    }
+
+    // co_await pop(): remove the first element, suspending while the queue is empty
+    PopAwaiter pop() {
+        return PopAwaiter(*this);
+    }
+
+    // Add an element to the end of the queue; false when it is full
+    bool tryEnqueue(const ValueType& value) {
+        if (consumers.head) {
+            PopAwaiter* consumer = takeWaiter(consumers);
+            consumer->value = value;
+            scheduler.schedule(consumer->waiter);
+            return true;
+        }
+        if (count == MAX_SIZE) {
+            return false;
+        }
+        data[(frontIdx + count) & (MAX_SIZE - 1)] = value;
+        count++;
+        return true;
+    }
+
+    // Remove the first element into `value`; false when the queue is empty
+    bool tryDequeue(ValueType& value) {
+        if (count == 0) {
+            return false;
+        }
+        value = data[frontIdx];
+        frontIdx = (frontIdx + 1) & (MAX_SIZE - 1);
+        count--;
+        if (producers.head) {
+            PushAwaiter* producer = takeWaiter(producers);
+            data[(frontIdx + count) & (MAX_SIZE - 1)] = producer->value;
+            count++;
+            scheduler.schedule(producer->waiter);
+        }
+        return true;
+    }
+
+    // Add an element to the end of the queue
+    void enqueue(const ValueType& value) {
+        if (!tryEnqueue(value)) {
+            throw overflow_error("Queue Overflow");
+        }
+    }
+
+    // Remove and return the first element from the queue
+    ValueType dequeue() {
+        ValueType value;
+        if (!tryDequeue(value)) {
+            throw underflow_error("Queue Underflow");
+        }
+        return value;
+    }
+
+    // Get the first element without removing it
+    ValueType front() const {
+        if (isEmpty()) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // Get the number of elements in the queue
+    int size() const {
+        return count;
+    }
+
+    // Display all elements in the queue (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+
+        cout << "Queue elements: ";
+        for (int i = 0; i < count; i++) {
+            cout << data[(frontIdx + i) & (MAX_SIZE - 1)] << " ";
+        }
+        cout << endl;
+    }
+};
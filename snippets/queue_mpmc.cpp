@@ -0,0 +1,157 @@
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+using namespace std;
+
+/**
+ * Queue - A bounded lock-free First-In-First-Out (FIFO) queue for any number of
+ * producer and consumer threads (dslord: -queue:mpmc).
+ *
+ * Each slot carries a sequence number that says whether it is ready to be
+ * written for a given lap or read (Vyukov's bounded MPMC queue). Producers and
+ * consumers each claim a position with one compare-and-swap on their own
+ * counter, and the two counters sit on separate cache lines, so there is no
+ * global lock and no shared element count.
+ * Operations:
+ * - enqueue: Add an element to the end of the queue (throws when full)
+ * - tryEnqueue: Add an element if there is room
+ * - dequeue: Remove the first element from the queue (throws when empty)
+ * - tryDequeue: Remove the first element if there is one
+ * - front: Get the first element without removing it
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Capacity, a power of two so positions wrap with a mask (dslord: -queue:mpmc,capacity=<n>)
+    static const int MAX_SIZE = 1024;
+    static const size_t MASK = MAX_SIZE - 1;
+    static const size_t CACHE_LINE = 64;
+
+    // A slot is writable for position p when sequence == p, and readable when
+    // sequence == p + 1; a read hands it on to the next lap (p + MAX_SIZE)
+    struct Cell {
+        atomic<size_t> sequence;
+        ValueType value;
+    };
+
+    Cell* const cells;
+    alignas(CACHE_LINE) atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) atomic<size_t> dequeuePos;
+
+public:
+    // Constructor
+    Queue() : cells(new Cell[MAX_SIZE]), enqueuePos(0), dequeuePos(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+        static_assert(MAX_SIZE >= 2, "Queue:mpmc needs at least two slots for its sequence numbers");
+        for (size_t i = 0; i < (size_t)MAX_SIZE; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    // Destructor
+    ~Queue() {
+        delete[] cells;
+    }
+
+    // Threads share one queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    // Add an element to the end of the queue; false when it is full
+    bool tryEnqueue(const ValueType& value) {
+        size_t position = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & MASK];
+            ptrdiff_t lap = (ptrdiff_t)(cell.sequence.load(memory_order_acquire) - position);
+            if (lap == 0) {
+                if (enqueuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;  // the slot still holds last lap's element
+            } else {
+                position = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Add an element to the end of the queue
+    void enqueue(const ValueType& value) {
+        if (!tryEnqueue(value)) {
+            throw overflow_error("Queue Overflow");
+        }
+    }
+
+    // Remove the first element into `value`; false when it is empty
+    bool tryDequeue(ValueType& value) {
+        size_t position = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & MASK];
+            ptrdiff_t lap = (ptrdiff_t)(cell.sequence.load(memory_order_acquire) - (position + 1));
+            if (lap == 0) {
+                if (dequeuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + MASK + 1, memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;  // nothing written here yet
+            } else {
+                position = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Remove and return the first element from the queue
+    ValueType dequeue() {
+        ValueType value;
+        if (!tryDequeue(value)) {
+            throw underflow_error("Queue Underflow");
+        }
+        return value;
+    }
+
+    // Get the first element without removing it (only stable while no other thread dequeues)
+    ValueType front() const {
+        size_t position = dequeuePos.load(memory_order_relaxed);
+        const Cell& cell = cells[position & MASK];
+        if (cell.sequence.load(memory_order_acquire) != position + 1) {
+            throw underflow_error("Queue is empty");
+        }
+        return cell.value;
+    }
+
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    // Get the number of elements in the queue (a snapshot under concurrent use)
+    int size() const {
+        size_t first = dequeuePos.load(memory_order_acquire);
+        ptrdiff_t count = (ptrdiff_t)(enqueuePos.load(memory_order_acquire) - first);
+        return (int)max((ptrdiff_t)0, min(count, (ptrdiff_t)MAX_SIZE));
+    }
+
+    // Display all elements in the queue (for debugging, while no thread is using it)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+
+        cout << "Queue elements: ";
+        size_t last = enqueuePos.load(memory_order_acquire);
+        for (size_t position = dequeuePos.load(memory_order_acquire); position != last; position++) {
+            cout << cells[position & MASK].value << " ";
+        }
+        cout << endl;
+    }
+};
@@ -0,0 +1,189 @@
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+using namespace std;
+
+/**
+ * Queue - A lock-free First-In-First-Out (FIFO) ring buffer for exactly one
+ * producer thread and one consumer thread (dslord: -queue:spsc).
+ *
+ * The capacity is a power of two, so positions are free-running counters that
+ * wrap into the buffer with a mask instead of a division. The producer owns
+ * `tail` and the consumer owns `head`; they sit on separate cache lines, and
+ * each side keeps a cached copy of the other's counter so it only reads the
+ * other core's cache line when the queue looks full (or empty).
+ * Operations:
+ * - enqueue: Add an element to the end of the queue (producer; throws when full)
+ * - tryEnqueue: Add an element if there is room (producer)
+ * - dequeue: Remove the first element from the queue (consumer; throws when empty)
+ * - tryDequeue: Remove the first element if there is one (consumer)
+ * - enqueueBulk, dequeueBulk: Move a block of elements with one index update
+ * - front: Get the first element without removing it (consumer)
+ * - isEmpty: Check if the queue is empty
+ * - size: Get the number of elements in the queue
+ */
+class Queue {
+public:
+    // Element type (dslord: -queue:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Capacity, a power of two so positions wrap with a mask (dslord: -queue:spsc,capacity=<n>)
+    static const int MAX_SIZE = 1024;
+    static const size_t MASK = MAX_SIZE - 1;
+    static const size_t CACHE_LINE = 64;
+
+    ValueType* const data;
+
+    // Consumer side
+    alignas(CACHE_LINE) atomic<size_t> head;
+    size_t cachedTail;
+
+    // Producer side
+    alignas(CACHE_LINE) atomic<size_t> tail;
+    size_t cachedHead;  // the class is padded to a whole line, so nothing follows on this one
+
+    // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+    static void copyElements(ValueType* to, const ValueType* from, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        if (is_trivially_copyable<ValueType>::value) {
+            memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(ValueType));
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                to[i] = from[i];
+            }
+        }
+    }
+
+public:
+    // Constructor
+    Queue() : data(new ValueType[MAX_SIZE]), head(0), cachedTail(0), tail(0), cachedHead(0) {
+        static_assert(MAX_SIZE > 0 && (MAX_SIZE & (MAX_SIZE - 1)) == 0, "Queue capacity must be a power of two");
+    }
+
+    // Destructor
+    ~Queue() {
+        delete[] data;
+    }
+
+    // The two threads share one queue, so it cannot be copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    // Add an element to the end of the queue; false when it is full (producer only)
+    bool tryEnqueue(const ValueType& value) {
+        size_t position = tail.load(memory_order_relaxed);
+        if (position - cachedHead == (size_t)MAX_SIZE) {
+            cachedHead = head.load(memory_order_acquire);
+            if (position - cachedHead == (size_t)MAX_SIZE) {
+                return false;
+            }
+        }
+        data[position & MASK] = value;
+        tail.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    // Add an element to the end of the queue (producer only)
+    void enqueue(const ValueType& value) {
+        if (!tryEnqueue(value)) {
+            throw overflow_error("Queue Overflow");
+        }
+    }
+
+    // Remove the first element into `value`; false when it is empty (consumer only)
+    bool tryDequeue(ValueType& value) {
+        size_t position = head.load(memory_order_relaxed);
+        if (position == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire);
+            if (position == cachedTail) {
+                return false;
+            }
+        }
+        value = data[position & MASK];
+        head.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    // Add up to n elements from `values` with at most two block copies and a
+    // single publish; returns how many fit (producer only)
+    int enqueueBulk(const ValueType* values, int n) {
+        size_t position = tail.load(memory_order_relaxed);
+        size_t wanted = (size_t)max(n, 0);
+        if ((size_t)MAX_SIZE - (position - cachedHead) < wanted) {
+            cachedHead = head.load(memory_order_acquire);
+        }
+        size_t count = min(wanted, (size_t)MAX_SIZE - (position - cachedHead));
+        size_t start = position & MASK;
+        size_t first = min(count, (size_t)MAX_SIZE - start);
+        copyElements(data + start, values, first);
+        copyElements(data, values + first, count - first);
+        tail.store(position + count, memory_order_release);
+        return (int)count;
+    }
+
+    // Remove up to n elements into `values` with at most two block copies and a
+    // single release of the slots; returns how many were removed (consumer only)
+    int dequeueBulk(ValueType* values, int n) {
+        size_t position = head.load(memory_order_relaxed);
+        size_t wanted = (size_t)max(n, 0);
+        if (cachedTail - position < wanted) {
+            cachedTail = tail.load(memory_order_acquire);
+        }
+        size_t count = min(wanted, cachedTail - position);
+        size_t start = position & MASK;
+        size_t first = min(count, (size_t)MAX_SIZE - start);
+        copyElements(values, data + start, first);
+        copyElements(values + first, data, count - first);
+        head.store(position + count, memory_order_release);
+        return (int)count;
+    }
+
+    // Remove and return the first element from the queue (consumer only)
+    ValueType dequeue() {
+        ValueType value;
+        if (!tryDequeue(value)) {
+            throw underflow_error("Queue Underflow");
+        }
+        return value;
+    }
+
+    // Get the first element without removing it (consumer only)
+    ValueType front() {
+        size_t position = head.load(memory_order_relaxed);
+        if (position == tail.load(memory_order_acquire)) {
+            throw underflow_error("Queue is empty");
+        }
+        return data[position & MASK];
+    }
+
+    // Check if the queue is empty
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    // Get the number of elements in the queue (a snapshot while the threads run)
+    int size() const {
+        size_t first = head.load(memory_order_acquire);
+        return (int)(tail.load(memory_order_acquire) - first);
+    }
+
+    // Display all elements in the queue (for debugging, while no thread is using it)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Queue is empty" << endl;
+            return;
+        }
+
+        cout << "Queue elements: ";
+        size_t last = tail.load(memory_order_acquire);
+        for (size_t position = head.load(memory_order_acquire); position != last; position++) {
+            cout << data[position & MASK] << " ";
+        }
+        cout << endl;
+    }
+};
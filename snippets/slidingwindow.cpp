@@ -0,0 +1,260 @@
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * SlidingWindow - Rolling minimum and maximum over a time window of samples
+ *
+ * Two monotonic deques keep only the samples that can still become the
+ * minimum (values increasing from front to rear) or the maximum (values
+ * decreasing). A new sample first removes the rear candidates it beats, so
+ * every sample enters and leaves each deque at most once: push, expireBefore,
+ * windowMin and windowMax are O(1) amortized and nothing rescans the window.
+ * The deques are growable power-of-two ring buffers like Deque's.
+ * Operations:
+ * - push: Add a sample; timestamps must not decrease
+ * - pushBulk: Add a block of samples in one pass
+ * - expireBefore: Drop the samples older than a timestamp
+ * - windowMin: Get the smallest value in the window
+ * - windowMax: Get the largest value in the window
+ * - oldestTimestamp, newestTimestamp: Get the window's time span
+ * - isEmpty: Check if the window is empty
+ * - size: Get the number of samples in the window
+ */
+class SlidingWindow {
+public:
+    // Sample value type (dslord: -slidingwindow:T=<type>)
+    typedef int ValueType;
+    typedef int64_t TimestampType;
+
+private:
+    // Initial capacity of each ring, a power of two
+    static const int INITIAL_CAPACITY = 64;
+
+    struct Sample {
+        TimestampType timestamp;
+        ValueType value;
+    };
+
+    // Growable circular double-ended queue of E, indexed with a mask
+    template <typename E>
+    class Ring {
+    public:
+        Ring() : data(new E[INITIAL_CAPACITY]), capacityMask(INITIAL_CAPACITY - 1), front(0), count(0) {}
+
+        ~Ring() {
+            delete[] data;
+        }
+
+        Ring(const Ring& other) : data(new E[other.capacityMask + 1]), capacityMask(other.capacityMask), front(0), count(other.count) {
+            for (int i = 0; i < count; i++) {
+                data[i] = other.data[(other.front + i) & other.capacityMask];
+            }
+        }
+
+        Ring& operator=(const Ring& other) {
+            if (this != &other) {
+                Ring copy(other);
+                swap(data, copy.data);
+                swap(capacityMask, copy.capacityMask);
+                swap(front, copy.front);
+                swap(count, copy.count);
+            }
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return count == 0;
+        }
+
+        int size() const {
+            return count;
+        }
+
+        const E& first() const {
+            return data[front];
+        }
+
+        const E& last() const {
+            return data[(front + count - 1) & capacityMask];
+        }
+
+        // Grow until n more elements fit, so a batch needs no further checks
+        void reserve(int n) {
+            while (n > capacityMask + 1 - count) {
+                grow();
+            }
+        }
+
+        // Append; the caller has reserved room
+        void pushLast(const E& element) {
+            data[(front + count) & capacityMask] = element;
+            count++;
+        }
+
+        void popFirst() {
+            front = (front + 1) & capacityMask;
+            count--;
+        }
+
+        void popLast() {
+            count--;
+        }
+
+    private:
+        E* data;
+        int capacityMask;
+        int front;
+        int count;
+
+        // Move the elements into storage twice as large, unwrapping them to index 0;
+        // throws overflow_error when that many elements no longer fit in an int
+        void grow() {
+            int capacity = capacityMask + 1;
+            if (capacity > INT_MAX / 2) {
+                throw overflow_error("SlidingWindow Overflow");
+            }
+            E* newData = new E[capacity * 2];
+            int first = min(count, capacity - front);
+            copyElements(newData, data + front, first);
+            copyElements(newData + first, data, count - first);
+            delete[] data;
+            data = newData;
+            capacityMask = capacity * 2 - 1;
+            front = 0;
+        }
+
+        // Copy n elements between non-overlapping ranges, as one memcpy when the type allows
+        static void copyElements(E* to, const E* from, int n) {
+            if (n <= 0) {
+                return;
+            }
+            if (is_trivially_copyable<E>::value) {
+                memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(E));
+            } else {
+                for (int i = 0; i < n; i++) {
+                    to[i] = from[i];
+                }
+            }
+        }
+    };
+
+    Ring<TimestampType> timestamps;  // every sample in the window, oldest first
+    Ring<Sample> minCandidates;      // values strictly increasing from front to rear
+    Ring<Sample> maxCandidates;      // values strictly decreasing from front to rear
+
+    // Add one sample once every ring has room for it
+    void append(TimestampType timestamp, const ValueType& value) {
+        if (!timestamps.isEmpty() && timestamp < timestamps.last()) {
+            throw invalid_argument("SlidingWindow timestamps must not decrease");
+        }
+
+        while (!minCandidates.isEmpty() && !(minCandidates.last().value < value)) {
+            minCandidates.popLast();
+        }
+        while (!maxCandidates.isEmpty() && !(value < maxCandidates.last().value)) {
+            maxCandidates.popLast();
+        }
+        Sample sample = {timestamp, value};
+        minCandidates.pushLast(sample);
+        maxCandidates.pushLast(sample);
+        timestamps.pushLast(timestamp);
+    }
+
+public:
+    // Add a sample; throws invalid_argument if its timestamp is older than the newest
+    void push(TimestampType timestamp, const ValueType& value) {
+        timestamps.reserve(1);
+        minCandidates.reserve(1);
+        maxCandidates.reserve(1);
+        append(timestamp, value);
+    }
+
+    // Add n samples in one pass, growing the rings once up front; the
+    // timestamps must not decrease (the samples before a bad one are kept)
+    void pushBulk(const TimestampType* sampleTimestamps, const ValueType* values, int n) {
+        if (n <= 0) {
+            return;
+        }
+        timestamps.reserve(n);
+        minCandidates.reserve(n);
+        maxCandidates.reserve(n);
+        for (int i = 0; i < n; i++) {
+            append(sampleTimestamps[i], values[i]);
+        }
+    }
+
+    // Drop every sample with a timestamp before `timestamp`; returns how many were dropped
+    int expireBefore(TimestampType timestamp) {
+        int expired = 0;
+        while (!timestamps.isEmpty() && timestamps.first() < timestamp) {
+            timestamps.popFirst();
+            expired++;
+        }
+        while (!minCandidates.isEmpty() && minCandidates.first().timestamp < timestamp) {
+            minCandidates.popFirst();
+        }
+        while (!maxCandidates.isEmpty() && maxCandidates.first().timestamp < timestamp) {
+            maxCandidates.popFirst();
+        }
+        return expired;
+    }
+
+    // Get the smallest value in the window
+    ValueType windowMin() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+
+        return minCandidates.first().value;
+    }
+
+    // Get the largest value in the window
+    ValueType windowMax() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+
+        return maxCandidates.first().value;
+    }
+
+    // Get the timestamp of the oldest sample in the window
+    TimestampType oldestTimestamp() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+
+        return timestamps.first();
+    }
+
+    // Get the timestamp of the newest sample in the window
+    TimestampType newestTimestamp() const {
+        if (isEmpty()) {
+            throw underflow_error("SlidingWindow is empty");
+        }
+
+        return timestamps.last();
+    }
+
+    // Check if the window is empty
+    bool isEmpty() const {
+        return timestamps.isEmpty();
+    }
+
+    // Get the number of samples in the window
+    int size() const {
+        return timestamps.size();
+    }
+
+    // Display the window's span, size and extremes
+    void display() const {
+        if (isEmpty()) {
+            cout << "SlidingWindow is empty" << endl;
+            return;
+        }
+
+        cout << "SlidingWindow [" << oldestTimestamp() << ", " << newestTimestamp() << "]: "
+             << size() << " samples, min " << windowMin() << ", max " << windowMax() << endl;
+    }
+};
@@ -1,3 +1,4 @@
+#include <climits>
 #include <iostream>
 using namespace std;
 
@@ -11,27 +12,78 @@ using namespace std;
  * - size: Get the number of elements in the stack
  */
 class Stack {
+public:
+    // Element type (dslord: -stack:T=<type>)
+    typedef int ValueType;
+
 private:
+    // Capacity (dslord: -stack:capacity=<n>). When GROWABLE is set it is only the
+    // initial capacity and the storage doubles when full (dslord: -stack:growable)
     static const int MAX_SIZE = 1000;
-    int data[MAX_SIZE];
+    static const bool GROWABLE = false;
+
+    ValueType* data;
+    int dataCapacity;
     int stackTop;
 
+    // Move the elements into storage twice as large; throws overflow_error
+    // when that many elements no longer fit in an int
+    void grow() {
+        if (dataCapacity > INT_MAX / 2) {
+            throw overflow_error("Stack Overflow");
+        }
+        ValueType* newData = new ValueType[dataCapacity * 2];
+        for (int i = 0; i <= stackTop; i++) {
+            newData[i] = data[i];
+        }
+        delete[] data;
+        data = newData;
+        dataCapacity *= 2;
+    }
+
 public:
     // Constructor
-    Stack() {
+    Stack() : data(new ValueType[MAX_SIZE]), dataCapacity(MAX_SIZE) {
         stackTop = -1;
     }
 
+    // Destructor
+    ~Stack() {
+        delete[] data;
+    }
+
+    // Copy constructor
+    Stack(const Stack& other) : data(new ValueType[other.dataCapacity]), dataCapacity(other.dataCapacity) {
+        stackTop = other.stackTop;
+        for (int i = 0; i <= stackTop; i++) {
+            data[i] = other.data[i];
+        }
+    }
+
+    // Assignment operator
+    Stack& operator=(const Stack& other) {
+        if (this != &other) {
+            Stack copy(other);
+            swap(data, copy.data);
+            swap(dataCapacity, copy.dataCapacity);
+            swap(stackTop, copy.stackTop);
+        }
+        return *this;
+    }
+
     // Add an element to the top of the stack
-    void push(int value) {
-        if (stackTop >= MAX_SIZE - 1) {
-            throw overflow_error("Stack Overflow");
+    void push(const ValueType& value) {
+        if (stackTop >= dataCapacity - 1) {
+            if (!GROWABLE) {
+                throw overflow_error("Stack Overflow");
+            }
+            grow();
         }
         data[++stackTop] = value;
     }
 
     // Remove and return the top element from the stack
-    int pop() {
+    ValueType pop() {
         if (isEmpty()) {
             throw underflow_error("Stack Underflow");
         }
@@ -39,7 +91,7 @@ public:
     }
 
     // Get the top element without removing it
-    int top() const {
+    ValueType top() const {
         if (isEmpty()) {
             throw underflow_error("Stack is empty");
         }
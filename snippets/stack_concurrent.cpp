@@ -0,0 +1,268 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <thread>
+using namespace std;
+
+/**
+ * Stack - A lock-free Last-In-First-Out (LIFO) stack that any number of threads
+ * can push to and pop from at once (dslord: -stack:concurrent). It is a Treiber
+ * stack: the top is a single word updated with compare-and-swap.
+ *
+ * The top is a tagged word (32-bit tag, 32-bit node reference) and the tag
+ * changes on every update, so a thread holding a stale top always fails its
+ * CAS instead of hitting ABA. Popped nodes are recycled through a second
+ * tagged free list and their memory is only released by the destructor, so
+ * reading a node another thread has just popped is never a use-after-free.
+ * Under contention a failed push or pop tries an elimination slot, where a
+ * push hands its node straight to a pop without touching the top.
+ * Operations:
+ * - push: Add an element to the top of the stack
+ * - pop: Remove the top element from the stack (throws when empty)
+ * - tryPop: Remove the top element if there is one
+ * - top: Get the top element without removing it
+ * - isEmpty: Check if the stack is empty
+ * - size: Get the number of elements in the stack
+ */
+class Stack {
+public:
+    // Element type (dslord: -stack:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Node storage: block b holds FIRST_BLOCK_SIZE << b nodes and is never
+    // moved or freed while the stack exists
+    static const int FIRST_BLOCK_BITS = 6;
+    static const uint32_t FIRST_BLOCK_SIZE = 1u << FIRST_BLOCK_BITS;
+    static const int MAX_BLOCKS = 32 - FIRST_BLOCK_BITS;
+    static const uint32_t MAX_NODES = 0xFFFFFFFFu - FIRST_BLOCK_SIZE;
+
+    // Elimination slots tried after a failed CAS, and how long a push waits there
+    static const int ELIMINATION_SLOTS = 8;
+    static const int ELIMINATION_SPINS = 128;
+
+    struct Node {
+        ValueType value;
+        atomic<uint32_t> next;  // reference of the node below, 0 at the bottom
+    };
+
+    // Tagged words hold the tag in the high 32 bits and a node reference
+    // (1-based index, 0 for none) in the low 32 bits
+    static uint32_t refOf(uint64_t word) {
+        return (uint32_t)word;
+    }
+
+    // The word that replaces `word`: next tag, new reference
+    static uint64_t retag(uint64_t word, uint32_t ref) {
+        return (((word >> 32) + 1) << 32) | ref;
+    }
+
+    atomic<uint64_t> head;        // top of the stack
+    atomic<uint64_t> freeHead;    // recycled nodes
+    atomic<uint32_t> freshNodes;  // references handed out so far
+    atomic<int> count;
+    atomic<Node*> blocks[MAX_BLOCKS];
+    atomic<uint64_t> elimination[ELIMINATION_SLOTS];
+
+    static int highestBit(uint32_t x) {
+#if defined(__GNUC__)
+        return 31 - __builtin_clz(x);
+#else
+        int bit = 0;
+        while (x >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    Node& nodeAt(uint32_t ref) const {
+        uint32_t position = ref - 1 + FIRST_BLOCK_SIZE;
+        int bit = highestBit(position);
+        return blocks[bit - FIRST_BLOCK_BITS].load(memory_order_acquire)[position - (1u << bit)];
+    }
+
+    // Take a recycled node, or a fresh one (allocating its block on first use)
+    uint32_t allocateNode() {
+        uint32_t ref = popNode(freeHead, false);
+        if (ref) {
+            return ref;
+        }
+        ref = freshNodes.fetch_add(1, memory_order_relaxed) + 1;
+        if (ref > MAX_NODES) {
+            throw overflow_error("Stack Overflow");
+        }
+
+        int bit = highestBit(ref - 1 + FIRST_BLOCK_SIZE);
+        atomic<Node*>& block = blocks[bit - FIRST_BLOCK_BITS];
+        if (!block.load(memory_order_acquire)) {
+            Node* nodes = new Node[size_t(1) << bit];
+            Node* expected = nullptr;
+            if (!block.compare_exchange_strong(expected, nodes, memory_order_acq_rel)) {
+                delete[] nodes;  // another thread allocated it first
+            }
+        }
+        return ref;
+    }
+
+    void releaseNode(uint32_t ref) {
+        pushNode(freeHead, ref, false);
+    }
+
+    void pushNode(atomic<uint64_t>& list, uint32_t ref, bool eliminate) {
+        Node& node = nodeAt(ref);
+        uint64_t top = list.load(memory_order_relaxed);
+        while (true) {
+            node.next.store(refOf(top), memory_order_relaxed);
+            if (list.compare_exchange_weak(top, retag(top, ref), memory_order_acq_rel, memory_order_relaxed)) {
+                return;
+            }
+            if (eliminate && eliminatePush(ref)) {
+                return;
+            }
+            top = list.load(memory_order_relaxed);
+        }
+    }
+
+    // Returns the popped node's reference, or 0 when the list is empty
+    uint32_t popNode(atomic<uint64_t>& list, bool eliminate) {
+        uint64_t top = list.load(memory_order_acquire);
+        while (uint32_t ref = refOf(top)) {
+            // The node may be popped and reused meanwhile; the tag makes the CAS fail then
+            uint32_t below = nodeAt(ref).next.load(memory_order_relaxed);
+            if (list.compare_exchange_weak(top, retag(top, below), memory_order_acq_rel, memory_order_acquire)) {
+                return ref;
+            }
+            if (eliminate && (ref = eliminatePop())) {
+                return ref;
+            }
+            top = list.load(memory_order_acquire);
+        }
+        return 0;
+    }
+
+    // Pseudo-random elimination slot (xorshift, one state per thread)
+    atomic<uint64_t>& randomSlot() {
+        static thread_local uint32_t state = (uint32_t)hash<thread::id>()(this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return elimination[state % ELIMINATION_SLOTS];
+    }
+
+    // Offer a node to a concurrent pop; true when one took it
+    bool eliminatePush(uint32_t ref) {
+        atomic<uint64_t>& slot = randomSlot();
+        uint64_t empty = slot.load(memory_order_relaxed);
+        if (refOf(empty)) {
+            return false;
+        }
+        uint64_t offer = retag(empty, ref);
+        if (!slot.compare_exchange_strong(empty, offer, memory_order_acq_rel)) {
+            return false;
+        }
+        for (int i = 0; i < ELIMINATION_SPINS; i++) {
+            if (slot.load(memory_order_acquire) != offer) {
+                return true;
+            }
+        }
+        // Withdraw the offer; failing means a pop took it after all
+        return !slot.compare_exchange_strong(offer, retag(offer, 0), memory_order_acq_rel);
+    }
+
+    // Take a node offered by a concurrent push, or 0
+    uint32_t eliminatePop() {
+        atomic<uint64_t>& slot = randomSlot();
+        uint64_t offer = slot.load(memory_order_acquire);
+        uint32_t ref = refOf(offer);
+        if (ref && slot.compare_exchange_strong(offer, retag(offer, 0), memory_order_acq_rel)) {
+            return ref;
+        }
+        return 0;
+    }
+
+public:
+    // Constructor
+    Stack() : head(0), freeHead(0), freshNodes(0), count(0) {
+        for (int i = 0; i < MAX_BLOCKS; i++) {
+            blocks[i].store(nullptr, memory_order_relaxed);
+        }
+        for (int i = 0; i < ELIMINATION_SLOTS; i++) {
+            elimination[i].store(0, memory_order_relaxed);
+        }
+    }
+
+    // Destructor (no other thread may still be using the stack)
+    ~Stack() {
+        for (int i = 0; i < MAX_BLOCKS; i++) {
+            delete[] blocks[i].load(memory_order_relaxed);
+        }
+    }
+
+    // Threads share one stack, so it cannot be copied
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+
+    // Add an element to the top of the stack
+    void push(const ValueType& value) {
+        uint32_t ref = allocateNode();
+        nodeAt(ref).value = value;
+        pushNode(head, ref, true);
+        count.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Remove the top element into `value`; false when the stack is empty
+    bool tryPop(ValueType& value) {
+        uint32_t ref = popNode(head, true);
+        if (!ref) {
+            return false;
+        }
+        count.fetch_sub(1, memory_order_relaxed);
+        value = nodeAt(ref).value;
+        releaseNode(ref);
+        return true;
+    }
+
+    // Remove and return the top element from the stack
+    ValueType pop() {
+        ValueType value;
+        if (!tryPop(value)) {
+            throw underflow_error("Stack Underflow");
+        }
+        return value;
+    }
+
+    // Get the top element without removing it (only stable while no other thread pops)
+    ValueType top() const {
+        uint32_t ref = refOf(head.load(memory_order_acquire));
+        if (!ref) {
+            throw underflow_error("Stack is empty");
+        }
+        return nodeAt(ref).value;
+    }
+
+    // Check if the stack is empty
+    bool isEmpty() const {
+        return refOf(head.load(memory_order_acquire)) == 0;
+    }
+
+    // Get the number of elements in the stack (a snapshot under concurrent use)
+    int size() const {
+        return max(0, count.load(memory_order_relaxed));
+    }
+
+    // Display all elements in the stack (for debugging, while no other thread pops)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Stack is empty" << endl;
+            return;
+        }
+
+        cout << "Stack elements: ";
+        for (uint32_t ref = refOf(head.load(memory_order_acquire)); ref; ref = nodeAt(ref).next.load(memory_order_relaxed)) {
+            cout << nodeAt(ref).value << " ";
+        }
+        cout << endl;
+    }
+};
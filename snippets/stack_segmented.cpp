@@ -0,0 +1,208 @@
+#include <iostream>
+using namespace std;
+
+/**
+ * Stack - A Last-In-First-Out (LIFO) data structure implementation backed by
+ * linked fixed-size chunks (dslord: -stack:segmented). Growing allocates a new
+ * chunk and never moves existing elements, so push and pop are O(1) worst case.
+ * One emptied chunk is kept as a spare so pushing and popping across a chunk
+ * boundary does not allocate every time.
+ * Operations:
+ * - push: Add an element to the top of the stack
+ * - pop: Remove the top element from the stack
+ * - top: Get the top element without removing it
+ * - isEmpty: Check if the stack is empty
+ * - size: Get the number of elements in the stack
+ * - reserve: Allocate chunks up front for a number of elements
+ * - shrinkToFit: Release every chunk not holding elements
+ * - capacity: Get the number of elements the allocated chunks can hold
+ */
+class Stack {
+public:
+    // Element type (dslord: -stack:T=<type>)
+    typedef int ValueType;
+
+private:
+    // Elements per chunk
+    static const int CHUNK_SIZE = 1024;
+
+    struct Chunk {
+        ValueType data[CHUNK_SIZE];
+        Chunk* below;
+    };
+
+    Chunk* topChunk;     // chunk holding the top element, nullptr when empty
+    int topUsed;         // elements in topChunk
+    int usedChunks;
+    Chunk* freeChunks;   // empty chunks kept for reuse, linked through `below`
+    int freeCount;
+    int reservedChunks;  // chunks requested by reserve()
+    int count;
+
+    // Make a new top chunk, reusing a free one when there is one
+    void pushChunk() {
+        Chunk* chunk = freeChunks;
+        if (chunk) {
+            freeChunks = chunk->below;
+            freeCount--;
+        } else {
+            chunk = new Chunk;
+        }
+        chunk->below = topChunk;
+        topChunk = chunk;
+        topUsed = 0;
+        usedChunks++;
+    }
+
+    // Retire the emptied top chunk. It stays allocated while that keeps at most
+    // one spare beyond what reserve() asked for; otherwise it is freed.
+    void popChunk() {
+        Chunk* chunk = topChunk;
+        topChunk = chunk->below;
+        topUsed = topChunk ? CHUNK_SIZE : 0;
+        usedChunks--;
+        if (usedChunks + freeCount < max(reservedChunks, usedChunks + 1)) {
+            chunk->below = freeChunks;
+            freeChunks = chunk;
+            freeCount++;
+        } else {
+            delete chunk;
+        }
+    }
+
+    // Free a chain of chunks
+    static void freeChain(Chunk* chunk) {
+        while (chunk) {
+            Chunk* below = chunk->below;
+            delete chunk;
+            chunk = below;
+        }
+    }
+
+public:
+    // Constructor
+    Stack() : topChunk(nullptr), topUsed(0), usedChunks(0), freeChunks(nullptr),
+              freeCount(0), reservedChunks(0), count(0) {}
+
+    // Destructor
+    ~Stack() {
+        freeChain(topChunk);
+        freeChain(freeChunks);
+    }
+
+    // Copy constructor (copies the elements, not the spare chunks)
+    Stack(const Stack& other) : Stack() {
+        Chunk** link = &topChunk;
+        for (Chunk* chunk = other.topChunk; chunk; chunk = chunk->below) {
+            int used = chunk == other.topChunk ? other.topUsed : CHUNK_SIZE;
+            Chunk* copy = new Chunk;
+            copy->below = nullptr;
+            *link = copy;
+            link = &copy->below;
+            for (int i = 0; i < used; i++) {
+                copy->data[i] = chunk->data[i];
+            }
+            usedChunks++;
+        }
+        topUsed = other.topUsed;
+        count = other.count;
+    }
+
+    // Assignment operator
+    Stack& operator=(const Stack& other) {
+        if (this != &other) {
+            Stack copy(other);
+            swap(topChunk, copy.topChunk);
+            swap(topUsed, copy.topUsed);
+            swap(usedChunks, copy.usedChunks);
+            swap(freeChunks, copy.freeChunks);
+            swap(freeCount, copy.freeCount);
+            swap(reservedChunks, copy.reservedChunks);
+            swap(count, copy.count);
+        }
+        return *this;
+    }
+
+    // Add an element to the top of the stack
+    void push(const ValueType& value) {
+        if (!topChunk || topUsed == CHUNK_SIZE) {
+            pushChunk();
+        }
+        topChunk->data[topUsed++] = value;
+        count++;
+    }
+
+    // Remove and return the top element from the stack
+    ValueType pop() {
+        if (isEmpty()) {
+            throw underflow_error("Stack Underflow");
+        }
+        ValueType value = topChunk->data[--topUsed];
+        count--;
+        if (topUsed == 0) {
+            popChunk();
+        }
+        return value;
+    }
+
+    // Get the top element without removing it
+    ValueType top() const {
+        if (isEmpty()) {
+            throw underflow_error("Stack is empty");
+        }
+        return topChunk->data[topUsed - 1];
+    }
+
+    // Check if the stack is empty
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // Get the number of elements in the stack
+    int size() const {
+        return count;
+    }
+
+    // Allocate enough chunks to hold `elements` without further allocation.
+    // They stay allocated until shrinkToFit().
+    void reserve(int elements) {
+        int chunks = (elements + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        reservedChunks = max(reservedChunks, chunks);
+        while (usedChunks + freeCount < chunks) {
+            Chunk* chunk = new Chunk;
+            chunk->below = freeChunks;
+            freeChunks = chunk;
+            freeCount++;
+        }
+    }
+
+    // Release every chunk not holding elements, including the spare
+    void shrinkToFit() {
+        freeChain(freeChunks);
+        freeChunks = nullptr;
+        freeCount = 0;
+        reservedChunks = 0;
+    }
+
+    // Get the number of elements the allocated chunks can hold
+    int capacity() const {
+        return (usedChunks + freeCount) * CHUNK_SIZE;
+    }
+
+    // Display all elements in the stack (for debugging)
+    void display() const {
+        if (isEmpty()) {
+            cout << "Stack is empty" << endl;
+            return;
+        }
+
+        cout << "Stack elements: ";
+        for (Chunk* chunk = topChunk; chunk; chunk = chunk->below) {
+            int used = chunk == topChunk ? topUsed : CHUNK_SIZE;
+            for (int i = used - 1; i >= 0; i--) {
+                cout << chunk->data[i] << " ";
+            }
+        }
+        cout << endl;
+    }
+};